@@ -113,10 +113,10 @@ std::pair<FourVector, FourVector> Action::get_potential_at_interaction_point()
   /* Check:
    * Lattice is turned on. */
   if (UB_lat_pointer != nullptr) {
-    UB_lat_pointer->value_at(r, UB);
+    UB_lat_pointer->evaluate_at(r, UB);
   }
   if (UI3_lat_pointer != nullptr) {
-    UI3_lat_pointer->value_at(r, UI3);
+    UI3_lat_pointer->evaluate_at(r, UI3);
   }
   return std::make_pair(UB, UI3);
 }
@@ -0,0 +1,102 @@
+/*
+ *
+ *    Copyright (c) 2020 -
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/batchsampling.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+
+#include "smash/particletype.h"
+#include "smash/random.h"
+
+namespace smash {
+
+/// Whether sample_in_batches() is currently sampling on several threads.
+static std::atomic<bool> sampling_concurrently(false);
+
+bool sampling_in_batches_concurrently() { return sampling_concurrently; }
+
+void sample_in_batches(
+    Particles *particles, int n_threads,
+    const std::function<void(const ParticleBatch &, random::Engine &)>
+        &sample) {
+  std::vector<ParticleData *> all;
+  all.reserve(particles->size());
+  for (ParticleData &data : *particles) {
+    all.push_back(&data);
+  }
+
+  // Split the particles into runs of the same species
+  std::vector<ParticleBatch> batches;
+  std::size_t first = 0;
+  while (first < all.size()) {
+    std::size_t last = first + 1;
+    while (last < all.size() && last - first < max_particle_batch_size &&
+           all[last]->type() == all[first]->type()) {
+      ++last;
+    }
+    batches.emplace_back(all.data() + first, all.data() + last);
+    first = last;
+  }
+
+  /* Draw the seeds of all streams first, so that they do not depend on the
+   * order in which the batches are sampled. */
+  std::vector<random::Engine::result_type> seeds(batches.size());
+  for (auto &seed : seeds) {
+    seed = random::advance();
+  }
+  const auto sample_batch = [&](std::size_t i) {
+    random::Engine rng(seeds[i]);
+    sample(batches[i], rng);
+  };
+
+  const std::size_t n_workers =
+      std::min<std::size_t>(std::max(n_threads, 1), batches.size());
+  if (n_workers <= 1) {
+    for (std::size_t i = 0; i < batches.size(); ++i) {
+      sample_batch(i);
+    }
+    return;
+  }
+
+  /* The lazily computed properties of the particle types and their decays
+   * must not be initialized concurrently. */
+  ParticleType::tabulate_spectral_functions();
+  sampling_concurrently = true;
+  std::atomic<std::size_t> next_batch(0);
+  std::vector<std::exception_ptr> errors(n_workers);
+  std::vector<std::thread> workers;
+  workers.reserve(n_workers);
+  for (std::size_t w = 0; w < n_workers; ++w) {
+    workers.emplace_back([&, w]() {
+      try {
+        for (std::size_t i = next_batch++; i < batches.size();
+             i = next_batch++) {
+          sample_batch(i);
+        }
+      } catch (...) {
+        errors[w] = std::current_exception();
+      }
+    });
+  }
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+  sampling_concurrently = false;
+  for (const std::exception_ptr &error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+}  // namespace smash
@@ -4,20 +4,24 @@
  *
  *    GNU General Public License (GPLv3 or later)
  */
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
 #include <list>
 #include <map>
+#include <mutex>
 #include <utility>
 #include <vector>
 
 #include "smash/algorithms.h"
 #include "smash/angles.h"
+#include "smash/batchsampling.h"
 #include "smash/boxmodus.h"
 #include "smash/constants.h"
 #include "smash/cxx14compat.h"
 #include "smash/experimentparameters.h"
+#include "smash/hadgas_eos.h"
 #include "smash/logging.h"
 #include "smash/quantumsampling.h"
 #include "smash/random.h"
@@ -53,6 +57,9 @@ std::ostream &operator<<(std::ostream &out, const BoxModus &m) {
           << " GeV.\n";
       break;
   }
+  if (m.inline_wall_crossing_) {
+    out << "Wall crossings are applied during propagation.\n";
+  }
   if (m.insert_jet_) {
     ParticleTypePtr ptype = &ParticleType::find(m.jet_pdg_);
     out << "Adding a " << ptype->name() << " as a jet in the middle "
@@ -138,6 +145,30 @@ std::ostream &operator<<(std::ostream &out, const BoxModus &m) {
  * \li \key Jet_Momentum (double, optional, default = 20.):
  * The initial momentum to give to the jet particle (in GeV)
  *
+ * \key Inline_Wall_Crossing (bool, optional, default = false): \n
+ * By default, every crossing of a box wall is scheduled as a wall-crossing
+ * action, which is ordered with all other actions and performed like them.
+ * If this option is set to true, no such actions are created. Instead, the
+ * particles that left the box are moved back into it whenever the particles
+ * are propagated. Collisions across the walls are still found by the periodic
+ * grid and, for the particles produced during a time step, by searching the
+ * neighboring images of the box for their collision partners. The wall
+ * crossings are written to the collision output in the same way and in the
+ * order of time, with the density at the crossing, but only if a collision
+ * output is enabled. Wall crossings still count as interactions, so the
+ * process ids of the collision history are the same as with wall-crossing
+ * actions. This saves a
+ * lot of time in dense boxes, where wall crossings can be a large part of all
+ * actions.
+ *
+ * \key Sampling_Threads (int, optional, default = 1): \n
+ * Number of threads used to sample the initial masses, momenta and positions.
+ * The particles are sampled in batches of one species, each with its own
+ * random number stream derived from the event seed, so the initial state does
+ * not depend on the number of threads. This helps for boxes with very many
+ * (test) particles, where the initialization can otherwise take as long as
+ * many time steps.
+ *
  * \n
  * Examples: Configuring a Box Simulation
  * --------------
@@ -239,11 +270,17 @@ BoxModus::BoxModus(Configuration modus_config,
       jet_pdg_(insert_jet_ ? modus_config.take({"Box", "Jet", "Jet_PDG"})
                                  .convert_for(jet_pdg_)
                            : pdg::p),  // dummy default; never used
-      jet_mom_(modus_config.take({"Box", "Jet", "Jet_Momentum"}, 20.)) {
+      jet_mom_(modus_config.take({"Box", "Jet", "Jet_Momentum"}, 20.)),
+      inline_wall_crossing_(
+          modus_config.take({"Box", "Inline_Wall_Crossing"}, false)),
+      sampling_threads_(modus_config.take({"Box", "Sampling_Threads"}, 1)) {
   if (parameters.res_lifetime_factor < 0.) {
     throw std::invalid_argument(
         "Resonance lifetime modifier cannot be negative!");
   }
+  if (sampling_threads_ < 1) {
+    throw std::invalid_argument("Box: Sampling_Threads has to be positive.");
+  }
   // Check consistency, just in case
   if (std::abs(length_ - parameters.box_length) > really_small) {
     throw std::runtime_error("Box length inconsistency");
@@ -252,10 +289,7 @@ BoxModus::BoxModus(Configuration modus_config,
 
 double BoxModus::initial_conditions(Particles *particles,
                                     const ExperimentParameters &parameters) {
-  double momentum_radial = 0.0, mass = 0.0;
-  Angles phitheta;
   FourVector momentum_total(0, 0, 0, 0);
-  auto uniform_length = random::make_uniform_distribution(0.0, this->length_);
   const double T = this->temperature_;
   const double V = length_ * length_ * length_;
   /* Create NUMBER OF PARTICLES according to configuration, or thermal case */
@@ -295,43 +329,87 @@ double BoxModus::initial_conditions(Particles *particles,
   if (this->initial_condition_ == BoxInitialCondition::ThermalMomentaQuantum) {
     quantum_sampling = make_unique<QuantumSampling>(init_multipl_, V, T);
   }
-  for (ParticleData &data : *particles) {
+  /* The envelopes of the thermal mass distributions are found once per
+   * species. This is done before sampling in parallel, because it also
+   * initializes the lazily computed properties of the resonances. */
+  const bool sample_masses =
+      this->initial_condition_ ==
+          BoxInitialCondition::ThermalMomentaBoltzmann &&
+      account_for_resonance_widths_;
+  std::map<PdgCode, HadronGasEos::ThermalMassEnvelope> mass_envelopes;
+  if (sample_masses) {
+    for (const ParticleData &data : *particles) {
+      if (mass_envelopes.count(data.pdgcode()) == 0) {
+        mass_envelopes.emplace(
+            data.pdgcode(),
+            HadronGasEos::thermal_mass_envelope(data.type(), 1.0 / T));
+      }
+    }
+  }
+  /* Envelopes whose maximum increased while sampling; they are reported
+   * after sampling, because the batches may be sampled on other threads. */
+  std::mutex increased_envelopes_mutex;
+  std::vector<std::pair<HadronGasEos::ThermalMassEnvelope,
+                        HadronGasEos::ThermalMassEnvelope>>
+      increased_envelopes;
+  const auto sample_batch = [&](const ParticleBatch &batch,
+                                random::Engine &rng) {
+    const ParticleType &type = batch.type();
     /* Set MOMENTUM SPACE distribution */
-    if (this->initial_condition_ == BoxInitialCondition::PeakedMomenta) {
-      /* initial thermal momentum is the average 3T */
-      momentum_radial = 3.0 * T;
-      mass = data.pole_mass();
-    } else {
-      if (this->initial_condition_ ==
-          BoxInitialCondition::ThermalMomentaBoltzmann) {
+    std::vector<double> masses(batch.size(), type.mass());
+    std::vector<double> momenta(batch.size());
+    switch (this->initial_condition_) {
+      case BoxInitialCondition::PeakedMomenta:
+        /* initial thermal momentum is the average 3T */
+        std::fill(momenta.begin(), momenta.end(), 3.0 * T);
+        break;
+      case BoxInitialCondition::ThermalMomentaBoltzmann:
         /* thermal momentum according Maxwell-Boltzmann distribution */
-        mass = (!account_for_resonance_widths_)
-                   ? data.type().mass()
-                   : HadronGasEos::sample_mass_thermal(data.type(), 1.0 / T);
-        momentum_radial = sample_momenta_from_thermal(T, mass);
-      } else if (this->initial_condition_ ==
-                 BoxInitialCondition::ThermalMomentaQuantum) {
+        if (sample_masses) {
+          const auto &initial = mass_envelopes.at(type.pdgcode());
+          auto envelope = initial;
+          for (double &mass : masses) {
+            mass = HadronGasEos::sample_mass_thermal(envelope, rng);
+          }
+          if (envelope.max_ratio > initial.max_ratio) {
+            std::lock_guard<std::mutex> guard(increased_envelopes_mutex);
+            increased_envelopes.emplace_back(initial, envelope);
+          }
+        }
+        for (std::size_t i = 0; i < batch.size(); i++) {
+          momenta[i] = sample_momenta_from_thermal(T, masses[i], rng);
+        }
+        break;
+      case BoxInitialCondition::ThermalMomentaQuantum:
         /*
          * Sampling the thermal momentum according Bose/Fermi/Boltzmann
          * distribution.
          * We take the pole mass as the mass.
          */
-        mass = data.type().mass();
-        momentum_radial = quantum_sampling->sample(data.pdgcode());
-      }
+        quantum_sampling->sample(type.pdgcode(), momenta, rng);
+        break;
     }
-    phitheta.distribute_isotropically();
-    logg[LBox].debug(data.type().name(), "(id ", data.id(),
-                     ") radial momentum ", momentum_radial, ", direction",
-                     phitheta);
-    data.set_4momentum(mass, phitheta.threevec() * momentum_radial);
-    momentum_total += data.momentum();
+    Angles phitheta;
+    for (std::size_t i = 0; i < batch.size(); i++) {
+      ParticleData &data = batch[i];
+      phitheta.distribute_isotropically(rng);
+      data.set_4momentum(masses[i], phitheta.threevec() * momenta[i]);
 
-    /* Set COORDINATE SPACE distribution */
-    ThreeVector pos{uniform_length(), uniform_length(), uniform_length()};
-    data.set_4position(FourVector(start_time_, pos));
-    /// Initialize formation time
-    data.set_formation_time(start_time_);
+      /* Set COORDINATE SPACE distribution */
+      ThreeVector pos{random::uniform(0.0, length_, rng),
+                      random::uniform(0.0, length_, rng),
+                      random::uniform(0.0, length_, rng)};
+      data.set_4position(FourVector(start_time_, pos));
+      /// Initialize formation time
+      data.set_formation_time(start_time_);
+    }
+  };
+  sample_in_batches(particles, sampling_threads_, sample_batch);
+  for (const auto &envelopes : increased_envelopes) {
+    HadronGasEos::warn_if_maximum_increased(envelopes.first, envelopes.second);
+  }
+  for (const ParticleData &data : *particles) {
+    momentum_total += data.momentum();
   }
 
   /* Make total 3-momentum 0 */
@@ -387,4 +465,70 @@ int BoxModus::impose_boundary_conditions(Particles *particles,
   return wraps;
 }
 
+int BoxModus::wrap_wall_crossings(Particles *particles,
+                                  ActionList *crossings) {
+  const std::size_t first_new_crossing =
+      crossings != nullptr ? crossings->size() : 0;
+  int n_crossings = 0;
+
+  for (ParticleData &data : *particles) {
+    FourVector position = data.position();
+    const ThreeVector v = data.velocity();
+    bool wall_hit = false;
+    while (true) {
+      /* Among the coordinates outside of the box, find the one whose wall was
+       * crossed first, i.e. the longest time ago. */
+      int i_cross = -1;
+      double time_since_crossing = 0.;
+      for (int i = 0; i < 3; i++) {
+        const double x = position[i + 1];
+        double t;
+        if (x < 0.) {
+          t = (v[i] < -really_small) ? x / v[i] : 0.;
+        } else if (x >= length_) {
+          t = (v[i] > really_small) ? (x - length_) / v[i] : 0.;
+        } else {
+          continue;
+        }
+        if (i_cross == -1 || t > time_since_crossing) {
+          i_cross = i;
+          time_since_crossing = t;
+        }
+      }
+      if (i_cross == -1) {
+        break;
+      }
+      const bool upper_wall = position[i_cross + 1] >= length_;
+      if (crossings != nullptr) {
+        // Same incoming and outgoing state as in a WallcrossingAction
+        ParticleData incoming_particle(data);
+        incoming_particle.set_4position(
+            FourVector(position.x0() - time_since_crossing,
+                       position.threevec() - v * time_since_crossing));
+        FourVector crossing_point = incoming_particle.position();
+        crossing_point[i_cross + 1] = upper_wall ? 0.0 : length_;
+        ParticleData outgoing_particle(incoming_particle);
+        outgoing_particle.set_4position(crossing_point);
+        crossings->emplace_back(make_unique<WallcrossingAction>(
+            incoming_particle, outgoing_particle));
+      }
+      position[i_cross + 1] += upper_wall ? -length_ : length_;
+      wall_hit = true;
+      ++n_crossings;
+    }
+    if (wall_hit) {
+      data.set_4position(position);
+    }
+  }
+  if (crossings != nullptr) {
+    // Same order as if the crossings had been performed as actions
+    std::stable_sort(crossings->begin() + first_new_crossing, crossings->end(),
+                     [](const ActionPtr &a, const ActionPtr &b) {
+                       return *a < *b;
+                     });
+  }
+  logg[LBox].debug("Wrapped ", n_crossings, " wall crossings into the box.");
+  return n_crossings;
+}
+
 }  // namespace smash
@@ -60,8 +60,12 @@ BremsstrahlungAction::bremsstrahlung_reaction_type(const ParticleList &in) {
 }
 
 void BremsstrahlungAction::perform_bremsstrahlung(const OutputsList &outputs) {
+  /* The channel and the kinematics of the incoming particles are the same for
+   * all fractional photons, only k, theta and the angles are sampled per
+   * photon. */
+  const FinalStateSetup setup = setup_final_state();
   for (int i = 0; i < number_of_fractional_photons_; i++) {
-    generate_final_state();
+    sample_final_state(setup);
     for (const auto &output : outputs) {
       if (output->is_photon_output()) {
         // we do not care about the local density
@@ -72,6 +76,12 @@ void BremsstrahlungAction::perform_bremsstrahlung(const OutputsList &outputs) {
 }
 
 void BremsstrahlungAction::generate_final_state() {
+  sample_final_state(setup_final_state());
+}
+
+BremsstrahlungAction::FinalStateSetup
+BremsstrahlungAction::setup_final_state() {
+  static const ParticleTypePtr pi_z_particle = &ParticleType::find(pdg::pi_z);
   // we have only one reaction per incoming particle pair
   if (collision_processes_bremsstrahlung_.size() != 1) {
     logg[LScatterAction].fatal()
@@ -86,25 +96,68 @@ void BremsstrahlungAction::generate_final_state() {
 
   outgoing_particles_ = proc->particle_list();
   process_type_ = proc->get_type();
-  FourVector interaction_point = get_interaction_point();
 
-  // Sample k and theta:
+  FinalStateSetup setup;
+  setup.interaction_point = get_interaction_point();
+  setup.sqrts = sqrt_s();
+
   // minimum cutoff for k to be in accordance with cross section calculations
-  double delta_k;  // k-range
-  double k_min = 0.001;
-  double k_max =
-      (sqrt_s() * sqrt_s() - 2 * outgoing_particles_[0].type().mass() * 2 *
-                                 outgoing_particles_[1].type().mass()) /
-      (2 * sqrt_s());
+  setup.k_min = 0.001;
+  const double m_a = outgoing_particles_[0].type().mass();
+  const double m_b = outgoing_particles_[1].type().mass();
+  setup.k_max =
+      (setup.sqrts * setup.sqrts - 2 * m_a * 2 * m_b) / (2 * setup.sqrts);
+
+  /* The total momentum of the outgoing particles only depends on the incoming
+   * particles and the outgoing types, so the potentials at the interaction
+   * point are looked up once per scattering. */
+  setup.beta_cm = total_momentum_of_outgoing_particles().velocity();
+
+  // Select the tabulated differential cross sections of the channel
+  if (reac_ == ReactionType::pi_p_pi_m) {
+    if (outgoing_particles_[0].type() != *pi_z_particle) {
+      // pi+- + pi+-- -> pi+- + pi+- + gamma
+      setup.dsigma_dk = pipi_pipi_opp_dsigma_dk_interpolation.get();
+      setup.dsigma_dtheta = pipi_pipi_opp_dsigma_dtheta_interpolation.get();
+    } else {
+      // pi+- + pi+-- -> pi0 + pi0 + gamma
+      setup.dsigma_dk = pipi_pi0pi0_dsigma_dk_interpolation.get();
+      setup.dsigma_dtheta = pipi_pi0pi0_dsigma_dtheta_interpolation.get();
+    }
+  } else if (reac_ == ReactionType::pi_p_pi_p ||
+             reac_ == ReactionType::pi_m_pi_m) {
+    setup.dsigma_dk = pipi_pipi_same_dsigma_dk_interpolation.get();
+    setup.dsigma_dtheta = pipi_pipi_same_dsigma_dtheta_interpolation.get();
+  } else if (reac_ == ReactionType::pi_z_pi_p ||
+             reac_ == ReactionType::pi_z_pi_m) {
+    setup.dsigma_dk = pipi0_pipi0_dsigma_dk_interpolation.get();
+    setup.dsigma_dtheta = pipi0_pipi0_dsigma_dtheta_interpolation.get();
+  } else if (reac_ == ReactionType::pi_z_pi_z) {
+    setup.dsigma_dk = pi0pi0_pipi_dsigma_dk_interpolation.get();
+    setup.dsigma_dtheta = pi0pi0_pipi_dsigma_dtheta_interpolation.get();
+  } else {
+    throw std::runtime_error(
+        "Unkown channel when computing differential cross sections for "
+        "bremsstrahlung processes.");
+  }
 
-  if ((k_max - k_min) < 0.0) {
+  setup.weight_norm = number_of_fractional_photons_ * hadronic_cross_section();
+  setup.xsec_scaling = incoming_particles_[0].xsec_scaling_factor() *
+                       incoming_particles_[1].xsec_scaling_factor();
+  return setup;
+}
+
+void BremsstrahlungAction::sample_final_state(const FinalStateSetup &setup) {
+  // Sample k and theta:
+  double delta_k;  // k-range
+  if ((setup.k_max - setup.k_min) < 0.0) {
     // Make sure it is kinematically even possible to create a photon that is
     // in accordance with the cross section cutoff
     k_ = 0.0;
     delta_k = 0.0;
   } else {
-    k_ = random::uniform(k_min, k_max);
-    delta_k = (k_max - k_min);
+    k_ = random::uniform(setup.k_min, setup.k_max);
+    delta_k = (setup.k_max - setup.k_min);
   }
   theta_ = random::uniform(0.0, M_PI);
 
@@ -112,27 +165,24 @@ void BremsstrahlungAction::generate_final_state() {
   sample_3body_phasespace();
 
   // Get differential cross sections
-  std::pair<double, double> diff_xs_pair = brems_diff_cross_sections();
+  std::pair<double, double> diff_xs_pair = brems_diff_cross_sections(setup);
   double diff_xs_k = diff_xs_pair.first;
   double diff_xs_theta = diff_xs_pair.second;
 
   // Assign weighting factor
   const double W_theta = diff_xs_theta * (M_PI - 0.0);
   const double W_k = diff_xs_k * delta_k;
-  weight_ = std::sqrt(W_theta * W_k) /
-            (number_of_fractional_photons_ * hadronic_cross_section());
+  weight_ = std::sqrt(W_theta * W_k) / setup.weight_norm;
 
   // Scale weight by cross section scaling factor of incoming particles
-  weight_ *= incoming_particles_[0].xsec_scaling_factor() *
-             incoming_particles_[1].xsec_scaling_factor();
+  weight_ *= setup.xsec_scaling;
 
   // Set position and formation time and boost back to computational frame
   for (auto &new_particle : outgoing_particles_) {
     // assuming decaying particles are always fully formed
     new_particle.set_formation_time(time_of_execution_);
-    new_particle.set_4position(interaction_point);
-    new_particle.boost_momentum(
-        -total_momentum_of_outgoing_particles().velocity());
+    new_particle.set_4position(setup.interaction_point);
+    new_particle.boost_momentum(-setup.beta_cm);
   }
 
   // Photons are not really part of the normal processes, so we have to set a
@@ -267,44 +317,10 @@ CollisionBranchList BremsstrahlungAction::brems_cross_sections() {
   return process_list;
 }
 
-std::pair<double, double> BremsstrahlungAction::brems_diff_cross_sections() {
-  static const ParticleTypePtr pi_z_particle = &ParticleType::find(pdg::pi_z);
-  const double collision_energy = sqrt_s();
-  double dsigma_dk;
-  double dsigma_dtheta;
-
-  if (reac_ == ReactionType::pi_p_pi_m) {
-    if (outgoing_particles_[0].type() != *pi_z_particle) {
-      // pi+- + pi+-- -> pi+- + pi+- + gamma
-      dsigma_dk =
-          (*pipi_pipi_opp_dsigma_dk_interpolation)(k_, collision_energy);
-      dsigma_dtheta = (*pipi_pipi_opp_dsigma_dtheta_interpolation)(
-          theta_, collision_energy);
-    } else {
-      // pi+- + pi+-- -> pi0 + pi0 + gamma
-      dsigma_dk = (*pipi_pi0pi0_dsigma_dk_interpolation)(k_, collision_energy);
-      dsigma_dtheta =
-          (*pipi_pi0pi0_dsigma_dtheta_interpolation)(theta_, collision_energy);
-    }
-  } else if (reac_ == ReactionType::pi_p_pi_p ||
-             reac_ == ReactionType::pi_m_pi_m) {
-    dsigma_dk = (*pipi_pipi_same_dsigma_dk_interpolation)(k_, collision_energy);
-    dsigma_dtheta =
-        (*pipi_pipi_same_dsigma_dtheta_interpolation)(theta_, collision_energy);
-  } else if (reac_ == ReactionType::pi_z_pi_p ||
-             reac_ == ReactionType::pi_z_pi_m) {
-    dsigma_dk = (*pipi0_pipi0_dsigma_dk_interpolation)(k_, collision_energy);
-    dsigma_dtheta =
-        (*pipi0_pipi0_dsigma_dtheta_interpolation)(theta_, collision_energy);
-  } else if (reac_ == ReactionType::pi_z_pi_z) {
-    dsigma_dk = (*pi0pi0_pipi_dsigma_dk_interpolation)(k_, collision_energy);
-    dsigma_dtheta =
-        (*pi0pi0_pipi_dsigma_dtheta_interpolation)(theta_, collision_energy);
-  } else {
-    throw std::runtime_error(
-        "Unkown channel when computing differential cross sections for "
-        "bremsstrahlung processes.");
-  }
+std::pair<double, double> BremsstrahlungAction::brems_diff_cross_sections(
+    const FinalStateSetup &setup) const {
+  double dsigma_dk = (*setup.dsigma_dk)(k_, setup.sqrts);
+  double dsigma_dtheta = (*setup.dsigma_dtheta)(theta_, setup.sqrts);
 
   // Prevent negative cross sections due to numerics in interpolation
   dsigma_dk = (dsigma_dk < 0.0) ? really_small : dsigma_dk;
@@ -122,6 +122,21 @@ static constexpr int LCollider = LogArea::Collider::id;
  * additional specification of \key Beta_2, \key Beta_4, \key Theta and
  * \key Phi, which follow \iref{Moller:1993ed} and \iref{Schenke:2019ruo}. \n
  *
+ * - \key Configuration_Library: \n
+ *    Instead of sampling the nucleon positions in every event, draw them from
+ *    a library of pre-sampled configurations, which are randomly rotated in
+ *    every event. For custom nuclei, the configurations are only read once
+ *    from the external file. Fermi momenta are still sampled for every event.
+ *    \li \key Size (int, required if \key Configuration_Library exists, no
+ *    default): \n
+ *    Number of configurations in the library.
+ *    \li \key File (string, optional, no default): \n
+ *    Binary file in which the library is stored. If the file exists and was
+ *    created for the same nucleus parameters and size, the configurations are
+ *    read from it, otherwise they are sampled and written to it. This allows
+ *    to share the initial configurations between runs. For custom nuclei, the
+ *    contents of the external file belong to the nucleus parameters.
+ *
  * \page input_impact_parameter_ Impact Parameter
  * \key Impact: \n
  * A section for the impact parameter (= distance in fm of the two
@@ -263,6 +278,29 @@ static constexpr int LCollider = LogArea::Collider::id;
  *
  */
 
+/**
+ * Set up the configuration library of a nucleus, if it is requested in the
+ * configuration of the nucleus.
+ *
+ * \param[inout] nucleus Projectile or target nucleus.
+ * \param[in] nucleus_cfg Configuration of the nucleus.
+ */
+static void set_up_configuration_library(Nucleus &nucleus,
+                                         Configuration &nucleus_cfg) {
+  if (!nucleus_cfg.has_value({"Configuration_Library"})) {
+    return;
+  }
+  const int n_configurations =
+      nucleus_cfg.take({"Configuration_Library", "Size"});
+  if (n_configurations < 1) {
+    throw std::invalid_argument(
+        "Input Error: Configuration_Library needs a positive Size.");
+  }
+  const std::string file =
+      nucleus_cfg.take({"Configuration_Library", "File"}, std::string());
+  nucleus.set_up_configuration_library(n_configurations, file);
+}
+
 ColliderModus::ColliderModus(Configuration modus_config,
                              const ExperimentParameters &params) {
   Configuration modus_cfg = modus_config["Collider"];
@@ -294,6 +332,7 @@ ColliderModus::ColliderModus(Configuration modus_config,
   if (projectile_->size() < 1) {
     throw ColliderEmpty("Input Error: Projectile nucleus is empty.");
   }
+  set_up_configuration_library(*projectile_, proj_cfg);
 
   // Set up the target nucleus
   if (targ_cfg.has_value({"Deformed"})) {
@@ -307,6 +346,7 @@ ColliderModus::ColliderModus(Configuration modus_config,
   if (target_->size() < 1) {
     throw ColliderEmpty("Input Error: Target nucleus is empty.");
   }
+  set_up_configuration_library(*target_, targ_cfg);
 
   // Get the Fermi-Motion input (off, on, frozen)
   if (modus_cfg.has_value({"Fermi_Motion"})) {
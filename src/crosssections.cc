@@ -9,6 +9,8 @@
 
 #include "smash/crosssections.h"
 
+#include <iterator>
+
 #include "smash/clebschgordan.h"
 #include "smash/constants.h"
 #include "smash/logging.h"
@@ -90,10 +92,14 @@ static double detailed_balance_factor_RR(double sqrts, double pcm,
  */
 static void append_list(CollisionBranchList& main_list,
                         CollisionBranchList in_list, double weight = 1.) {
-  main_list.reserve(main_list.size() + in_list.size());
   for (auto& proc : in_list) {
     proc->set_weight(proc->weight() * weight);
-    main_list.emplace_back(std::move(proc));
+  }
+  if (main_list.empty()) {
+    main_list = std::move(in_list);
+  } else {
+    main_list.insert(main_list.end(), std::make_move_iterator(in_list.begin()),
+                     std::make_move_iterator(in_list.end()));
   }
 }
 
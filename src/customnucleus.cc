@@ -125,13 +125,12 @@ CustomNucleus::CustomNucleus(Configuration& config, int testparticles,
    * "if" statement makes sure the streams to the file are initialized
    * properly.
    */
-  const std::string path =
-      file_path(particle_list_file_directory, particle_list_file_name);
+  file_path_ = file_path(particle_list_file_directory, particle_list_file_name);
   if (same_file && !filestream_shared_) {
-    filestream_shared_ = make_unique<std::ifstream>(path);
+    filestream_shared_ = make_unique<std::ifstream>(file_path_);
     used_filestream_ = &filestream_shared_;
   } else if (!same_file) {
-    filestream_ = make_unique<std::ifstream>(path);
+    filestream_ = make_unique<std::ifstream>(file_path_);
     used_filestream_ = &filestream_;
   } else {
     used_filestream_ = &filestream_shared_;
@@ -188,6 +187,11 @@ ThreeVector CustomNucleus::distribute_nucleon() {
 }
 
 void CustomNucleus::arrange_nucleons() {
+  // The library configurations are read from the file only once.
+  if (has_configuration_library()) {
+    draw_configuration_from_library();
+    return;
+  }
   /* Randomly generate Euler angles for rotation everytime a new
    * custom nucleus is initialized. Therefore this is done 2 times per
    * event.
@@ -215,6 +219,14 @@ void CustomNucleus::generate_fermi_momenta() {
                          << "Woods-Saxon distribution.";
 }
 
+void CustomNucleus::write_library_parameters(std::ostream& out) const {
+  std::ifstream file(file_path_, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error("Could not read the nucleus file " + file_path_);
+  }
+  out << "custom " << file.rdbuf();
+}
+
 std::string CustomNucleus::file_path(const std::string& file_directory,
                                      const std::string& file_name) {
   if (file_directory.back() == '/') {
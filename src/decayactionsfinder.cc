@@ -9,6 +9,9 @@
 
 #include "smash/decayactionsfinder.h"
 
+#include <algorithm>
+#include <limits>
+
 #include "smash/constants.h"
 #include "smash/cxx14compat.h"
 #include "smash/decayaction.h"
@@ -25,11 +28,46 @@ ActionList DecayActionsFinder::find_actions_in_cell(
    * less than 10 decays in most time steps */
   actions.reserve(10);
 
+  if (decay_schedule_ && !search_list.empty()) {
+    DecaySchedule &schedule = *decay_schedule_;
+    const double time = search_list.front().position().x0();
+    if (time > schedule.current_time) {
+      // first search of a new timestep
+      schedule.previous_time = schedule.current_time;
+      schedule.current_time = time;
+      if (schedule.entries.size() > schedule.purge_size) {
+        purge_decay_schedule();
+      }
+    }
+  }
+
   for (const auto &p : search_list) {
     if (p.type().is_stable()) {
       continue;  // particle doesn't decay
     }
 
+    const double time = p.position().x0();
+    if (decay_schedule_) {
+      auto entry = decay_schedule_->entries.find(p.id());
+      if (entry != decay_schedule_->entries.end() &&
+          entry->second.id_process == p.id_process() &&
+          entry->second.momentum == p.momentum()) {
+        // the decay time was already sampled for the current state
+        const double decay_time = entry->second.decay_time - time;
+        if (decay_time < dt) {
+          auto act = make_unique<DecayAction>(p, decay_time);
+          act->add_decays(p.type().get_partial_widths(
+              p.momentum(), p.position().threevec(),
+              WhichDecaymodes::Hadronic));
+          actions.emplace_back(std::move(act));
+          decay_schedule_->entries.erase(entry);
+        } else {
+          entry->second.last_used = time;
+        }
+        continue;
+      }
+    }
+
     DecayBranchList processes = p.type().get_partial_widths(
         p.momentum(), p.position().threevec(), WhichDecaymodes::Hadronic);
     // total decay width (mass-dependent)
@@ -37,6 +75,11 @@ ActionList DecayActionsFinder::find_actions_in_cell(
 
     // check if there are any (hadronic) decays
     if (!(width > 0.0)) {
+      if (decay_schedule_) {
+        decay_schedule_->entries[p.id()] = {
+            p.id_process(), p.momentum(),
+            std::numeric_limits<double>::infinity(), time};
+      }
       continue;
     }
 
@@ -63,11 +106,31 @@ ActionList DecayActionsFinder::find_actions_in_cell(
       auto act = make_unique<DecayAction>(p, decay_time);
       act->add_decays(std::move(processes));
       actions.emplace_back(std::move(act));
+    } else if (decay_schedule_) {
+      decay_schedule_->entries[p.id()] = {p.id_process(), p.momentum(),
+                                          time + decay_time, time};
     }
   }
   return actions;
 }
 
+void DecayActionsFinder::purge_decay_schedule() const {
+  /* Entries of resonances which decayed or were absorbed are not used
+   * anymore. Removing an entry which is still in use only means that the
+   * decay time is sampled again, which does not change the decay statistics
+   * due to the exponential decay law. */
+  auto &entries = decay_schedule_->entries;
+  for (auto it = entries.begin(); it != entries.end();) {
+    if (it->second.last_used < decay_schedule_->previous_time) {
+      it = entries.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  decay_schedule_->purge_size =
+      std::max<std::size_t>(1000, 2 * entries.size());
+}
+
 ActionList DecayActionsFinder::find_final_actions(const Particles &search_list,
                                                   bool /*only_res*/) const {
   ActionList actions;
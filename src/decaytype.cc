@@ -10,6 +10,7 @@
 #include <algorithm>
 #include <cmath>
 
+#include "smash/batchsampling.h"
 #include "smash/constants.h"
 #include "smash/cxx14compat.h"
 #include "smash/formfactors.h"
@@ -145,8 +146,9 @@ static /*thread_local (see #3075)*/ Integrator integrate;
 
 double TwoBodyDecaySemistable::rho(double mass) const {
   if (tabulation_ == nullptr) {
-    /* TODO(weil): Move this lazy init to a global initialization function,
-     * in order to avoid race conditions in multi-threading. */
+    /* The tabulation is created by ParticleType::tabulate_spectral_functions
+     * before any concurrent sampling. */
+    assert(!sampling_in_batches_concurrently());
     const ParticleTypePtr res = particle_types_[1];
     const double tabulation_interval = std::max(2., 10. * res->width_at_pole());
     const double m_stable = particle_types_[0]->mass();
@@ -199,8 +201,9 @@ static /*thread_local*/ Integrator2d integrate2d(1E7);
 
 double TwoBodyDecayUnstable::rho(double mass) const {
   if (tabulation_ == nullptr) {
-    /* TODO(weil): Move this lazy init to a global initialization function,
-     * in order to avoid race conditions in multi-threading. */
+    /* The tabulation is created by ParticleType::tabulate_spectral_functions
+     * before any concurrent sampling. */
+    assert(!sampling_in_batches_concurrently());
     const ParticleTypePtr r1 = particle_types_[0];
     const ParticleTypePtr r2 = particle_types_[1];
     const double m1_min = r1->min_mass_kinematic();
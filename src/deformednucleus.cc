@@ -6,7 +6,11 @@
  */
 #include "smash/deformednucleus.h"
 
+#include <gsl/gsl_sf_fermi_dirac.h>
+
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <map>
 #include <stdexcept>
 
@@ -122,23 +126,89 @@ DeformedNucleus::DeformedNucleus(Configuration &config, int nTest,
   }
 }
 
+/// Number of \f$\cos\theta\f$ bins for sampling deformed nucleon positions.
+static constexpr int n_costheta_bins = 200;
+
+void DeformedNucleus::tabulate_sampling_envelope() {
+  const double R = get_nuclear_radius();
+  const double d = get_diffusiveness();
+  envelope_parameters_ = {R, d, beta2_, beta4_};
+  /* The deformed radius is a polynomial in cos(theta). Its maximum in each
+   * bin is at one of the bin edges or at one of its stationary points. */
+  std::vector<double> stationary = {0.};
+  const double b2 = beta2_ * std::sqrt(5 / M_PI) / 4;
+  const double b4 = beta4_ * 3 / (16 * std::sqrt(M_PI));
+  if (b4 != 0.) {
+    const double x2 = (60 * b4 - 6 * b2) / (140 * b4);
+    if (x2 > 0. && x2 < 1.) {
+      stationary.push_back(std::sqrt(x2));
+      stationary.push_back(-std::sqrt(x2));
+    }
+  }
+  const double bin_width = 2. / n_costheta_bins;
+  envelope_radius_.resize(n_costheta_bins);
+  std::vector<double> weights(n_costheta_bins);
+  for (int k = 0; k < n_costheta_bins; k++) {
+    const double lower = -1. + k * bin_width;
+    const double upper = lower + bin_width;
+    double r_max = std::max(deformed_radius(lower), deformed_radius(upper));
+    for (double x : stationary) {
+      if (x > lower && x < upper) {
+        r_max = std::max(r_max, deformed_radius(x));
+      }
+    }
+    envelope_radius_[k] = r_max;
+    /* Integral of r^2 / (exp((r - r_max) / d) + 1) from 0 to infinity,
+     * which is 2 d^3 F_2(r_max / d) in terms of the complete Fermi-Dirac
+     * integral (or r_max^3 / 3 for a hard sphere). */
+    weights[k] = (d > 0.) ? 2 * d * d * d * gsl_sf_fermi_dirac_2(r_max / d)
+                          : r_max * r_max * r_max / 3;
+  }
+  envelope_bins_.reset_weights(weights);
+}
+
 ThreeVector DeformedNucleus::distribute_nucleon() {
-  double a_radius;
-  Angles a_direction;
+  const double R = get_nuclear_radius();
+  const double d = get_diffusiveness();
+  if (envelope_parameters_.size() != 4 || envelope_parameters_[0] != R ||
+      envelope_parameters_[1] != d || envelope_parameters_[2] != beta2_ ||
+      envelope_parameters_[3] != beta4_) {
+    tabulate_sampling_envelope();
+  }
   // Set a sensible maximum bound for radial sampling.
-  double radius_max =
-      Nucleus::get_nuclear_radius() / Nucleus::get_diffusiveness() +
-      Nucleus::get_nuclear_radius() * Nucleus::get_diffusiveness();
+  const double radius_max =
+      (d > 0.) ? R / d + R * d : std::numeric_limits<double>::infinity();
+  const double bin_width = 2. / n_costheta_bins;
 
-  // Sample the distribution.
+  double a_radius, cosx;
   do {
-    a_direction.distribute_isotropically();
-    // sample r**2 dr
-    a_radius = radius_max * std::cbrt(random::canonical());
-  } while (random::canonical() >
-           nucleon_density(a_radius, a_direction.costheta()) /
-               Nucleus::get_saturation_density());
+    const int k = envelope_bins_();
+    cosx = -1. + (k + random::canonical()) * bin_width;
+    const double r_envelope = envelope_radius_[k];
+    if (d > 0.) {
+      a_radius = sample_woods_saxon_radius(r_envelope, d);
+      if (a_radius > radius_max) {
+        continue;
+      }
+      // ratio of the deformed to the spherical Woods-Saxon density
+      const double acceptance =
+          (1. + std::exp((a_radius - r_envelope) / d)) /
+          (1. + std::exp((a_radius - deformed_radius(cosx)) / d));
+      if (random::canonical() <= acceptance) {
+        break;
+      }
+    } else {
+      // hard sphere
+      a_radius = r_envelope * std::cbrt(random::canonical());
+      if (a_radius <= deformed_radius(cosx)) {
+        break;
+      }
+    }
+  } while (true);
 
+  Angles a_direction;
+  a_direction.set_costheta(cosx);
+  a_direction.set_phi(twopi * random::canonical());
   // Update (x, y, z) positions.
   return a_direction.threevec() * a_radius;
 }
@@ -267,6 +337,11 @@ void DeformedNucleus::set_orientation_from_config(
   }
 }
 
+void DeformedNucleus::write_library_parameters(std::ostream &out) const {
+  Nucleus::write_library_parameters(out);
+  out << " deformed " << beta2_ << ' ' << beta4_;
+}
+
 void DeformedNucleus::rotate() {
   if (random_rotation_) {
     // Randomly generate euler angles for theta and phi. Psi needs not be
@@ -299,11 +374,14 @@ double y_l_0(int l, double cosx) {
   }
 }
 
+double DeformedNucleus::deformed_radius(double cosx) const {
+  return Nucleus::get_nuclear_radius() *
+         (1 + beta2_ * y_l_0(2, cosx) + beta4_ * y_l_0(4, cosx));
+}
+
 double DeformedNucleus::nucleon_density(double r, double cosx) const {
   return Nucleus::get_saturation_density() /
-         (1 + std::exp((r - Nucleus::get_nuclear_radius() *
-                                (1 + beta2_ * y_l_0(2, cosx) +
-                                 beta4_ * y_l_0(4, cosx))) /
+         (1 + std::exp((r - deformed_radius(cosx)) /
                        Nucleus::get_diffusiveness()));
 }
 
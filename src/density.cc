@@ -8,6 +8,12 @@
  */
 
 #include "smash/density.h"
+
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
 #include "smash/constants.h"
 #include "smash/logging.h"
 
@@ -159,6 +165,372 @@ current_eckart(const ThreeVector &r, const Particles &plist,
                              smearing);
 }
 
+/// \copydoc smash::probe_thermodynamics
+template <typename /*ParticlesContainer*/ T>
+std::vector<ThermodynamicProbe> probe_thermodynamics_impl(
+    const std::vector<ThreeVector> &points, const T &plist,
+    const DensityParameters &par, DensityType dens_type, bool smearing,
+    bool compute_rho, bool compute_tmn, bool compute_jQBS) {
+  std::vector<ThermodynamicProbe> result(points.size());
+  /* Positive and negative parts of the currents, which are summed up
+   * separately like in current_eckart_impl: the ones of dens_type (for the
+   * Eckart density) and the electric, baryonic and strange ones. */
+  std::vector<std::array<FourVector, 8>> currents(points.size());
+  const double norm_factor = par.norm_factor_sf();
+  auto add_current = [&](std::array<FourVector, 8> &j, int which,
+                         const FourVector &mom, double factor, double sf) {
+    const FourVector tmp = mom * (factor / mom.x0());
+    j[2 * which + (factor > 0. ? 0 : 1)] += tmp * sf;
+  };
+
+  for (const auto &p : plist) {
+    const double dens_factor = density_factor(p.type(), dens_type);
+    const bool dens_contributes = std::fabs(dens_factor) >= really_small;
+    const double q_factor =
+        compute_jQBS ? density_factor(p.type(), DensityType::Charge) : 0.;
+    const double b_factor =
+        compute_jQBS ? density_factor(p.type(), DensityType::Baryon) : 0.;
+    const double s_factor =
+        compute_jQBS ? density_factor(p.type(), DensityType::Strangeness) : 0.;
+    const bool q_contributes = std::fabs(q_factor) >= really_small;
+    const bool b_contributes = std::fabs(b_factor) >= really_small;
+    const bool s_contributes = std::fabs(s_factor) >= really_small;
+    if (!((compute_rho || compute_tmn) && dens_contributes) &&
+        !(q_contributes || b_contributes || s_contributes)) {
+      continue;
+    }
+    const FourVector mom = p.momentum();
+    const double m = mom.abs();
+    if (m < really_small) {
+      continue;
+    }
+    const double m_inv = 1.0 / m;
+    const ThreeVector pos = p.position().threevec();
+
+    for (std::size_t i = 0; i < points.size(); i++) {
+      double sf = 1.0;
+      if (smearing) {
+        sf = unnormalized_smearing_factor(pos - points[i], mom, m_inv, par)
+                 .first;
+        if (sf < really_small) {
+          continue;
+        }
+      }
+      if (dens_contributes) {
+        if (compute_rho) {
+          add_current(currents[i], 0, mom, dens_factor, sf);
+        }
+        if (compute_tmn) {
+          result[i].Tmn.add_particle(
+              p, smearing ? dens_factor * sf * norm_factor : dens_factor);
+        }
+      }
+      if (q_contributes) {
+        add_current(currents[i], 1, mom, q_factor, sf);
+      }
+      if (b_contributes) {
+        add_current(currents[i], 2, mom, b_factor, sf);
+      }
+      if (s_contributes) {
+        add_current(currents[i], 3, mom, s_factor, sf);
+      }
+    }
+  }
+
+  for (std::size_t i = 0; i < points.size(); i++) {
+    const auto &j = currents[i];
+    if (compute_rho) {
+      result[i].rho_eckart = (j[0].abs() - j[1].abs()) * norm_factor;
+    }
+    result[i].jQ = j[2] + j[3];
+    result[i].jB = j[4] + j[5];
+    result[i].jS = j[6] + j[7];
+  }
+  return result;
+}
+
+std::vector<ThermodynamicProbe> probe_thermodynamics(
+    const std::vector<ThreeVector> &points, const ParticleList &plist,
+    const DensityParameters &par, DensityType dens_type, bool smearing,
+    bool compute_rho, bool compute_tmn, bool compute_jQBS) {
+  return probe_thermodynamics_impl(points, plist, par, dens_type, smearing,
+                                   compute_rho, compute_tmn, compute_jQBS);
+}
+std::vector<ThermodynamicProbe> probe_thermodynamics(
+    const std::vector<ThreeVector> &points, const Particles &plist,
+    const DensityParameters &par, DensityType dens_type, bool smearing,
+    bool compute_rho, bool compute_tmn, bool compute_jQBS) {
+  return probe_thermodynamics_impl(points, plist, par, dens_type, smearing,
+                                   compute_rho, compute_tmn, compute_jQBS);
+}
+std::vector<ThermodynamicProbe> probe_thermodynamics(
+    const std::vector<ThreeVector> &points, const Particles::Snapshot &plist,
+    const DensityParameters &par, DensityType dens_type, bool smearing,
+    bool compute_rho, bool compute_tmn, bool compute_jQBS) {
+  return probe_thermodynamics_impl(points, plist, par, dens_type, smearing,
+                                   compute_rho, compute_tmn, compute_jQBS);
+}
+
+namespace {
+
+/// Four-vectors on a regular grid, stored with the x index running fastest.
+class FourVectorGrid {
+ public:
+  /**
+   * Construct a grid of zero four-vectors.
+   *
+   * \param[in] dims Number of nodes in x, y and z direction
+   */
+  explicit FourVectorGrid(const std::array<int, 3> &dims)
+      : dims_(dims), values_(dims[0] * dims[1] * dims[2]) {}
+
+  /// \return Number of nodes in x, y and z direction
+  const std::array<int, 3> &dimensions() const { return dims_; }
+
+  /// \return Four-vector at the node with the given indices
+  FourVector &operator()(int ix, int iy, int iz) {
+    return values_[ix + dims_[0] * (iy + dims_[1] * iz)];
+  }
+
+  /// \return Four-vector at the node with the given indices
+  const FourVector &operator()(int ix, int iy, int iz) const {
+    return values_[ix + dims_[0] * (iy + dims_[1] * iz)];
+  }
+
+  /**
+   * Add another grid node by node.
+   *
+   * \param[in] other Grid with the same dimensions
+   * \return This grid
+   */
+  FourVectorGrid &operator+=(const FourVectorGrid &other) {
+    for (std::size_t i = 0; i < values_.size(); i++) {
+      values_[i] += other.values_[i];
+    }
+    return *this;
+  }
+
+ private:
+  /// Number of nodes in x, y and z direction
+  std::array<int, 3> dims_;
+  /// Four-vectors at the nodes
+  std::vector<FourVector> values_;
+};
+
+/// Gaussian and its derivative sampled at the nodes along one lattice axis.
+struct SeparableKernel {
+  /// Number of nodes within the cut-off radius on either side
+  int half_width;
+  /// Gaussian at the offsets -half_width ... half_width, summing up to 1
+  std::vector<double> gauss;
+  /// Derivative of the Gaussian with respect to the node position [fm^-1]
+  std::vector<double> derivative;
+};
+
+/**
+ * Sample the smearing kernel along one lattice axis.
+ *
+ * \param[in] cell_size Distance between neighbouring nodes [fm]
+ * \param[in] par Parameters of the Gaussian smearing
+ * \return The sampled kernel
+ * \throw std::invalid_argument if the cells are too large for the
+ *        cloud-in-cell width correction
+ */
+SeparableKernel separable_kernel(double cell_size,
+                                 const DensityParameters &par) {
+  /* The cloud-in-cell assignment is a convolution with a triangle of
+   * variance cell_size^2 / 6, which is taken off the Gaussian. */
+  const double sig_sqr =
+      par.sigma() * par.sigma() - cell_size * cell_size / 6.;
+  if (sig_sqr <= 0.) {
+    throw std::invalid_argument(
+        "Separable smearing requires lattice cells smaller than sqrt(6) "
+        "times the Gaussian smearing width.");
+  }
+  SeparableKernel kernel;
+  kernel.half_width = static_cast<int>(par.r_cut() / cell_size);
+  double sum = 0.;
+  for (int j = -kernel.half_width; j <= kernel.half_width; j++) {
+    const double x = j * cell_size;
+    kernel.gauss.push_back(std::exp(-0.5 * x * x / sig_sqr));
+    sum += kernel.gauss.back();
+  }
+  for (int j = -kernel.half_width; j <= kernel.half_width; j++) {
+    double &g = kernel.gauss[j + kernel.half_width];
+    g /= sum;
+    kernel.derivative.push_back(-j * cell_size / sig_sqr * g);
+  }
+  return kernel;
+}
+
+/**
+ * Convolve a grid with a kernel along one axis.
+ *
+ * Node i of the result collects the input nodes i + offset - j for
+ * j = -h ... h with the weights kernel[j + h]. On periodic lattices the
+ * input index is taken modulo the number of input nodes.
+ *
+ * \param[in] in Grid to be convolved
+ * \param[in] axis Axis along which the grid is convolved
+ * \param[in] kernel Weights of the offsets -h ... h
+ * \param[in] n_out Number of nodes along the axis in the result
+ * \param[in] offset Index of the first result node in the input grid
+ * \param[in] periodic Whether the lattice is periodic
+ * \return The convolved grid
+ */
+FourVectorGrid convolve_axis(const FourVectorGrid &in, int axis,
+                             const std::vector<double> &kernel, int n_out,
+                             int offset, bool periodic) {
+  const int n_in = in.dimensions()[axis];
+  const int h = (static_cast<int>(kernel.size()) - 1) / 2;
+  std::array<int, 3> dims = in.dimensions();
+  dims[axis] = n_out;
+  FourVectorGrid out(dims);
+  std::array<int, 3> i, k;
+  for (i[2] = 0; i[2] < dims[2]; i[2]++) {
+    for (i[1] = 0; i[1] < dims[1]; i[1]++) {
+      for (i[0] = 0; i[0] < dims[0]; i[0]++) {
+        k = i;
+        FourVector sum;
+        for (int j = -h; j <= h; j++) {
+          k[axis] = i[axis] + offset - j;
+          if (periodic) {
+            k[axis] = (k[axis] % n_in + n_in) % n_in;
+          }
+          sum += kernel[j + h] * in(k[0], k[1], k[2]);
+        }
+        out(i[0], i[1], i[2]) = sum;
+      }
+    }
+  }
+  return out;
+}
+
+}  // namespace
+
+void update_lattice(DensityLattice *lat, const LatticeUpdate update,
+                    const DensityType dens_type, const DensityParameters &par,
+                    const Particles &particles, const bool compute_gradient) {
+  if (par.smearing_mode() == SmearingMode::Covariant) {
+    update_lattice<DensityOnLattice>(lat, update, dens_type, par, particles,
+                                     compute_gradient);
+    return;
+  }
+  // Do not proceed if lattice does not exists/update not required
+  if (lat == nullptr || lat->when_update() != update) {
+    return;
+  }
+  const std::array<int, 3> &n = lat->dimensions();
+  const bool periodic = lat->periodic();
+  /* Without periodicity, particles up to r_cut outside of the lattice
+   * contribute, so the particles are assigned to a padded grid. */
+  std::array<SeparableKernel, 3> kernels;
+  std::array<int, 3> padding, dims;
+  for (int k = 0; k < 3; k++) {
+    kernels[k] = separable_kernel(lat->cell_sizes()[k], par);
+    padding[k] = periodic ? 0 : kernels[k].half_width;
+    dims[k] = periodic ? n[k] : n[k] + 2 * padding[k] + 1;
+  }
+  const std::array<double, 3> &cell_sizes = lat->cell_sizes();
+  const double norm_factor =
+      1. / (cell_sizes[0] * cell_sizes[1] * cell_sizes[2] * par.ntest());
+
+  /* Currents of the positive and negative charges and, for the time
+   * derivative, the currents times the velocity in x, y and z direction */
+  FourVectorGrid jmu_pos(dims), jmu_neg(dims);
+  std::vector<FourVectorGrid> jmu_flux;
+  if (compute_gradient) {
+    jmu_flux.assign(3, FourVectorGrid(dims));
+  }
+  for (const auto &part : particles) {
+    const double dens_factor = density_factor(part.type(), dens_type);
+    if (std::abs(dens_factor) < really_small) {
+      continue;
+    }
+    const FourVector p = part.momentum();
+    const double m = p.abs();
+    if (unlikely(m < really_small)) {
+      logg[LDensity].warn("Gaussian smearing is undefined for momentum ", p);
+      continue;
+    }
+    const ThreeVector v = part.velocity();
+    const FourVector jmu = FourVector(1.0, v) * (dens_factor * p.x0() / m);
+    FourVectorGrid &jmu_charge = dens_factor > 0. ? jmu_pos : jmu_neg;
+
+    // Cloud-in-cell: the 2 nearest nodes in every direction and their weights
+    const ThreeVector pos = part.position().threevec();
+    std::array<std::array<int, 2>, 3> index;
+    std::array<std::array<double, 2>, 3> weight;
+    for (int k = 0; k < 3; k++) {
+      const double t = (pos[k] - lat->origin()[k]) / cell_sizes[k] - 0.5;
+      const int i0 = static_cast<int>(std::floor(t));
+      weight[k] = {1. - (t - i0), t - i0};
+      for (int s = 0; s < 2; s++) {
+        index[k][s] = i0 + s + padding[k];
+        if (periodic) {
+          index[k][s] = (index[k][s] % n[k] + n[k]) % n[k];
+        }
+      }
+    }
+    for (int sz = 0; sz < 2; sz++) {
+      for (int sy = 0; sy < 2; sy++) {
+        for (int sx = 0; sx < 2; sx++) {
+          const int ix = index[0][sx], iy = index[1][sy], iz = index[2][sz];
+          if (ix < 0 || ix >= dims[0] || iy < 0 || iy >= dims[1] || iz < 0 ||
+              iz >= dims[2]) {
+            continue;
+          }
+          const FourVector contribution =
+              jmu * (weight[0][sx] * weight[1][sy] * weight[2][sz]);
+          jmu_charge(ix, iy, iz) += contribution;
+          for (std::size_t k = 0; k < jmu_flux.size(); k++) {
+            jmu_flux[k](ix, iy, iz) += contribution * v[k];
+          }
+        }
+      }
+    }
+  }
+
+  /* Convolve along x, y and z, using the derivative of the Gaussian along
+   * the direction deriv_axis (none for -1). */
+  const auto smear = [&](const FourVectorGrid &grid, int deriv_axis) {
+    FourVectorGrid result = grid;
+    for (int k = 0; k < 3; k++) {
+      const SeparableKernel &kernel = kernels[k];
+      result = convolve_axis(
+          result, k, k == deriv_axis ? kernel.derivative : kernel.gauss, n[k],
+          padding[k], periodic);
+    }
+    return result;
+  };
+  const FourVectorGrid smeared_pos = smear(jmu_pos, -1);
+  const FourVectorGrid smeared_neg = smear(jmu_neg, -1);
+  std::vector<FourVectorGrid> djmu_dxk, dflux_dxk;
+  if (compute_gradient) {
+    FourVectorGrid jmu_net = jmu_pos;
+    jmu_net += jmu_neg;
+    for (int k = 0; k < 3; k++) {
+      djmu_dxk.push_back(smear(jmu_net, k));
+      dflux_dxk.push_back(smear(jmu_flux[k], k));
+    }
+  }
+
+  for (int iz = 0; iz < n[2]; iz++) {
+    for (int iy = 0; iy < n[1]; iy++) {
+      for (int ix = 0; ix < n[0]; ix++) {
+        std::array<FourVector, 4> djmu_dx;
+        for (std::size_t k = 0; k < djmu_dxk.size(); k++) {
+          djmu_dx[k + 1] = djmu_dxk[k](ix, iy, iz) * norm_factor;
+          djmu_dx[0] -= dflux_dxk[k](ix, iy, iz) * norm_factor;
+        }
+        lat->node(ix, iy, iz) =
+            DensityOnLattice(smeared_pos(ix, iy, iz) * norm_factor,
+                             smeared_neg(ix, iy, iz) * norm_factor, djmu_dx);
+      }
+    }
+  }
+}
+
 std::ostream &operator<<(std::ostream &os, DensityType dens_type) {
   switch (dens_type) {
     case DensityType::Hadron:
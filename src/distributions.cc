@@ -91,7 +91,11 @@ double juttner_distribution_func(double momentum_radial, double mass,
 double sample_momenta_non_eq_mass(const double temperature, const double mass) {
   logg[LDistributions].debug("Sample momenta with mass ", mass, " and T ",
                              temperature);
+  return sample_momenta_non_eq_mass(temperature, mass, random::engine);
+}
 
+double sample_momenta_non_eq_mass(const double temperature, const double mass,
+                                  random::Engine &rng) {
   /* Calculate range on momentum values to use
    * ideally 0.0 and as large as possible but we want to be efficient! */
   const double mom_min = 0.0;
@@ -112,12 +116,12 @@ double sample_momenta_non_eq_mass(const double temperature, const double mass) {
   double energy, momentum_radial, probability;
   do {
     // sample uniformly in momentum, DONT sample uniformly in energy!
-    momentum_radial = random::uniform(mom_min, mom_max);
+    momentum_radial = random::uniform(mom_min, mom_max, rng);
     // Energy by on-shell condition
     energy = std::sqrt(momentum_radial * momentum_radial + mass * mass);
     probability = density_integrand_mass(
         energy, momentum_radial * momentum_radial, temperature);
-  } while (random::uniform(0., probability_max) > probability);
+  } while (random::uniform(0., probability_max, rng) > probability);
 
   return momentum_radial;
 }
@@ -125,6 +129,11 @@ double sample_momenta_non_eq_mass(const double temperature, const double mass) {
 double sample_momenta_1M_IC(const double temperature, const double mass) {
   logg[LDistributions].debug("Sample momenta with mass ", mass, " and T ",
                              temperature);
+  return sample_momenta_1M_IC(temperature, mass, random::engine);
+}
+
+double sample_momenta_1M_IC(const double temperature, const double mass,
+                            random::Engine &rng) {
   // Maxwell-Boltzmann average E <E>=3T + m * K_1(m/T) / K_2(m/T)
   double energy_average;
   if (mass > 0.) {
@@ -150,11 +159,11 @@ double sample_momenta_1M_IC(const double temperature, const double mass) {
    * random momenta and random probability need to be below the distribution */
   double momentum_radial_sqr, probability;
   do {
-    double energy = random::uniform(energy_min, energy_max);
+    double energy = random::uniform(energy_min, energy_max, rng);
     momentum_radial_sqr = (energy - mass) * (energy + mass);
     probability =
         density_integrand_1M_IC(energy, momentum_radial_sqr, temperature);
-  } while (random::uniform(0., probability_max) > probability);
+  } while (random::uniform(0., probability_max, rng) > probability);
 
   return std::sqrt(momentum_radial_sqr);
 }
@@ -162,6 +171,11 @@ double sample_momenta_1M_IC(const double temperature, const double mass) {
 double sample_momenta_2M_IC(const double temperature, const double mass) {
   logg[LDistributions].debug("Sample momenta with mass ", mass, " and T ",
                              temperature);
+  return sample_momenta_2M_IC(temperature, mass, random::engine);
+}
+
+double sample_momenta_2M_IC(const double temperature, const double mass,
+                            random::Engine &rng) {
   /* Maxwell-Boltzmann average E <E>=3T + m * K_1(m/T) / K_2(m/T) */
   double energy_average;
   if (mass > 0.) {
@@ -187,11 +201,11 @@ double sample_momenta_2M_IC(const double temperature, const double mass) {
    * random momenta and random probability need to be below the distribution */
   double momentum_radial_sqr, probability;
   do {
-    double energy = random::uniform(energy_min, energy_max);
+    double energy = random::uniform(energy_min, energy_max, rng);
     momentum_radial_sqr = (energy - mass) * (energy + mass);
     probability =
         density_integrand_2M_IC(energy, momentum_radial_sqr, temperature);
-  } while (random::uniform(0., probability_max) > probability);
+  } while (random::uniform(0., probability_max, rng) > probability);
 
   return std::sqrt(momentum_radial_sqr);
 }
@@ -200,44 +214,49 @@ double sample_momenta_from_thermal(const double temperature,
                                    const double mass) {
   logg[LDistributions].debug("Sample momenta with mass ", mass, " and T ",
                              temperature);
+  return sample_momenta_from_thermal(temperature, mass, random::engine);
+}
+
+double sample_momenta_from_thermal(const double temperature, const double mass,
+                                   random::Engine &rng) {
   double momentum_radial, energy;
   // when temperature/mass
   if (temperature > 0.6 * mass) {
     while (true) {
-      const double a = -std::log(random::canonical_nonzero());
-      const double b = -std::log(random::canonical_nonzero());
-      const double c = -std::log(random::canonical_nonzero());
+      const double a = -std::log(random::canonical_nonzero(rng));
+      const double b = -std::log(random::canonical_nonzero(rng));
+      const double c = -std::log(random::canonical_nonzero(rng));
       momentum_radial = temperature * (a + b + c);
       energy = std::sqrt(momentum_radial * momentum_radial + mass * mass);
-      if (random::canonical() <
+      if (random::canonical(rng) <
           std::exp((momentum_radial - energy) / temperature)) {
         break;
       }
     }
   } else {
     while (true) {
-      const double r0 = random::canonical();
+      const double r0 = random::canonical(rng);
       const double I1 = mass * mass;
       const double I2 = 2.0 * mass * temperature;
       const double I3 = 2.0 * temperature * temperature;
       const double Itot = I1 + I2 + I3;
       double K;
       if (r0 < I1 / Itot) {
-        const double r1 = random::canonical_nonzero();
+        const double r1 = random::canonical_nonzero(rng);
         K = -temperature * std::log(r1);
       } else if (r0 < (I1 + I2) / Itot) {
-        const double r1 = random::canonical_nonzero();
-        const double r2 = random::canonical_nonzero();
+        const double r1 = random::canonical_nonzero(rng);
+        const double r2 = random::canonical_nonzero(rng);
         K = -temperature * std::log(r1 * r2);
       } else {
-        const double r1 = random::canonical_nonzero();
-        const double r2 = random::canonical_nonzero();
-        const double r3 = random::canonical_nonzero();
+        const double r1 = random::canonical_nonzero(rng);
+        const double r2 = random::canonical_nonzero(rng);
+        const double r3 = random::canonical_nonzero(rng);
         K = -temperature * std::log(r1 * r2 * r3);
       }
       energy = K + mass;
       momentum_radial = std::sqrt((energy + mass) * (energy - mass));
-      if (random::canonical() < momentum_radial / energy) {
+      if (random::canonical(rng) < momentum_radial / energy) {
         break;
       }
     }
@@ -245,12 +264,12 @@ double sample_momenta_from_thermal(const double temperature,
   return momentum_radial;
 }
 
-double sample_momenta_IC_ES(const double temperature) {
+double sample_momenta_IC_ES(const double temperature, random::Engine &rng) {
   double momentum_radial;
-  const double a = -std::log(random::canonical_nonzero());
-  const double b = -std::log(random::canonical_nonzero());
-  const double c = -std::log(random::canonical_nonzero());
-  const double d = -std::log(random::canonical_nonzero());
+  const double a = -std::log(random::canonical_nonzero(rng));
+  const double b = -std::log(random::canonical_nonzero(rng));
+  const double c = -std::log(random::canonical_nonzero(rng));
+  const double d = -std::log(random::canonical_nonzero(rng));
   momentum_radial = (3.0 / 4.0) * temperature * (a + b + c + d);
 
   return momentum_radial;
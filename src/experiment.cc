@@ -114,6 +114,37 @@ ExperimentPtr ExperimentBase::create(Configuration config,
      Output_Times: [-0.1, 0.0, 1.0, 2.0, 10.0]
  \endverbatim
  *
+ * \key VTK_Compression (bool, optional, default = false): \n
+ * Compress the binary data arrays of the "VTK_XML" output with zlib. This
+ * requires SMASH to be compiled with zlib support.
+ *
+ * \key Root_Buffer_Size (int, optional, default = 500000): \n
+ * Maximal number of particles in one entry of the ROOT particles tree. Larger
+ * particle lists are split into several entries. The buffers only grow up to
+ * this size when needed.
+ *
+ * \key Root_Basket_Size (int, optional, default = 32000): \n
+ * Size of the baskets of the ROOT branches in bytes.
+ *
+ * \key Root_Auto_Flush (int, optional, default = -30000000): \n
+ * Auto-flush setting of the ROOT trees. A positive value flushes the baskets
+ * after this number of entries, a negative value after this number of bytes,
+ * see TTree::SetAutoFlush.
+ *
+ * \key Root_Compression_Algorithm (string, optional, default = ROOT default):
+ * \n
+ * Compression algorithm of the ROOT files. Possible values are
+ * \key "zlib", \key "lzma", \key "lz4" and \key "zstd", where the latter two
+ * require a recent ROOT version.
+ *
+ * \key Root_Compression_Level (int, optional, default = ROOT default): \n
+ * Compression level of the ROOT files between 0 (no compression) and 9. If
+ * only the algorithm is given, level 1 is used.
+ *
+ * \key Root_Threaded_Fill (bool, optional, default = false): \n
+ * Fill the ROOT trees in a background thread, such that the compression of
+ * an entry overlaps with the simulation.
+ *
  * \key Density_Type (string, optional, default = "none"): \n
  * Determines which kind of density is printed into the headers of the
  * collision files.
@@ -182,19 +213,24 @@ ExperimentPtr ExperimentBase::create(Configuration config,
  *   \li \key false - Regular output for each particle \n
  * \n
  * - \b Initial_Conditions (Oscar1999, Oscar2013, binary, ROOT and special ASCII
- * IC (\ref IC_output_user_guide_) formats)\n
+ * and Compact_Binary IC (\ref IC_output_user_guide_) formats)\n
  *   \key Proper_Time (double, optional, default = nuclei passing time, if
  *   nuclei passing time > \key Lower_Bound, else \key Lower_Bound):
  *   Proper time at which hypersurface is created \n
  *   \key Lower_Bound (double, optional, default = 0.5 fm): Lower bound for the
  *    IC proper time if \key Proper_Time is not provided.\n
  *   \key Extended (bool, optional, default = false, incompatible with
- *                  Oscar1999, ROOT and ASCII format):\n
+ *                  Oscar1999, ROOT, ASCII and Compact_Binary format):\n
  *   \li \key true - Print extended information for each particle
  *   \li \key false - Regular output for each particle \n
  * \n
  * - \b HepMC (Only ASCII format)\n
- *   No content-specific output options \n
+ *   \key Direct_Writer (bool, optional, default = false): \n
+ *   \li \key true - Stream the event record directly into the file, which
+ *                   is much faster for large events. The file content is the
+ *                   same as for the regular writer.
+ *   \li \key false - Build a HepMC3 event record and write it with the HepMC3
+ *                    library \n
  * \n
  * \anchor Thermodynamics
  * - \b Thermodynamics \n
@@ -469,6 +505,7 @@ ExperimentParameters create_experiment_parameters(Configuration config) {
       ntest,
       config.take({"General", "Gaussian_Sigma"}, 1.),
       config.take({"General", "Gauss_Cutoff_In_Sigma"}, 4.),
+      config.take({"Lattice", "Smearing"}, SmearingMode::Covariant),
       config_coll.take({"Collision_Criterion"}, CollisionCriterion::Covariant),
       config_coll.take({"Two_to_One"}, true),
       config_coll.take({"Included_2to2"}, ReactionsBitSet().set()),
@@ -9,6 +9,7 @@
 
 #include "smash/grid.h"
 
+#include <cstdlib>
 #include <stdexcept>
 
 #include "smash/algorithms.h"
@@ -69,7 +70,7 @@ static constexpr int LGrid = LogArea::Grid::id;
 // GridBase
 
 std::pair<std::array<double, 3>, std::array<double, 3>>
-GridBase::find_min_and_length(const Particles &particles) {
+GridBase::find_min_and_length(const Particles &particles, double skin) {
   std::pair<std::array<double, 3>, std::array<double, 3>> r;
   auto &min_position = r.first;
   auto &length = r.second;
@@ -88,9 +89,10 @@ GridBase::find_min_and_length(const Particles &particles) {
     max_position[1] = std::max(max_position[1], pos[2]);
     max_position[2] = std::max(max_position[2], pos[3]);
   }
-  length[0] = max_position[0] - min_position[0];
-  length[1] = max_position[1] - min_position[1];
-  length[2] = max_position[2] - min_position[2];
+  for (int i = 0; i < 3; ++i) {
+    min_position[i] -= skin;
+    length[i] = max_position[i] - min_position[i] + skin;
+  }
   return r;
 }
 
@@ -102,17 +104,20 @@ Grid<O>::Grid(const std::pair<std::array<double, 3>, std::array<double, 3>>
                   &min_and_length,
               const Particles &particles, double max_interaction_length,
               double timestep_duration, CellSizeStrategy strategy)
-    : length_(min_and_length.second) {
-  const auto min_position = min_and_length.first;
-  const SizeType particle_count = particles.size();
+    : min_position_(min_and_length.first),
+      length_(min_and_length.second),
+      min_cell_length_(max_interaction_length),
+      particle_count_(particles.size()),
+      strategy_(strategy) {
+  const auto &min_position = min_position_;
+  const SizeType particle_count = particle_count_;
 
   // very simple setup for non-periodic boundaries and largest cellsize strategy
   if (O == GridOptions::Normal && strategy == CellSizeStrategy::Largest) {
     number_of_cells_ = {1, 1, 1};
     cell_volume_ = length_[0] * length_[1] * length_[2];
-    cells_.clear();
-    cells_.reserve(1);
-    cells_.emplace_back(particles.copy_to_vector());
+    cells_.resize(1);
+    place_particles(particles, timestep_duration);
     return;
   }
 
@@ -146,9 +151,9 @@ Grid<O>::Grid(const std::pair<std::array<double, 3>, std::array<double, 3>>
 
   // This normally equals 1/max_interaction_length, but if the number of cells
   // is reduced (because of low density) then this value is smaller.
-  std::array<double, 3> index_factor = {1. / max_interaction_length,
-                                        1. / max_interaction_length,
-                                        1. / max_interaction_length};
+  auto &index_factor = index_factor_;
+  index_factor = {1. / max_interaction_length, 1. / max_interaction_length,
+                  1. / max_interaction_length};
   for (std::size_t i = 0; i < number_of_cells_.size(); ++i) {
     number_of_cells_[i] =
         (strategy == CellSizeStrategy::Largest)
@@ -219,11 +224,7 @@ Grid<O>::Grid(const std::pair<std::array<double, 3>, std::array<double, 3>>
     cell_volume_ = length_[0] * length_[1] * length_[2];
     cells_.resize(1);
     cells_.front().reserve(particles.size());
-    std::copy_if(particles.begin(), particles.end(),
-                 std::back_inserter(cells_.front()),
-                 [&](const ParticleData &p) {
-                   return p.xsec_scaling_factor(timestep_duration) > 0.0;
-                 });  // filter out the particles that can not interact
+    place_particles(particles, timestep_duration);
   } else {
     // construct a normal grid
     logg[LGrid].debug("min: ", min_position, "\nlength: ", length_,
@@ -236,39 +237,82 @@ Grid<O>::Grid(const std::pair<std::array<double, 3>, std::array<double, 3>>
     cells_.resize(number_of_cells_[0] * number_of_cells_[1] *
                   number_of_cells_[2]);
 
-    // Returns the one-dimensional cell-index from the position vector inside
-    // the grid.
-    // This simply calculates the distance to min_position and multiplies it
-    // with index_factor to determine the 3 x,y,z indexes to pass to make_index.
-    auto &&cell_index_for = [&](const ParticleData &p) {
-      return make_index(
-          std::floor((p.position()[1] - min_position[0]) * index_factor[0]),
-          std::floor((p.position()[2] - min_position[1]) * index_factor[1]),
-          std::floor((p.position()[3] - min_position[2]) * index_factor[2]));
-    };
+    if (!place_particles(particles, timestep_duration)) {
+      logg[LGrid].fatal(
+          SMASH_SOURCE_LOCATION,
+          "\nan out-of-bounds access would be necessary for a grid with the "
+          "following parameters:\nmin: ",
+          min_position, "\nlength: ", length_, "\ncells: ", number_of_cells_,
+          "\nindex_factor: ", index_factor);
+      throw std::runtime_error("out-of-bounds grid access on construction");
+    }
+  }
+
+  logg[LGrid].debug(cells_);
+}
+
+template <GridOptions O>
+bool Grid<O>::place_particles(const Particles &particles,
+                              double timestep_duration) {
+  for (auto &cell : cells_) {
+    cell.clear();
+  }
+  if (O == GridOptions::Normal && strategy_ == CellSizeStrategy::Largest) {
+    cells_.front().assign(particles.begin(), particles.end());
+    return true;
+  }
+  // filter out the particles that can not interact
+  auto &&can_interact = [&](const ParticleData &p) {
+    return p.xsec_scaling_factor(timestep_duration) > 0.0;
+  };
 
+  if (number_of_cells_[0] * number_of_cells_[1] * number_of_cells_[2] == 1) {
+    // dilute limit (see the constructor)
     for (const auto &p : particles) {
-      if (p.xsec_scaling_factor(timestep_duration) > 0.0) {
-        const auto idx = cell_index_for(p);
-#ifndef NDEBUG
-        if (idx >= SizeType(cells_.size())) {
-          logg[LGrid].fatal(
-              SMASH_SOURCE_LOCATION,
-              "\nan out-of-bounds access would be necessary for the "
-              "particle ",
-              p, "\nfor a grid with the following parameters:\nmin: ",
-              min_position, "\nlength: ", length_,
-              "\ncells: ", number_of_cells_, "\nindex_factor: ", index_factor,
-              "\ncells_.size: ", cells_.size(), "\nrequested index: ", idx);
-          throw std::runtime_error("out-of-bounds grid access on construction");
+      const auto &pos = p.position();
+      for (int i = 0; i < 3; ++i) {
+        if (pos[i + 1] < min_position_[i] ||
+            pos[i + 1] > min_position_[i] + length_[i]) {
+          return false;
         }
-#endif
-        cells_[idx].push_back(p);
+      }
+      if (can_interact(p)) {
+        cells_.front().push_back(p);
       }
     }
+    return true;
   }
 
-  logg[LGrid].debug(cells_);
+  // This simply calculates the distance to min_position_ and multiplies it
+  // with index_factor_ to determine the 3 x,y,z indexes to pass to
+  // make_index.
+  std::array<SizeType, 3> idx;
+  for (const auto &p : particles) {
+    if (can_interact(p)) {
+      const auto &pos = p.position();
+      for (int i = 0; i < 3; ++i) {
+        const double x = (pos[i + 1] - min_position_[i]) * index_factor_[i];
+        if (!(x >= 0. && x < number_of_cells_[i])) {
+          logg[LGrid].debug("particle ", p, " lies outside of the grid");
+          return false;
+        }
+        idx[i] = static_cast<SizeType>(x);
+      }
+      cells_[make_index(idx)].push_back(p);
+    }
+  }
+  return true;
+}
+
+template <GridOptions O>
+bool Grid<O>::update(const Particles &particles, double min_cell_length,
+                     double timestep_duration) {
+  const SizeType particle_count = particles.size();
+  if (min_cell_length > min_cell_length_ ||
+      std::abs(particle_count - particle_count_) > particle_count_ / 2) {
+    return false;
+  }
+  return place_particles(particles, timestep_duration);
 }
 
 template <GridOptions Options>
@@ -474,6 +518,12 @@ void Grid<GridOptions::PeriodicBoundaries>::iterate_cells(
   }
 }
 
+template bool Grid<GridOptions::Normal>::update(const Particles &particles,
+                                                double min_cell_length,
+                                                double timestep_duration);
+template bool Grid<GridOptions::PeriodicBoundaries>::update(
+    const Particles &particles, double min_cell_length,
+    double timestep_duration);
 template Grid<GridOptions::Normal>::Grid(
     const std::pair<std::array<double, 3>, std::array<double, 3>>
         &min_and_length,
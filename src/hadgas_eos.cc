@@ -387,6 +387,22 @@ double HadronGasEos::sample_mass_thermal(const ParticleType &ptype,
   if (ptype.is_stable()) {
     return ptype.mass();
   }
+  ThermalMassEnvelope envelope = thermal_mass_envelope(ptype, beta);
+  const ThermalMassEnvelope initial = envelope;
+  const double m = sample_mass_thermal(envelope);
+  warn_if_maximum_increased(initial, envelope);
+  return m;
+}
+
+/// Upper limit of the sampled resonance masses [GeV]
+static constexpr double thermal_max_mass = 5.0;
+
+HadronGasEos::ThermalMassEnvelope HadronGasEos::thermal_mass_envelope(
+    const ParticleType &ptype, double beta) {
+  ThermalMassEnvelope envelope{&ptype, beta, 0., ptype.mass()};
+  if (ptype.is_stable()) {
+    return envelope;
+  }
   // Sampling mass m from A(m) x^2 BesselK_2(x), where x = beta m.
   // Strategy employs the idea of importance sampling:
   // -- Sample mass from the simple Breit-Wigner first, then
@@ -395,12 +411,11 @@ double HadronGasEos::sample_mass_thermal(const ParticleType &ptype,
   //    and has maximum at x = xmin. That is why instead of f(x)
   //    the ratio f(x)/f(xmin) is used.
 
-  const double max_mass = 5.0;  // GeV
+  const double max_mass = thermal_max_mass;
   double m, q;
   {
     // Allow underflows in exponentials
     DisableFloatTraps guard(FE_DIVBYZERO | FE_INVALID | FE_OVERFLOW);
-    const double w0 = ptype.width_at_pole();
     const double mth = ptype.min_mass_spectral();
     const double m0 = ptype.mass();
     double max_ratio =
@@ -427,24 +442,39 @@ double HadronGasEos::sample_mass_thermal(const ParticleType &ptype,
       m_upper = m_where_max + (m_upper - m_where_max) * 0.1;
     }
     // Safety factor
-    max_ratio *= 1.5;
+    envelope.max_ratio = max_ratio * 1.5;
+    envelope.m_where_max = m_where_max;
+  }
+  return envelope;
+}
 
+double HadronGasEos::sample_mass_thermal(ThermalMassEnvelope &envelope,
+                                         random::Engine &rng) {
+  const ParticleType &ptype = *envelope.ptype;
+  if (ptype.is_stable()) {
+    return ptype.mass();
+  }
+  const double beta = envelope.beta;
+  const double max_mass = thermal_max_mass;
+  double m, q;
+  {
+    // Allow underflows in exponentials
+    DisableFloatTraps guard(FE_DIVBYZERO | FE_INVALID | FE_OVERFLOW);
+    const double w0 = ptype.width_at_pole();
+    const double mth = ptype.min_mass_spectral();
+    const double m0 = ptype.mass();
     do {
       // sample mass from A(m)
       do {
-        m = random::cauchy(m0, 0.5 * w0, mth, max_mass);
+        m = random::cauchy(m0, 0.5 * w0, mth, max_mass, rng);
         const double thermal_factor =
             m * m * std::exp(-beta * m) * gsl_sf_bessel_Kn_scaled(2, m * beta);
         q = ptype.spectral_function(m) * thermal_factor /
             ptype.spectral_function_simple(m);
-      } while (q < random::uniform(0., max_ratio));
-      if (q > max_ratio) {
-        logg[LResonances].warn(
-            ptype.name(), " - maximum increased in",
-            " sample_mass_thermal from ", max_ratio, " to ", q, ", mass = ", m,
-            " previously assumed maximum at m = ", m_where_max);
-        max_ratio = q;
-        m_where_max = m;
+      } while (q < random::uniform(0., envelope.max_ratio, rng));
+      if (q > envelope.max_ratio) {
+        envelope.max_ratio = q;
+        envelope.m_where_max = m;
       } else {
         break;
       }
@@ -453,6 +483,17 @@ double HadronGasEos::sample_mass_thermal(const ParticleType &ptype,
   return m;
 }
 
+void HadronGasEos::warn_if_maximum_increased(
+    const ThermalMassEnvelope &initial, const ThermalMassEnvelope &updated) {
+  if (updated.max_ratio > initial.max_ratio) {
+    logg[LResonances].warn(
+        updated.ptype->name(), " - maximum increased in",
+        " sample_mass_thermal from ", initial.max_ratio, " to ",
+        updated.max_ratio, ", mass = ", updated.m_where_max,
+        " previously assumed maximum at m = ", initial.m_where_max);
+  }
+}
+
 double HadronGasEos::mus_net_strangeness0(double T, double mub, double muq) {
   // Binary search
   double mus_u = mub + T;
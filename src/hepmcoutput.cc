@@ -9,7 +9,11 @@
 
 #include "smash/hepmcoutput.h"
 
+#include <cmath>
+#include <cstdio>
+
 #include "HepMC3/Print.h"
+#include "HepMC3/Version.h"
 
 namespace smash {
 
@@ -43,25 +47,54 @@ namespace smash {
  * output. Furthermore, if you use Fermi motion and want to read in the HepMC
  * ouput into Rivet, you need to disable the check for the beam particle
  * energies with the \key --ignore-beams option.
+ *
+ * Building the HepMC3 event record with one object per particle can dominate
+ * the cost of the output for large events. With the content-specific option
+ * \key Direct_Writer the same Asciiv3 text is streamed directly into the file
+ * instead, see \ref output_content_specific_options_.
  */
 
 const int HepMcOutput::status_code_for_beam_particles = 4;
 const int HepMcOutput::status_code_for_final_particles = 1;
 
 HepMcOutput::HepMcOutput(const bf::path &path, std::string name,
-                         const OutputParameters & /*out_par*/,
-                         const int total_N, const int proj_N)
+                         const OutputParameters &out_par, const int total_N,
+                         const int proj_N)
     : OutputInterface(name),
       filename_(path / (name + ".asciiv3")),
       total_N_(total_N),
-      proj_N_(proj_N) {
+      proj_N_(proj_N),
+      direct_(out_par.hepmc_direct) {
   filename_unfinished_ = filename_;
   filename_unfinished_ += +".unfinished";
-  output_file_ =
-      make_unique<HepMC3::WriterAscii>(filename_unfinished_.string());
+  if (direct_) {
+    direct_file_ = fopen(filename_unfinished_, "w");
+    std::fprintf(direct_file_.get(),
+                 "HepMC::Version %s\nHepMC::Asciiv3-START_EVENT_LISTING\n",
+                 HepMC3::version().c_str());
+    /* The cross section is the same dummy for all events. It is attached to
+     * an event like in the GenEvent path, so that the attribute string is
+     * identical. */
+    HepMC3::GenEvent event(HepMC3::Units::GEV, HepMC3::Units::MM);
+    std::shared_ptr<HepMC3::GenCrossSection> cross_section =
+        std::make_shared<HepMC3::GenCrossSection>();
+    event.add_attribute("GenCrossSection", cross_section);
+    const double dummy_xs = 1.0;
+    cross_section->set_cross_section(dummy_xs, dummy_xs);
+    cross_section->to_string(cross_section_string_);
+  } else {
+    output_file_ =
+        make_unique<HepMC3::WriterAscii>(filename_unfinished_.string());
+  }
 }
 
-HepMcOutput::~HepMcOutput() { bf::rename(filename_unfinished_, filename_); }
+HepMcOutput::~HepMcOutput() {
+  if (direct_) {
+    std::fprintf(direct_file_.get(), "HepMC::Asciiv3-END_EVENT_LISTING\n\n");
+    direct_file_.reset();
+  }
+  bf::rename(filename_unfinished_, filename_);
+}
 
 int HepMcOutput::construct_nuclear_pdg_code(int na, int nz) const {
   const int pdg_nuclear_code_prefix = 10 * 1E8;
@@ -79,22 +112,7 @@ int HepMcOutput::construct_nuclear_pdg_code(int na, int nz) const {
 
 void HepMcOutput::at_eventstart(const Particles &particles,
                                 const int event_number, const EventInfo &) {
-  current_event_ =
-      make_unique<HepMC3::GenEvent>(HepMC3::Units::GEV, HepMC3::Units::MM);
-
-  /* Rivet needs a value for the cross section, but SMASH only knows about
-   * nucleon cross sections, not about cross sections between nuclei,
-   * so a dummy is used. */
-  std::shared_ptr<HepMC3::GenCrossSection> cross_section =
-      std::make_shared<HepMC3::GenCrossSection>();
-  current_event_->add_attribute("GenCrossSection", cross_section);
-  const double dummy_xs = 1.0;
-  cross_section->set_cross_section(dummy_xs, dummy_xs);
-
-  current_event_->set_event_number(event_number);
-  vertex_ = std::make_shared<HepMC3::GenVertex>();
-  current_event_->add_vertex(vertex_);
-
+  beam_particles_.clear();
   if (proj_N_ > 0) {
     // Collider modus: Construct and write projectile and target as two intial
     // particles
@@ -125,37 +143,56 @@ void HepMcOutput::at_eventstart(const Particles &particles,
       }
     }
 
-    const int proj_nuclear_pdg_code =
-        construct_nuclear_pdg_code(proj_N_, proj_Z);
-    const int targ_nuclear_pdg_code =
-        construct_nuclear_pdg_code(targ_N, targ_Z);
-
-    HepMC3::GenParticlePtr projectile_p = std::make_shared<HepMC3::GenParticle>(
-        HepMC3::FourVector(total_mom_proj.x1(), total_mom_proj.x2(),
-                           total_mom_proj.x3(), total_mom_proj.x0()),
-        proj_nuclear_pdg_code, status_code_for_beam_particles);
-    vertex_->add_particle_in(projectile_p);
-    HepMC3::GenParticlePtr target_p = std::make_shared<HepMC3::GenParticle>(
-        HepMC3::FourVector(total_mom_targ.x1(), total_mom_targ.x2(),
-                           total_mom_targ.x3(), total_mom_targ.x0()),
-        targ_nuclear_pdg_code, status_code_for_beam_particles);
-    vertex_->add_particle_in(target_p);
-
+    beam_particles_.emplace_back(total_mom_proj,
+                                 construct_nuclear_pdg_code(proj_N_, proj_Z));
+    beam_particles_.emplace_back(total_mom_targ,
+                                 construct_nuclear_pdg_code(targ_N, targ_Z));
   } else {
     // Other modi (not collider): Write all inital particles into output
+    beam_particles_.reserve(particles.size());
     for (const ParticleData &data : particles) {
-      const FourVector mom = data.momentum();
-      HepMC3::GenParticlePtr p = std::make_shared<HepMC3::GenParticle>(
-          HepMC3::FourVector(mom.x1(), mom.x2(), mom.x3(), mom.x0()),
-          data.pdgcode().get_decimal(), status_code_for_beam_particles);
-      vertex_->add_particle_in(p);
+      beam_particles_.emplace_back(data.momentum(),
+                                   data.pdgcode().get_decimal());
     }
   }
+
+  if (direct_) {
+    event_number_ = event_number;
+    return;
+  }
+
+  current_event_ =
+      make_unique<HepMC3::GenEvent>(HepMC3::Units::GEV, HepMC3::Units::MM);
+
+  /* Rivet needs a value for the cross section, but SMASH only knows about
+   * nucleon cross sections, not about cross sections between nuclei,
+   * so a dummy is used. */
+  std::shared_ptr<HepMC3::GenCrossSection> cross_section =
+      std::make_shared<HepMC3::GenCrossSection>();
+  current_event_->add_attribute("GenCrossSection", cross_section);
+  const double dummy_xs = 1.0;
+  cross_section->set_cross_section(dummy_xs, dummy_xs);
+
+  current_event_->set_event_number(event_number);
+  vertex_ = std::make_shared<HepMC3::GenVertex>();
+  current_event_->add_vertex(vertex_);
+
+  for (const auto &beam_particle : beam_particles_) {
+    const FourVector &mom = beam_particle.first;
+    HepMC3::GenParticlePtr p = std::make_shared<HepMC3::GenParticle>(
+        HepMC3::FourVector(mom.x1(), mom.x2(), mom.x3(), mom.x0()),
+        beam_particle.second, status_code_for_beam_particles);
+    vertex_->add_particle_in(p);
+  }
 }
 
 void HepMcOutput::at_eventend(const Particles &particles,
                               const int32_t /*event_number*/,
                               const EventInfo &event) {
+  if (direct_) {
+    write_event_directly(particles, event);
+    return;
+  }
   // Set heavy ion attribute, only the impact parameter is known
   std::shared_ptr<HepMC3::GenHeavyIon> heavy_ion =
       std::make_shared<HepMC3::GenHeavyIon>();
@@ -176,4 +213,70 @@ void HepMcOutput::at_eventend(const Particles &particles,
   output_file_->write_event(*current_event_);
 }
 
+void HepMcOutput::write_event_directly(const Particles &particles,
+                                       const EventInfo &event) {
+  /* This mirrors HepMC3::WriterAscii for an event with the single central
+   * vertex (id -1) and the particles numbered in the order in which they are
+   * added to it: first the incoming, then the outgoing ones. */
+  const size_t n_beam = beam_particles_.size();
+  event_buffer_.clear();
+  char line[256];
+  int length = std::snprintf(line, sizeof(line), "E %d 1 %zu\nU GEV MM\n",
+                             event_number_, n_beam + particles.size());
+  event_buffer_.append(line, length);
+
+  // Attributes in the alphabetical order of their names
+  event_buffer_ += "A 0 GenCrossSection " + cross_section_string_ + "\n";
+  HepMC3::GenHeavyIon heavy_ion;
+  heavy_ion.set(-1, -1, -1, -1, -1, -1, -1, -1, -1,
+                event.impact_parameter * 1E-12, -1.0, -1.0, -1.0, -1.0, -1.0);
+  std::string heavy_ion_string;
+  heavy_ion.to_string(heavy_ion_string);
+  event_buffer_ += "A 0 GenHeavyIon " + heavy_ion_string + "\n";
+
+  int id = 0;
+  auto append_particle = [&](int parent, int pdg, const FourVector &mom,
+                             int status) {
+    // same as HepMC3::FourVector::m()
+    const double m2 = mom.x0() * mom.x0() -
+                      (mom.x1() * mom.x1() + mom.x2() * mom.x2() +
+                       mom.x3() * mom.x3());
+    const double m = m2 < 0.0 ? -std::sqrt(-m2) : std::sqrt(m2);
+    length = std::snprintf(line, sizeof(line),
+                           "P %i %i %i %.16e %.16e %.16e %.16e %.16e %i\n",
+                           ++id, parent, pdg, mom.x1(), mom.x2(), mom.x3(),
+                           mom.x0(), m, status);
+    event_buffer_.append(line, length);
+  };
+
+  for (const auto &beam_particle : beam_particles_) {
+    append_particle(0, beam_particle.second, beam_particle.first,
+                    status_code_for_beam_particles);
+  }
+
+  /* Like WriterAscii, the vertex is only written if it has more than one
+   * incoming particle. Otherwise the outgoing particles refer directly to the
+   * single incoming particle (id 1), or to no parent (0) without any. */
+  const int parent = n_beam > 1 ? -1 : static_cast<int>(n_beam);
+  bool vertex_written = n_beam <= 1;
+  for (const ParticleData &data : particles) {
+    if (!vertex_written) {
+      event_buffer_ += "V -1 0 [";
+      for (size_t i = 1; i <= n_beam; i++) {
+        if (i > 1) {
+          event_buffer_ += ',';
+        }
+        event_buffer_ += std::to_string(i);
+      }
+      event_buffer_ += "]\n";
+      vertex_written = true;
+    }
+    append_particle(parent, data.pdgcode().get_decimal(), data.momentum(),
+                    status_code_for_final_particles);
+  }
+
+  std::fwrite(event_buffer_.data(), 1, event_buffer_.size(),
+              direct_file_.get());
+}
+
 }  // namespace smash
@@ -9,6 +9,10 @@
 
 #include "smash/hypersurfacecrossingaction.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #include "smash/logging.h"
 #include "smash/quantumnumbers.h"
 
@@ -52,137 +56,119 @@ ActionList HyperSurfaceCrossActionsFinder::find_actions_in_cell(
     const std::vector<FourVector> &beam_momentum) const {
   std::vector<ActionPtr> actions;
 
-  for (const ParticleData &p : plist) {
-    ParticleData pdata_before_propagation = p;
-    ParticleData pdata_after_propagation = p;  // Will receive updated position
-    double t0 = p.position().x0();
-    double t_end = t0 + dt;  // Time at the end of timestep
-
-    // We don't want to remove particles before the nuclei have interacted
-    // because those would not yet be part of the newly-created medium.
-    if (t_end < 0.0) {
-      continue;
+  if (crossing_schedule_ && !plist.empty()) {
+    HyperSurfaceCrossingSchedule &schedule = *crossing_schedule_;
+    const double time = plist.front().position().x0();
+    if (time > schedule.current_time) {
+      // first search of a new timestep
+      schedule.previous_time = schedule.current_time;
+      schedule.current_time = time;
+      if (schedule.entries.size() > schedule.purge_size) {
+        purge_crossing_schedule();
+      }
     }
+  }
 
-    // For frozen Fermi motion:
-    // Fermi momenta are only applied if particles interact. The particle
-    // properties p.velocity() and p.momentum() already contain the values
-    // corrected by Fermi motion, but those particles that have not yet
-    // interacted are propagated along the beam-axis with v = (0, 0, beam_v)
-    // (and not with p.velocity()).
-    // To identify the corresponding hypersurface crossings the finding for
-    // those paricles without prior interactions has to be performed with
-    // v = vbeam instead of p.velcocity().
-    // Note: The beam_momentum vector is empty in case frozen Fermi motion is
-    // not applied.
-    const bool no_prior_interactions =
-        (static_cast<uint64_t>(p.id()) <                  // particle from
-         static_cast<uint64_t>(beam_momentum.size())) &&  // initial nucleus
-        (p.get_history().collisions_per_particle == 0);
-    ThreeVector v;
-    if (no_prior_interactions) {
-      const FourVector vbeam = beam_momentum[p.id()];
-      v = vbeam.velocity();
+  for (const ParticleData &p : plist) {
+    const double t0 = p.position().x0();
+    double t_crossing;
+    if (crossing_schedule_) {
+      auto &entries = crossing_schedule_->entries;
+      const auto entry = entries.find(p.id());
+      if (entry != entries.end() &&
+          entry->second.id_process == p.id_process() &&
+          entry->second.momentum == p.momentum()) {
+        // the particle is still on the same trajectory
+        t_crossing = entry->second.crossing_time;
+        entry->second.last_used = t0;
+      } else {
+        t_crossing = crossing_time(p, beam_momentum);
+        entries[p.id()] = {p.id_process(), p.momentum(), t_crossing, t0};
+      }
     } else {
-      v = p.velocity();
+      t_crossing = crossing_time(p, beam_momentum);
+    }
+
+    // Only crossings within the time step are turned into actions. Particles
+    // which are already beyond the hypersurface are not removed.
+    if (!(t_crossing >= t0 && t_crossing <= t0 + dt)) {
+      continue;
     }
 
-    // propagate particles to position where they would be at the end of the
-    // time step (after dt)
-    const FourVector distance = FourVector(0.0, v * dt);
-    FourVector position = p.position() + distance;
-    position.set_x0(t_end);
-    // update coordinates to the position corresponding to t_end
-    pdata_after_propagation.set_4position(position);
-
-    bool hypersurface_is_crossed = crosses_hypersurface(
-        pdata_before_propagation, pdata_after_propagation, prop_time_);
-
-    if (hypersurface_is_crossed) {
-      // Get exact coordinates where hypersurface is crossed
-      FourVector crossing_position = coordinates_on_hypersurface(
-          pdata_before_propagation, pdata_after_propagation, prop_time_);
-
-      double time_until_crossing = crossing_position[0] - t0;
-
-      ParticleData outgoing_particle(p);
-      outgoing_particle.set_4position(crossing_position);
-      ActionPtr action = make_unique<HypersurfacecrossingAction>(
-          p, outgoing_particle, time_until_crossing);
-      actions.emplace_back(std::move(action));
+    // Propagate to point where hypersurface is crossed
+    const double time_until_crossing = t_crossing - t0;
+    FourVector crossing_position =
+        p.position() + FourVector(0.0, p.velocity() * time_until_crossing);
+    crossing_position.set_x0(t_crossing);
+
+    ParticleData outgoing_particle(p);
+    outgoing_particle.set_4position(crossing_position);
+    ActionPtr action = make_unique<HypersurfacecrossingAction>(
+        p, outgoing_particle, time_until_crossing);
+    actions.emplace_back(std::move(action));
+    if (crossing_schedule_) {
+      crossing_schedule_->entries.erase(p.id());
     }
   }
   return actions;
 }
 
-bool HyperSurfaceCrossActionsFinder::crosses_hypersurface(
-    ParticleData &pdata_before_propagation,
-    ParticleData &pdata_after_propagation, const double tau) const {
-  bool hypersurface_is_crossed = false;
-  const bool t_greater_z_before_prop =
-      (std::fabs(pdata_before_propagation.position().x0()) >
-               std::fabs(pdata_before_propagation.position().x3())
-           ? 1
-           : 0);
-  const bool t_greater_z_after_prop =
-      (std::fabs(pdata_after_propagation.position().x0()) >
-               std::fabs(pdata_after_propagation.position().x3())
-           ? 1
-           : 0);
-
-  if (t_greater_z_before_prop && t_greater_z_after_prop) {
-    // proper time before and after propagation
-    const double tau_before = pdata_before_propagation.position().tau();
-    const double tau_after = pdata_after_propagation.position().tau();
-
-    if (tau_before <= tau && tau <= tau_after) {
-      hypersurface_is_crossed = true;
-    }
-  } else if (!t_greater_z_before_prop && t_greater_z_after_prop) {
-    // proper time after propagation
-    const double tau_after = pdata_after_propagation.position().tau();
-    if (tau_after >= tau) {
-      hypersurface_is_crossed = true;
-    }
+double HyperSurfaceCrossActionsFinder::crossing_time(
+    const ParticleData &p, const std::vector<FourVector> &beam_momentum) const {
+  // For frozen Fermi motion:
+  // Fermi momenta are only applied if particles interact. The particle
+  // properties p.velocity() and p.momentum() already contain the values
+  // corrected by Fermi motion, but those particles that have not yet
+  // interacted are propagated along the beam-axis with v = (0, 0, beam_v)
+  // (and not with p.velocity()).
+  // To identify the corresponding hypersurface crossings the finding for
+  // those paricles without prior interactions has to be performed with
+  // v = vbeam instead of p.velcocity().
+  // Note: The beam_momentum vector is empty in case frozen Fermi motion is
+  // not applied.
+  const bool no_prior_interactions =
+      (static_cast<uint64_t>(p.id()) <                  // particle from
+       static_cast<uint64_t>(beam_momentum.size())) &&  // initial nucleus
+      (p.get_history().collisions_per_particle == 0);
+  double v_z;
+  if (no_prior_interactions) {
+    v_z = beam_momentum[p.id()].velocity().x3();
+  } else {
+    v_z = p.velocity().x3();
   }
 
-  return hypersurface_is_crossed;
+  // The trajectory z = v_z * t + n crosses t^2 - z^2 = tau^2 at the roots of
+  // (1 - v_z^2) t^2 - 2 v_z n t - (n^2 + tau^2) = 0. The larger one lies in the
+  // future light cone. Depending on the sign of v_z * n, one of the two
+  // equivalent expressions for it avoids a cancellation.
+  const double tau = prop_time_;
+  const double n = p.position().x3() - v_z * p.position().x0();
+  const double one_minus_v2 = std::max(0., 1. - v_z * v_z);
+  const double sqrt_discriminant = std::sqrt(n * n + one_minus_v2 * tau * tau);
+  if (v_z * n < 0.) {
+    return (n * n + tau * tau) / (sqrt_discriminant - v_z * n);
+  } else if (one_minus_v2 > 0.) {
+    return (v_z * n + sqrt_discriminant) / one_minus_v2;
+  } else {
+    // light-like trajectory moving away from the hypersurface
+    return std::numeric_limits<double>::infinity();
+  }
 }
 
-FourVector HyperSurfaceCrossActionsFinder::coordinates_on_hypersurface(
-    ParticleData &pdata_before_propagation,
-    ParticleData &pdata_after_propagation, const double tau) const {
-  // find t and z at start of propagation
-  const double t1 = pdata_before_propagation.position().x0();
-  const double z1 = pdata_before_propagation.position().x3();
-
-  // find t and z after propagation
-  const double t2 = pdata_after_propagation.position().x0();
-  const double z2 = pdata_after_propagation.position().x3();
-
-  // find slope and intercept of linear function that describes propagation on
-  // straight line
-  const double m = (z2 - z1) / (t2 - t1);
-  const double n = z1 - m * t1;
-
-  // The equation to solve is a quadratic equation which provides two solutions,
-  // the latter is usually out of the t-interval we are looking at.
-  const double sol1 = n * m / (1 - m * m) +
-                      std::sqrt((1 - m * m) * tau * tau + n * n) / (1 - m * m);
-  const double sol2 = n * m / (1 - m * m) -
-                      std::sqrt((1 - m * m) * tau * tau + n * n) / (1 - m * m);
-
-  SMASH_UNUSED(sol2);  // only used in DEBUG output
-  assert((sol1 >= t1 && sol1 <= t2));
-  assert(!(sol2 >= t1 && sol2 <= t2));
-
-  // Propagate to point where hypersurface is crossed
-  const ThreeVector v = pdata_before_propagation.velocity();
-  const FourVector distance = FourVector(0.0, v * (sol1 - t1));
-  FourVector crossing_position = pdata_before_propagation.position() + distance;
-  crossing_position.set_x0(sol1);
-
-  return crossing_position;
+void HyperSurfaceCrossActionsFinder::purge_crossing_schedule() const {
+  /* Entries of particles which were removed or changed their trajectory are
+   * not used anymore. Removing an entry which is still in use only means that
+   * the crossing time is computed again. */
+  auto &entries = crossing_schedule_->entries;
+  for (auto it = entries.begin(); it != entries.end();) {
+    if (it->second.last_used < crossing_schedule_->previous_time) {
+      it = entries.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  crossing_schedule_->purge_size =
+      std::max<std::size_t>(1000, 2 * entries.size());
 }
 
 }  // namespace smash
@@ -9,9 +9,13 @@
 
 #include "smash/icoutput.h"
 
+#include <cstdint>
+#include <cstring>
 #include <fstream>
+#include <vector>
 
 #include <boost/filesystem.hpp>
+#include <boost/numeric/conversion/cast.hpp>
 
 #include "smash/action.h"
 
@@ -19,7 +23,7 @@ namespace smash {
 static constexpr int LHyperSurfaceCrossing = LogArea::HyperSurfaceCrossing::id;
 
 /*!\Userguide
- * \page IC_output_user_guide_ ASCII IC Output
+ * \page IC_output_user_guide_ ASCII and Compact Binary IC Output
  * The ASCII initial conditions output (SMASH_IC.dat) contains a list of
  * particles on a hypersurface of constant proper time. This output is formatted
  * such that it is directly compatible with the
@@ -94,31 +98,210 @@ static constexpr int LHyperSurfaceCrossing = LogArea::HyperSurfaceCrossing::id;
  * If SMASH is run with test particles (necessary e.g. for potentials), the
  * ASCII output will contain Ntest * Npart particle entries. Remember to weigh
  * each of those particles with 1/Ntest.
+ *
+ * \n
+ * **Compact binary format**
+ *
+ * The format \key "Compact_Binary" writes the same quantities to the binary
+ * file SMASH_IC_compact.bin, which avoids formatting and parsing text. The
+ * fields of a particle are described in the header, so that a reader does not
+ * need to know them in advance. The header is structured as follows:
+ * \code
+ * 4*char       uint16_t        uint32_t len*char      uint16_t
+ * magic_number format_version  len      smash_version n_fields
+ * \endcode
+ * \li magic_number - 4 bytes that in ASCII read as "SMIC".
+ * \li format_version - currently 1.
+ * \li len, smash_version - length and characters of the SMASH version.
+ * \li n_fields - number of fields of each particle, followed by one field
+ * description per field:
+ * \code
+ * char uint32_t len*char uint32_t len*char
+ * type len      name     len      unit
+ * \endcode
+ * where type is 'd' for an 8 byte double and 'i' for a 4 byte signed integer.
+ * Currently, the fields are the columns of the ASCII format, i.e. the doubles
+ * tau, x, y, eta, mt, px, py and Rap, followed by the integers pdg (decimal
+ * PDG code) and charge.
+ *
+ * The particles of each event are written at the end of the event in one
+ * block, which is followed by the event end block:
+ * \code
+ * char uint32_t         char int32_t
+ * 'p'  n_part_lines     'f'  ev_num
+ * \endcode
+ * Each of the \c n_part_lines particle lines contains the fields in the order
+ * of the header without any padding.
  */
 
+ICParticle::ICParticle(const ParticleData &data)
+    : tau(data.position().tau()),
+      x(data.position()[1]),
+      y(data.position()[2]),
+      eta(data.position().eta()),
+      // transverse mass
+      mt(std::sqrt(data.type().mass() * data.type().mass() +
+                   data.momentum()[1] * data.momentum()[1] +
+                   data.momentum()[2] * data.momentum()[2])),
+      px(data.momentum()[1]),
+      py(data.momentum()[2]),
+      // momentum space rapidity
+      rapidity(0.5 * std::log((data.momentum()[0] + data.momentum()[3]) /
+                              (data.momentum()[0] - data.momentum()[3]))),
+      pdg(data.pdgcode()),
+      charge(data.type().charge()) {}
+
+namespace {
+
+/// Writes the initial conditions to SMASH_IC.dat in the vHLLE format.
+class ICAsciiWriter : public ICConsumer {
+ public:
+  /**
+   * Create the output file and write the header.
+   *
+   * \param[in] path Path to the output file.
+   */
+  explicit ICAsciiWriter(const bf::path &path)
+      : file_{path / "SMASH_IC.dat", "w"} {
+    std::fprintf(
+        file_.get(),
+        "# %s initial conditions: hypersurface of constant proper time\n",
+        VERSION_MAJOR);
+    std::fprintf(file_.get(), "# tau x y eta mt px py Rap pdg charge\n");
+    std::fprintf(file_.get(), "# fm fm fm none GeV GeV GeV none none e\n");
+  }
+
+  void at_eventstart(int event_number) override {
+    std::fprintf(file_.get(), "# event %i start\n", event_number);
+  }
+
+  void at_crossing(const ICParticle &p) override {
+    std::fprintf(file_.get(), "%g %g %g %g %g %g %g %g %s %i \n", p.tau, p.x,
+                 p.y, p.eta, p.mt, p.px, p.py, p.rapidity,
+                 p.pdg.string().c_str(), p.charge);
+  }
+
+  void at_eventend(int event_number) override {
+    std::fprintf(file_.get(), "# event %i end\n", event_number);
+  }
+
+ private:
+  /// Pointer to output file
+  RenamingFilePtr file_;
+};
+
+/// Writes the initial conditions to SMASH_IC_compact.bin.
+class ICBinaryWriter : public ICConsumer {
+ public:
+  /**
+   * Create the output file and write the header with the field descriptions.
+   *
+   * \param[in] path Path to the output file.
+   */
+  explicit ICBinaryWriter(const bf::path &path)
+      : file_{path / "SMASH_IC_compact.bin", "wb"} {
+    std::fwrite("SMIC", 4, 1, file_.get());  // magic number
+    const std::uint16_t format_version = 1;
+    std::fwrite(&format_version, sizeof(format_version), 1, file_.get());
+    write_string(VERSION_MAJOR);
+    // type, name and unit of the fields
+    static const char *const fields[][3] = {
+        {"d", "tau", "fm"},   {"d", "x", "fm"},     {"d", "y", "fm"},
+        {"d", "eta", "none"}, {"d", "mt", "GeV"},   {"d", "px", "GeV"},
+        {"d", "py", "GeV"},   {"d", "Rap", "none"}, {"i", "pdg", "none"},
+        {"i", "charge", "e"}};
+    const std::uint16_t n_fields = sizeof(fields) / sizeof(fields[0]);
+    std::fwrite(&n_fields, sizeof(n_fields), 1, file_.get());
+    for (const auto &field : fields) {
+      std::fwrite(field[0], 1, 1, file_.get());
+      write_string(field[1]);
+      write_string(field[2]);
+    }
+  }
+
+  void at_crossing(const ICParticle &p) override {
+    const double reals[] = {p.tau, p.x,  p.y,  p.eta,
+                            p.mt,  p.px, p.py, p.rapidity};
+    const std::int32_t integers[] = {p.pdg.get_decimal(), p.charge};
+    const std::size_t offset = buffer_.size();
+    buffer_.resize(offset + sizeof(reals) + sizeof(integers));
+    std::memcpy(&buffer_[offset], reals, sizeof(reals));
+    std::memcpy(&buffer_[offset + sizeof(reals)], integers, sizeof(integers));
+    ++n_particles_;
+  }
+
+  void at_eventend(int event_number) override {
+    // All particles of the event in one block
+    const char pchar = 'p';
+    std::fwrite(&pchar, sizeof(char), 1, file_.get());
+    std::fwrite(&n_particles_, sizeof(n_particles_), 1, file_.get());
+    std::fwrite(buffer_.data(), 1, buffer_.size(), file_.get());
+    buffer_.clear();
+    n_particles_ = 0;
+
+    // Event end line
+    const char fchar = 'f';
+    const std::int32_t event = event_number;
+    std::fwrite(&fchar, sizeof(char), 1, file_.get());
+    std::fwrite(&event, sizeof(event), 1, file_.get());
+
+    // Flush to disk
+    std::fflush(file_.get());
+  }
+
+ private:
+  /**
+   * Write the length of a string followed by its characters.
+   *
+   * \param[in] s String to be written
+   */
+  void write_string(const std::string &s) {
+    const auto size = boost::numeric_cast<std::uint32_t>(s.size());
+    std::fwrite(&size, sizeof(size), 1, file_.get());
+    std::fwrite(s.c_str(), s.size(), 1, file_.get());
+  }
+
+  /// Pointer to output file
+  RenamingFilePtr file_;
+  /// Particle lines of the current event
+  std::vector<char> buffer_;
+  /// Number of particle lines of the current event
+  std::uint32_t n_particles_ = 0;
+};
+
+}  // namespace
+
 ICOutput::ICOutput(const bf::path &path, const std::string &name,
-                   const OutputParameters &out_par)
-    : OutputInterface(name),
-      file_{path / "SMASH_IC.dat", "w"},
-      out_par_(out_par) {
-  std::fprintf(
-      file_.get(),
-      "# %s initial conditions: hypersurface of constant proper time\n",
-      VERSION_MAJOR);
-  std::fprintf(file_.get(), "# tau x y eta mt px py Rap pdg charge\n");
-  std::fprintf(file_.get(), "# fm fm fm none GeV GeV GeV none none e\n");
+                   const OutputParameters &out_par, ICFormat format)
+    : OutputInterface(name), out_par_(out_par) {
+  switch (format) {
+    case ICFormat::ASCII:
+      consumer_ = std::make_shared<ICAsciiWriter>(path);
+      break;
+    case ICFormat::CompactBinary:
+      consumer_ = std::make_shared<ICBinaryWriter>(path);
+      break;
+  }
+}
+
+ICOutput::ICOutput(const std::string &name, const OutputParameters &out_par,
+                   std::shared_ptr<ICConsumer> consumer)
+    : OutputInterface(name), consumer_(std::move(consumer)), out_par_(out_par) {
+  if (!consumer_) {
+    throw std::invalid_argument("ICOutput requires a consumer.");
+  }
 }
 
 ICOutput::~ICOutput() {}
 
 void ICOutput::at_eventstart(const Particles &, const int event_number,
                              const EventInfo &) {
-  std::fprintf(file_.get(), "# event %i start\n", event_number);
+  consumer_->at_eventstart(event_number);
 }
 
 void ICOutput::at_eventend(const Particles &particles, const int event_number,
                            const EventInfo &) {
-  std::fprintf(file_.get(), "# event %i end\n", event_number);
+  consumer_->at_eventend(event_number);
 
   // If the runtime is too short some particles might not yet have
   // reached the hypersurface. Warning is printed.
@@ -141,29 +324,15 @@ void ICOutput::at_interaction(const Action &action, const double) {
   assert(action.get_type() == ProcessType::HyperSurfaceCrossing);
   assert(action.incoming_particles().size() == 1);
 
-  ParticleData particle = action.incoming_particles()[0];
-
-  // transverse mass
-  const double m_trans =
-      std::sqrt(particle.type().mass() * particle.type().mass() +
-                particle.momentum()[1] * particle.momentum()[1] +
-                particle.momentum()[2] * particle.momentum()[2]);
-  // momentum space rapidity
-  const double rapidity =
-      0.5 * std::log((particle.momentum()[0] + particle.momentum()[3]) /
-                     (particle.momentum()[0] - particle.momentum()[3]));
+  const ParticleData &particle = action.incoming_particles()[0];
 
   // Determine if particle is spectator:
   // Fulfilled if particle is initial nucleon, aka has no prior interactions
   bool is_spectator = particle.get_history().collisions_per_particle == 0;
 
-  // write particle data excluding spectators
+  // pass particle data excluding spectators
   if (!is_spectator) {
-    std::fprintf(file_.get(), "%g %g %g %g %g %g %g %g %s %i \n",
-                 particle.position().tau(), particle.position()[1],
-                 particle.position()[2], particle.position().eta(), m_trans,
-                 particle.momentum()[1], particle.momentum()[2], rapidity,
-                 particle.pdgcode().string().c_str(), particle.type().charge());
+    consumer_->at_crossing(ICParticle(particle));
   }
 
   if (IC_proper_time_ < 0.0) {
@@ -10,6 +10,7 @@
 #ifndef SRC_INCLUDE_SMASH_ACTION_H_
 #define SRC_INCLUDE_SMASH_ACTION_H_
 
+#include <iterator>
 #include <stdexcept>
 #include <utility>
 #include <vector>
@@ -150,6 +151,9 @@ class Action {
   /**
    * Add several new subprocesses at once.
    *
+   * If there are no subprocesses yet, the list \p pv is taken over instead
+   * of moving its branches into a new list.
+   *
    * \param[in] pv processes list to be added
    * \param[out] subprocesses processes, where pv are added to
    * \param[out] total_weight summed weights of all the subprocesses
@@ -158,13 +162,26 @@ class Action {
   void add_processes(ProcessBranchList<Branch> pv,
                      ProcessBranchList<Branch> &subprocesses,
                      double &total_weight) {
-    subprocesses.reserve(subprocesses.size() + pv.size());
-    for (auto &proc : pv) {
-      if (proc->weight() > 0) {
-        total_weight += proc->weight();
-        subprocesses.emplace_back(std::move(proc));
+    const std::size_t n_old = subprocesses.size();
+    if (n_old == 0) {
+      subprocesses.swap(pv);
+    } else {
+      subprocesses.insert(subprocesses.end(),
+                          std::make_move_iterator(pv.begin()),
+                          std::make_move_iterator(pv.end()));
+    }
+    // Drop the new processes without weight
+    auto kept = subprocesses.begin() + n_old;
+    for (auto proc = kept; proc != subprocesses.end(); ++proc) {
+      if ((*proc)->weight() > 0) {
+        total_weight += (*proc)->weight();
+        if (proc != kept) {
+          *kept = std::move(*proc);
+        }
+        ++kept;
       }
     }
+    subprocesses.erase(kept, subprocesses.end());
   }
 
   /**
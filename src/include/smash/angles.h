@@ -77,8 +77,10 @@ class Angles {
    *
    * the direction is taken randomly from a homogeneous distribution,
    * i.e., each point on a unit sphere is equally likely.
+   *
+   * \param[in,out] rng Random number engine; the common engine by default
    */
-  void distribute_isotropically();
+  void distribute_isotropically(random::Engine &rng = random::engine);
   /**
    * Sets the azimuthal angle.
    *
@@ -185,10 +187,10 @@ inline std::ostream &operator<<(std::ostream &out, const Angles &a) {
   return out << "φ:" << field << a.phi() << ", cos ϑ:" << field << a.costheta();
 }
 
-void inline Angles::distribute_isotropically() {
+void inline Angles::distribute_isotropically(random::Engine &rng) {
   /* Isotropic distribution: phi in [0, 2pi) and cos(theta) in [-1,1]. */
-  phi_ = random::uniform(0.0, twopi);
-  costheta_ = random::uniform(-1.0, 1.0);
+  phi_ = random::uniform(0.0, twopi, rng);
+  costheta_ = random::uniform(-1.0, 1.0, rng);
 }
 
 void inline Angles::set_phi(const double newphi) {
@@ -0,0 +1,97 @@
+/*
+ *
+ *    Copyright (c) 2020 -
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_BATCHSAMPLING_H_
+#define SRC_INCLUDE_SMASH_BATCHSAMPLING_H_
+
+#include <cstddef>
+#include <functional>
+
+#include "particledata.h"
+#include "particles.h"
+#include "random.h"
+
+namespace smash {
+
+/**
+ * Consecutive particles of one species, which are sampled with their own
+ * random number stream.
+ *
+ * The batch does not own the particles, it only points into the list of
+ * particles built by sample_in_batches().
+ */
+class ParticleBatch {
+ public:
+  /**
+   * Construct a batch from a range of particle pointers.
+   *
+   * \param[in] first Pointer to the first particle of the batch
+   * \param[in] last Pointer past the last particle of the batch
+   */
+  ParticleBatch(ParticleData *const *first, ParticleData *const *last)
+      : first_(first), last_(last) {}
+
+  /// \return Type of all particles in the batch
+  const ParticleType &type() const { return (*first_)->type(); }
+
+  /// \return Number of particles in the batch
+  std::size_t size() const { return last_ - first_; }
+
+  /// \return Particle \p i of the batch
+  ParticleData &operator[](std::size_t i) const { return *first_[i]; }
+
+ private:
+  /// Pointer to the first particle of the batch
+  ParticleData *const *first_;
+  /// Pointer past the last particle of the batch
+  ParticleData *const *last_;
+};
+
+/// Maximal number of particles that share one random number stream.
+constexpr std::size_t max_particle_batch_size = 4096;
+
+/**
+ * Sample properties of all particles in batches of at most
+ * max_particle_batch_size consecutive particles of the same species.
+ *
+ * Every batch gets its own random number engine. The seeds of the engines
+ * are drawn from random::engine before any batch is sampled, so afterwards
+ * random::engine is in the same state regardless of the number of threads.
+ * Therefore, the sampled particles only depend on the seed and not on the
+ * number of threads.
+ *
+ * With more than one thread, \p sample is called concurrently for different
+ * batches. It must then only modify its own batch, only draw random numbers
+ * from the engine it is given and not log anything. The lazily initialized
+ * properties of the particle types and their decays are initialized before
+ * with ParticleType::tabulate_spectral_functions. Any other lazily
+ * initialized shared state has to be initialized on the calling thread
+ * before.
+ *
+ * \param[in] particles Particles to be sampled
+ * \param[in] n_threads Number of threads sampling the batches; the batches
+ *            are sampled on the calling thread for 1 or less
+ * \param[in] sample Function that samples all particles of one batch with
+ *            the given random number engine.
+ */
+void sample_in_batches(
+    Particles *particles, int n_threads,
+    const std::function<void(const ParticleBatch &, random::Engine &)>
+        &sample);
+
+/**
+ * \return Whether sample_in_batches() is currently sampling on several
+ *         threads. Lazily initialized shared state must not be initialized
+ *         then, which is asserted where it is initialized.
+ */
+bool sampling_in_batches_concurrently();
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_BATCHSAMPLING_H_
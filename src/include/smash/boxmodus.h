@@ -84,17 +84,43 @@ class BoxModus : public ModusDefault {
    * In BoxModus if a particle crosses the wall of the box, it is
    * inserted from the opposite side. However these wall crossings are not
    * performed by this function but in the Experiment constructor when the
-   * WallCrossActionsFinder are created. Wall crossings are written to
+   * WallCrossActionsFinder are created (or by wrap_wall_crossings if
+   * Inline_Wall_Crossing is set). Wall crossings are written to
    * collision output: this is where OutputsList is used.
    */
   int impose_boundary_conditions(Particles *particles,
                                  const OutputsList &output_list = {});
 
-  /// \copydoc smash::ModusDefault::create_grid
+  /**
+   * Moves all particles that left the box during the last propagation back
+   * into it, replacing the WallcrossingAction objects otherwise created by
+   * the WallCrossActionsFinder.
+   *
+   * A particle that crossed several walls is wrapped once per crossing, in
+   * the order of the crossings. The positions are the same as after
+   * performing the corresponding WallcrossingAction objects.
+   *
+   * \param[in,out] particles Particles that were just propagated
+   * \param[out] crossings If not null, a WallcrossingAction with the same
+   *             incoming and outgoing particles as the one of the
+   *             WallCrossActionsFinder is appended for every crossing. The
+   *             appended actions are sorted by the time of the crossing. They
+   *             are not performed, but only used for the output.
+   * \return The number of wall crossings
+   */
+  int wrap_wall_crossings(Particles *particles,
+                          ActionList *crossings = nullptr);
+
+  /**
+   * \copydoc smash::ModusDefault::create_grid
+   *
+   * The grid always covers the box, so there is no skin.
+   */
   Grid<GridOptions::PeriodicBoundaries> create_grid(
       const Particles &particles, double min_cell_length,
       double timestep_duration,
-      CellSizeStrategy strategy = CellSizeStrategy::Optimal) const {
+      CellSizeStrategy strategy = CellSizeStrategy::Optimal,
+      double /* skin */ = 0.) const {
     return {{{0, 0, 0}, {length_, length_, length_}},
             particles,
             min_cell_length,
@@ -102,6 +128,9 @@ class BoxModus : public ModusDefault {
             strategy};
   }
 
+  /// \copydoc smash::ModusDefault::GridType
+  using GridType = Grid<GridOptions::PeriodicBoundaries>;
+
   /**
    * Creates GrandCanThermalizer. (Special Box implementation.)
    *
@@ -126,6 +155,8 @@ class BoxModus : public ModusDefault {
   double equilibration_time() const { return equilibration_time_; }
   /// \return whether the modus is box (also, trivially true)
   bool is_box() const { return true; }
+  /// \return whether wall crossings are applied during propagation
+  bool inline_wall_crossing() const { return inline_wall_crossing_; }
 
  private:
   /// Initial momenta distribution: thermal or peaked momenta
@@ -189,6 +220,13 @@ class BoxModus : public ModusDefault {
    * Initial momentum of the jet particle; only used if insert_jet_ is true
    */
   const double jet_mom_;
+  /**
+   * Whether particles are wrapped into the box right after propagation
+   * instead of by wall-crossing actions
+   */
+  const bool inline_wall_crossing_;
+  /// Number of threads used to sample the initial momenta and positions
+  const int sampling_threads_;
 
   /**
    * \ingroup logging
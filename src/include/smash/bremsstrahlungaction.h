@@ -15,6 +15,9 @@
 #include "scatteraction.h"
 
 namespace smash {
+
+class InterpolateData2DSpline;
+
 /**
  * \ingroup action
  * BremsAction is a special action which takes two incoming particles
@@ -167,6 +170,49 @@ class BremsstrahlungAction : public ScatterAction {
   /// Sampled value of theta (angle of the photon)
   double theta_;
 
+  /**
+   * Kinematics, interpolation tables and weight normalization of the
+   * bremsstrahlung final state that are the same for all fractional photons
+   * of one hadronic scattering.
+   */
+  struct FinalStateSetup {
+    /// Interaction point, where the outgoing particles are placed
+    FourVector interaction_point;
+    /// Center-of-mass energy [GeV]
+    double sqrts;
+    /// Lower cutoff of the sampled photon momentum [GeV]
+    double k_min;
+    /// Upper limit of the sampled photon momentum [GeV]
+    double k_max;
+    /// Velocity of the center-of-mass frame of the outgoing particles
+    ThreeVector beta_cm;
+    /// dSigma/dk interpolation of the selected channel
+    const InterpolateData2DSpline *dsigma_dk;
+    /// dSigma/dtheta interpolation of the selected channel
+    const InterpolateData2DSpline *dsigma_dtheta;
+    /// Number of fractional photons times the hadronic cross section [mb]
+    double weight_norm;
+    /// Product of the cross section scaling factors of the incoming particles
+    double xsec_scaling;
+  };
+
+  /**
+   * Select the bremsstrahlung channel, set up the outgoing particles and
+   * compute the quantities shared by all fractional photons of this
+   * scattering. No random numbers are drawn here.
+   *
+   * \return Kinematics for sample_final_state()
+   */
+  FinalStateSetup setup_final_state();
+
+  /**
+   * Sample one photon and two pions and the photon weight for the given
+   * per-scattering setup.
+   *
+   * \param[in] setup Result of setup_final_state() for this action
+   */
+  void sample_final_state(const FinalStateSetup &setup);
+
   /**
    * Create interpolation objects for tabularized cross sections:
    * total cross section, differential dSigma/dk, differential dSigma/dtheta
@@ -184,10 +230,13 @@ class BremsstrahlungAction : public ScatterAction {
    * Computes the differential cross sections dSigma/dk and dSigma/dtheta of the
    * bremsstrahlung process.
    *
+   * \param[in] setup Per-scattering setup holding the interpolations of the
+   *                  selected channel
    * \returns Pair containing dSigma/dk as a first argument and dSigma/dtheta
    *          as a second argument
    */
-  std::pair<double, double> brems_diff_cross_sections();
+  std::pair<double, double> brems_diff_cross_sections(
+      const FinalStateSetup &setup) const;
 };
 
 }  // namespace smash
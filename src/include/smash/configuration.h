@@ -1004,6 +1004,26 @@ class Configuration {
           "\"Geometric\", \"Stochastic\" " + "or \"Covariant\".");
     }
 
+    /**
+     * Set the lattice smearing mode from configuration values.
+     *
+     * \return SmearingMode.
+     * \throw IncorrectTypeInAssignment in case a smearing mode that is
+     * not available is provided as a configuration value.
+     */
+    operator SmearingMode() const {
+      const std::string s = operator std::string();
+      if (s == "Covariant") {
+        return SmearingMode::Covariant;
+      }
+      if (s == "Separable") {
+        return SmearingMode::Separable;
+      }
+      throw IncorrectTypeInAssignment("The value for key \"" +
+                                      std::string(key_) + "\" should be " +
+                                      "\"Covariant\" or \"Separable\".");
+    }
+
     /**
      * Set OutputOnlyFinal for particles output from configuration values.
      *
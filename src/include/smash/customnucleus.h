@@ -84,7 +84,20 @@ class CustomNucleus : public Nucleus {
    */
   void generate_fermi_momenta() override;
 
+ protected:
+  /**
+   * Write the contents of the external file to a stream, which determine the
+   * nucleon positions of a configuration library. Thus a library file is not
+   * reused after the external file was changed.
+   *
+   * \param[out] out Stream to which the parameters are written.
+   * \throw runtime_error if the external file cannot be read.
+   */
+  void write_library_parameters(std::ostream& out) const override;
+
  private:
+  /// Path of the external file with the nucleon configurations
+  std::string file_path_;
   /**
    * Filestream variable used if projectile and target are read in from the
    * same file and they use the same static stream.
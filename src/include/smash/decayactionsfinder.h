@@ -10,12 +10,54 @@
 #ifndef SRC_INCLUDE_SMASH_DECAYACTIONSFINDER_H_
 #define SRC_INCLUDE_SMASH_DECAYACTIONSFINDER_H_
 
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
 #include <vector>
 
 #include "actionfinderfactory.h"
+#include "fourvector.h"
 
 namespace smash {
 
+/**
+ * \ingroup action
+ * Decay times of resonances, which are sampled once and kept until the
+ * resonance decays or its state changes.
+ */
+struct DecaySchedule {
+  /// A decay time sampled for a resonance
+  struct Entry {
+    /// Process id of the resonance when the decay time was sampled
+    uint32_t id_process;
+    /// Momentum of the resonance when the decay time was sampled
+    FourVector momentum;
+    /// Time of the decay in the computational frame [fm]
+    double decay_time;
+    /// Time at which the entry was used the last time [fm]
+    double last_used;
+  };
+
+  /// Scheduled decays, identified by the particle id
+  std::unordered_map<int32_t, Entry> entries;
+
+  /// Size of the schedule at which unused entries are removed
+  std::size_t purge_size = 1000;
+
+  /// Time of the current timestep [fm]
+  double current_time = -std::numeric_limits<double>::infinity();
+
+  /// Time of the previous timestep [fm]
+  double previous_time = -std::numeric_limits<double>::infinity();
+
+  /// Remove all entries, e.g. at the beginning of an event.
+  void clear() {
+    entries.clear();
+    current_time = -std::numeric_limits<double>::infinity();
+    previous_time = -std::numeric_limits<double>::infinity();
+  }
+};
+
 /**
  * \ingroup action
  * A simple decay finder:
@@ -29,13 +71,26 @@ class DecayActionsFinder : public ActionFinderInterface {
    *
    * \param[in] res_lifetime_factor The multiplicative factor to be applied to
    *                                resonance lifetimes; default is 1
+   * \param[in] decay_schedule Schedule for keeping the decay times across
+   *                           timesteps. If this is a null pointer, the decay
+   *                           times are sampled in every timestep.
    */
-  explicit DecayActionsFinder(double res_lifetime_factor)
-      : res_lifetime_factor_(res_lifetime_factor) {}
+  explicit DecayActionsFinder(double res_lifetime_factor,
+                              DecaySchedule *decay_schedule = nullptr)
+      : res_lifetime_factor_(res_lifetime_factor),
+        decay_schedule_(decay_schedule) {}
 
   /**
    * Check the whole particle list for decays.
    *
+   * If a decay schedule is given, the decay time of a resonance is sampled
+   * only once and stored in the schedule. It is sampled again only if the
+   * momentum or the process id of the resonance changed, because then the
+   * (mass-dependent) width might be different. Due to the exponential decay
+   * law, this results in the same decay statistics as sampling in every
+   * timestep, but the partial widths have to be computed only when a decay
+   * time is sampled and when the resonance decays.
+   *
    * \param[in] search_list All particles in grid cell.
    * \param[in] dt Size of timestep [fm]
    * \return List with the found (Decay)Action objects.
@@ -72,6 +127,16 @@ class DecayActionsFinder : public ActionFinderInterface {
 
   /// Multiplicative factor to be applied to resonance lifetimes
   const double res_lifetime_factor_ = 1.;
+
+ private:
+  /**
+   * Remove the entries of the decay schedule that were used neither in the
+   * current nor in the previous timestep.
+   */
+  void purge_decay_schedule() const;
+
+  /// Schedule of the decay times (not owned), or null
+  DecaySchedule *decay_schedule_ = nullptr;
 };
 
 }  // namespace smash
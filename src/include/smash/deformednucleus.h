@@ -8,11 +8,13 @@
 #define SRC_INCLUDE_SMASH_DEFORMEDNUCLEUS_H_
 
 #include <map>
+#include <vector>
 
 #include "angles.h"
 #include "configuration.h"
 #include "forwarddeclarations.h"
 #include "nucleus.h"
+#include "random.h"
 #include "threevector.h"
 
 namespace smash {
@@ -55,11 +57,28 @@ class DeformedNucleus : public Nucleus {
   /**
    * Deformed Woods-Saxon sampling routine.
    *
+   * The polar angle is sampled in bins of \f$\cos\theta\f$, each weighted
+   * with the integral of a spherical Woods-Saxon distribution with the largest
+   * deformed radius in the bin. The radius is then sampled from that
+   * spherical distribution and accepted with the ratio of the deformed to
+   * the spherical Woods-Saxon density. The tables for this are created once
+   * for every set of nucleus parameters, and the acceptance is close to
+   * unity. The distribution is the same as for rejection sampling of
+   * uniform points in a sphere of radius \f$R/d + R d\f$.
+   *
    * \return Spatial position from uniformly sampling
    * the deformed woods-saxon distribution
    */
   ThreeVector distribute_nucleon() override;
 
+  /**
+   * Deformed radius of the nucleus in a given direction.
+   *
+   * \param[in] cosx The cosine of the polar angle
+   * \return \f$R (1 + \beta_2 Y_2^0 + \beta_4 Y_4^0)\f$
+   */
+  double deformed_radius(double cosx) const;
+
   /**
    * Sets the deformation parameters of the radius according to the current
    * mass number.
@@ -136,6 +155,25 @@ class DeformedNucleus : public Nucleus {
    */
   inline double get_beta4() { return beta4_; }
 
+ protected:
+  /**
+   * Rotate a position of a drawn library configuration about the symmetry
+   * axis of the deformed nucleus. The orientation of that axis is set
+   * afterwards by rotate().
+   *
+   * \param[inout] position Position that is rotated.
+   */
+  void rotate_library_configuration(ThreeVector &position) const override {
+    position.rotate_around_z(euler_phi_);
+  }
+
+  /**
+   * Write the Woods-Saxon and deformation parameters to a stream.
+   *
+   * \param[out] out Stream to which the parameters are written.
+   */
+  void write_library_parameters(std::ostream &out) const override;
+
  private:
   /// Deformation parameter for angular momentum l=2.
   double beta2_ = 0.0;
@@ -150,6 +188,22 @@ class DeformedNucleus : public Nucleus {
    * Whether the nuclei should be rotated randomly.
    */
   bool random_rotation_ = false;
+
+  /**
+   * Create the \f$\cos\theta\f$ tables for distribute_nucleon for the
+   * current nucleus parameters.
+   */
+  void tabulate_sampling_envelope();
+
+  /**
+   * Nucleus parameters (radius, diffusiveness, beta2, beta4) for which the
+   * sampling envelope was tabulated.
+   */
+  std::vector<double> envelope_parameters_;
+  /// Largest deformed radius in each \f$\cos\theta\f$ bin.
+  std::vector<double> envelope_radius_;
+  /// Distribution of the \f$\cos\theta\f$ bins.
+  random::discrete_dist<double> envelope_bins_;
 };
 
 }  // namespace smash
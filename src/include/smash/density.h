@@ -112,13 +112,14 @@ class DensityParameters {
    *
    * \param[in] par Struct containing the Gaussian smearing width
    *             \f$\sigma\f$, the cutoff factor \f$a\f$ where the
-   *             cutoff radius \f$r_{\rm cut}=a\sigma\f$, and the
-   *             test-particle number.
+   *             cutoff radius \f$r_{\rm cut}=a\sigma\f$, the
+   *             test-particle number and the lattice smearing mode.
    */
   DensityParameters(const ExperimentParameters &par)  // NOLINT
       : sig_(par.gaussian_sigma),
         r_cut_(par.gauss_cutoff_in_sigma * par.gaussian_sigma),
-        ntest_(par.testparticles) {
+        ntest_(par.testparticles),
+        smearing_mode_(par.smearing_mode) {
     r_cut_sqr_ = r_cut_ * r_cut_;
     const double two_sig_sqr = 2 * sig_ * sig_;
     two_sig_sqr_inv_ = 1. / two_sig_sqr;
@@ -129,6 +130,8 @@ class DensityParameters {
   }
   /// \return Testparticle number
   int ntest() const { return ntest_; }
+  /// \return Gaussian smearing width [fm]
+  double sigma() const { return sig_; }
   /// \return Cut-off radius [fm]
   double r_cut() const { return r_cut_; }
   /// \return Squared cut-off radius [fm\f$^2\f$]
@@ -141,6 +144,8 @@ class DensityParameters {
    *         \f$ \int d^3r \, sf(\vec{r}) = 1 \f$.
    */
   double norm_factor_sf() const { return norm_factor_sf_; }
+  /// \return How densities are smeared onto the lattice
+  SmearingMode smearing_mode() const { return smearing_mode_; }
 
  private:
   /// Gaussian smearing width [fm]
@@ -155,6 +160,8 @@ class DensityParameters {
   double norm_factor_sf_;
   /// Testparticle number
   const int ntest_;
+  /// How densities are smeared onto the lattice
+  const SmearingMode smearing_mode_;
 };
 
 /**
@@ -234,6 +241,63 @@ current_eckart(const ThreeVector &r, const Particles &plist,
                const DensityParameters &par, DensityType dens_type,
                bool compute_gradient, bool smearing);
 
+/**
+ * Thermodynamic quantities at one point, as computed by probe_thermodynamics.
+ */
+struct ThermodynamicProbe {
+  /// Eckart density of the probed density type [fm\f$^{-3}\f$]
+  double rho_eckart = 0.;
+  /**
+   * Energy-momentum tensor of the particles weighted with their factors
+   * for the probed density type
+   */
+  EnergyMomentumTensor Tmn;
+  /// Electric current (not normalized, like the current of current_eckart)
+  FourVector jQ;
+  /// Baryonic current (not normalized, like the current of current_eckart)
+  FourVector jB;
+  /// Strange current (not normalized, like the current of current_eckart)
+  FourVector jS;
+};
+
+/**
+ * Calculates several thermodynamic quantities at many points in a single
+ * pass over the particles. For every particle the smearing factor is
+ * computed only once per point and shared by all requested quantities,
+ * and particles farther than the cutoff radius from a point are skipped
+ * early. The results are the same as from separate calls of current_eckart
+ * (for the Eckart density and the currents) and from summing up the
+ * energy-momentum tensor of the smeared particles.
+ *
+ * \param[in] points Points where the quantities are calculated [fm];
+ *            ignored if smearing is false
+ * \param[in] plist Particles contributing to the quantities
+ * \param[in] par Parameters for the smearing
+ * \param[in] dens_type Density type for the Eckart density and the
+ *            energy-momentum tensor
+ * \param[in] smearing Whether to use gaussian smearing, see current_eckart
+ * \param[in] compute_rho Whether to compute the Eckart density
+ * \param[in] compute_tmn Whether to compute the energy-momentum tensor
+ * \param[in] compute_jQBS Whether to compute the electric, baryonic and
+ *            strange currents
+ * \return Quantities at each of the points. The ones that were not requested
+ *         are zero.
+ */
+std::vector<ThermodynamicProbe> probe_thermodynamics(
+    const std::vector<ThreeVector> &points, const ParticleList &plist,
+    const DensityParameters &par, DensityType dens_type, bool smearing,
+    bool compute_rho, bool compute_tmn, bool compute_jQBS);
+/// convenience overload of the above (ParticleList -> Particles)
+std::vector<ThermodynamicProbe> probe_thermodynamics(
+    const std::vector<ThreeVector> &points, const Particles &plist,
+    const DensityParameters &par, DensityType dens_type, bool smearing,
+    bool compute_rho, bool compute_tmn, bool compute_jQBS);
+/// convenience overload of the above (ParticleList -> Particles::Snapshot)
+std::vector<ThermodynamicProbe> probe_thermodynamics(
+    const std::vector<ThreeVector> &points, const Particles::Snapshot &plist,
+    const DensityParameters &par, DensityType dens_type, bool smearing,
+    bool compute_rho, bool compute_tmn, bool compute_jQBS);
+
 /**
  * A class for time-efficient (time-memory trade-off) calculation of density
  * on the lattice. It holds six FourVectors - positive and negative
@@ -263,6 +327,20 @@ class DensityOnLattice {
         jmu_neg_(FourVector()),
         djmu_dx_({FourVector(), FourVector(), FourVector(), FourVector()}) {}
 
+  /**
+   * Constructor from currents that are already smeared.
+   *
+   * \param[in] jmu_pos Four-current density of the positively charged
+   *            particles.
+   * \param[in] jmu_neg Four-current density of the negatively charged
+   *            particles.
+   * \param[in] djmu_dx Derivatives \f$\partial_\nu j^\mu \f$ of the net
+   *            current.
+   */
+  DensityOnLattice(const FourVector &jmu_pos, const FourVector &jmu_neg,
+                   const std::array<FourVector, 4> &djmu_dx)
+      : jmu_pos_(jmu_pos), jmu_neg_(jmu_neg), djmu_dx_(djmu_dx) {}
+
   /**
    * Adds particle to 4-current: \f$j^{\mu} += p^{\mu}/p^0 \cdot factor \f$.
    * Two private class members jmu_pos_ and jmu_neg_ indicating the 4-current
@@ -439,6 +517,38 @@ void update_lattice(RectangularLattice<T> *lat, const LatticeUpdate update,
   }
 }
 
+/**
+ * Updates the densities on the lattice with the smearing mode given in \p par.
+ *
+ * For SmearingMode::Covariant this is the same as the generic update_lattice.
+ * For SmearingMode::Separable the particles are first assigned to the 8
+ * surrounding nodes with cloud-in-cell weights. The resulting currents are
+ * then convolved with a Gaussian, which is cut at \f$r_{\rm cut}\f$ and
+ * normalized on the lattice, along x, y and z one after another. The
+ * gradients are obtained by replacing the Gaussian with its derivative along
+ * the respective direction. This takes
+ * \f$O(N + N_{\rm nodes} \cdot r_{\rm cut}/\Delta x)\f$ instead of
+ * \f$O(N (r_{\rm cut}/\Delta x)^3)\f$ operations. The Lorentz contraction of
+ * the Gaussians is neglected, only the factor \f$\gamma\f$ of the
+ * covariant smearing is kept. The cloud-in-cell assignment widens the
+ * smearing by a variance of \f$\Delta x^2/6\f$, which is subtracted from
+ * \f$\sigma^2\f$.
+ *
+ * \param[out] lat The lattice on which the densities will be updated
+ * \param[in] update tells if called for update at printout or at timestep
+ * \param[in] dens_type density type to be computed on the lattice
+ * \param[in] par a structure containing testparticles number, gaussian
+ *            smearing parameters and the smearing mode.
+ * \param[in] particles the particles vector
+ * \param[in] compute_gradient Whether to compute the gradients
+ * \throw std::invalid_argument if the separable smearing is used with lattice
+ *        cells larger than \f$\sqrt{6}\sigma\f$
+ */
+void update_lattice(DensityLattice *lat, const LatticeUpdate update,
+                    const DensityType dens_type, const DensityParameters &par,
+                    const Particles &particles,
+                    const bool compute_gradient = false);
+
 }  // namespace smash
 
 #endif  // SRC_INCLUDE_SMASH_DENSITY_H_
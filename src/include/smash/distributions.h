@@ -7,6 +7,8 @@
 #ifndef SRC_INCLUDE_SMASH_DISTRIBUTIONS_H_
 #define SRC_INCLUDE_SMASH_DISTRIBUTIONS_H_
 
+#include "random.h"
+
 namespace smash {
 
 /**
@@ -128,6 +130,17 @@ double juttner_distribution_func(double momentum_radial, double mass,
  */
 double sample_momenta_non_eq_mass(const double temperature, const double mass);
 
+/**
+ * \copydoc sample_momenta_non_eq_mass(double, double)
+ *
+ * Same as above, but the random numbers are drawn from \p rng and nothing is
+ * logged, so that it can be used on other threads than the main thread.
+ *
+ * \param[in,out] rng Random number engine
+ */
+double sample_momenta_non_eq_mass(const double temperature, const double mass,
+                                  random::Engine &rng);
+
 /**
  * Samples a momentum from the non-equilibrium distribution
  * 1M_IC from \iref{Bazow:2016oky}
@@ -140,6 +153,17 @@ double sample_momenta_non_eq_mass(const double temperature, const double mass);
  */
 double sample_momenta_1M_IC(const double temperature, const double mass);
 
+/**
+ * \copydoc sample_momenta_1M_IC(double, double)
+ *
+ * Same as above, but the random numbers are drawn from \p rng and nothing is
+ * logged, so that it can be used on other threads than the main thread.
+ *
+ * \param[in,out] rng Random number engine
+ */
+double sample_momenta_1M_IC(const double temperature, const double mass,
+                            random::Engine &rng);
+
 /**
  * Samples a momentum from the non-equilibrium distribution
  * 2M_IC from \iref{Bazow:2016oky}
@@ -152,6 +176,17 @@ double sample_momenta_1M_IC(const double temperature, const double mass);
  */
 double sample_momenta_2M_IC(const double temperature, const double mass);
 
+/**
+ * \copydoc sample_momenta_2M_IC(double, double)
+ *
+ * Same as above, but the random numbers are drawn from \p rng and nothing is
+ * logged, so that it can be used on other threads than the main thread.
+ *
+ * \param[in,out] rng Random number engine
+ */
+double sample_momenta_2M_IC(const double temperature, const double mass,
+                            random::Engine &rng);
+
 /**
  * Samples a momentum from the Maxwell-Boltzmann (thermal) distribution
  * in a faster way, given by Scott Pratt (see \iref{Pratt:2014vja})
@@ -176,14 +211,27 @@ double sample_momenta_2M_IC(const double temperature, const double mass);
  */
 double sample_momenta_from_thermal(const double temperature, const double mass);
 
+/**
+ * \copydoc sample_momenta_from_thermal(double, double)
+ *
+ * Same as above, but the random numbers are drawn from \p rng and nothing is
+ * logged, so that it can be used on other threads than the main thread.
+ *
+ * \param[in,out] rng Random number engine
+ */
+double sample_momenta_from_thermal(const double temperature, const double mass,
+                                   random::Engine &rng);
+
 /**
  * Sample momenta according to the momentum distribution
  * in \iref{Bazow:2016oky}
  *
  * \param[in] temperature The temperature for the distribution [GeV]
+ * \param[in,out] rng Random number engine; the common engine by default
  * \return Radial momentum
  */
-double sample_momenta_IC_ES(const double temperature);
+double sample_momenta_IC_ES(const double temperature,
+                            random::Engine &rng = random::engine);
 }  // namespace smash
 
 #endif  // SRC_INCLUDE_SMASH_DISTRIBUTIONS_H_
@@ -221,6 +221,41 @@ class Experiment : public ExperimentBase {
    */
   void final_output(const int evt_num);
 
+  /**
+   * Runs a single event: initializes it, evolves it in time, performs the
+   * final decays if requested and writes the output at the event end.
+   * Afterwards, the final particles are available via particles().
+   *
+   * Together with ListModus::set_next_event this allows to use SMASH as an
+   * afterburner without any files: construct an Experiment<ListModus> once
+   * and, for every event, hand over the initial particles and call this
+   * function.
+   *
+   * \param[in] event_number Number of the event
+   */
+  void run_event(int event_number);
+
+  /**
+   * Passes the initial conditions for hydrodynamics to \p consumer in every
+   * following event, in addition to the configured outputs. This allows a
+   * hydrodynamic code linked to SMASH to receive the particles on the
+   * hypersurface without any files.
+   *
+   * \param[in] consumer Receiver of the particles on the hypersurface
+   * \throw runtime_error if the initial conditions are not enabled in the
+   *                      Output section of the configuration; an empty
+   *                      Format list is sufficient
+   */
+  void add_initial_conditions_consumer(std::shared_ptr<ICConsumer> consumer) {
+    if (!IC_output_switch_) {
+      throw std::runtime_error(
+          "Initial conditions consumer requires the Initial_Conditions "
+          "output section.");
+    }
+    outputs_.emplace_back(make_unique<ICOutput>("SMASH_IC", OutputParameters(),
+                                                std::move(consumer)));
+  }
+
   /**
    * Provides external access to SMASH particles. This is helpful if SMASH
    * is used as a 3rd-party library.
@@ -353,6 +388,17 @@ class Experiment : public ExperimentBase {
    * the ColliderModus, so is set as an empty vector by default.
    */
   std::vector<bool> nucleon_has_interacted_ = {};
+
+  /**
+   * Decay times of the resonances, if they are sampled only once
+   * (see DecayActionsFinder).
+   */
+  DecaySchedule decay_schedule_;
+  /**
+   * Times at which the particles cross the hypersurface of the IC output
+   * (see HyperSurfaceCrossActionsFinder).
+   */
+  HyperSurfaceCrossingSchedule crossing_schedule_;
   /**
    * Whether the projectile and the target collided.
    */
@@ -474,6 +520,22 @@ class Experiment : public ExperimentBase {
   /// This indicates whether to use the grid.
   const bool use_grid_;
 
+  /// Distance by which the grid extends beyond the particles [fm]
+  const double grid_skin_;
+
+  /**
+   * Grid for finding actions, which is kept across timesteps as long as it
+   * can be updated (see Grid::update).
+   */
+  std::unique_ptr<typename Modus::GridType> grid_;
+
+  /**
+   * Number of time steps after which the particles are reordered along a
+   * space-filling curve (see Particles::reorder_spatially). Zero disables the
+   * reordering.
+   */
+  const int reorder_interval_;
+
   /// This struct contains information on the metric to be used
   const ExpansionProperties metric_;
 
@@ -594,6 +656,9 @@ void Experiment<Modus>::create_output(const std::string &format,
   if (format == "VTK" && content == "Particles") {
     outputs_.emplace_back(
         make_unique<VtkOutput>(output_path, content, out_par));
+  } else if (format == "VTK_XML" && content == "Particles") {
+    outputs_.emplace_back(make_unique<VtkOutput>(output_path, content, out_par,
+                                                 VtkFormat::XmlBinary));
   } else if (format == "Root") {
 #ifdef SMASH_USE_ROOT
     if (content == "Initial_Conditions") {
@@ -629,9 +694,16 @@ void Experiment<Modus>::create_output(const std::string &format,
     printout_lattice_td_ = true;
     outputs_.emplace_back(
         make_unique<VtkOutput>(output_path, content, out_par));
+  } else if (content == "Thermodynamics" && format == "VTK_XML") {
+    printout_lattice_td_ = true;
+    outputs_.emplace_back(make_unique<VtkOutput>(output_path, content, out_par,
+                                                 VtkFormat::XmlBinary));
   } else if (content == "Initial_Conditions" && format == "ASCII") {
     outputs_.emplace_back(
         make_unique<ICOutput>(output_path, "SMASH_IC", out_par));
+  } else if (content == "Initial_Conditions" && format == "Compact_Binary") {
+    outputs_.emplace_back(make_unique<ICOutput>(
+        output_path, "SMASH_IC", out_par, ICFormat::CompactBinary));
   } else if (content == "HepMC" && format == "ASCII") {
 #ifdef SMASH_USE_HEPMC
     outputs_.emplace_back(make_unique<HepMcOutput>(
@@ -674,6 +746,25 @@ ExperimentParameters create_experiment_parameters(Configuration config);
  * \li \key true - A grid is used to reduce the combinatorics of interaction
  * lookup \n \li \key false - No grid is used.
  *
+ * \key Grid_Skin (double, optional, default = 1.0): \n
+ * Distance in fm by which the grid extends beyond the particles when it is
+ * created. The grid is reused in the following time steps, where only the
+ * particles are reassigned to the cells, until a particle leaves it, the
+ * number of particles changes by more than half or the cells become too
+ * small. A larger skin means fewer reconstructions of the grid, but more
+ * empty cells. With the stochastic collision criterion the grid is created
+ * anew in every time step, because the cell volume enters the collision
+ * probabilities.
+ *
+ * \key Particle_Reordering_Interval (int, optional, default = 0): \n
+ * Number of time steps after which the particles are sorted in memory along
+ * a space-filling (Morton) curve of their positions, such that particles
+ * close in space are also close in memory. This improves the cache locality
+ * of the action search for large systems. The sorting does not change the
+ * physics, but since the order of the particles changes, so does the
+ * sequence of random numbers drawn for them. A value of 0 disables the
+ * reordering.
+ *
  * \key Time_Step_Mode (string, optional, default = Fixed): \n
  * The mode of time stepping. Possible values: \n
  * \li \key None - Delta_Time is set to the End_Time.  Cannot be used with
@@ -753,6 +844,14 @@ ExperimentParameters create_experiment_parameters(Configuration config);
  * \li \key true - Force all resonances to decay after last timestep \n
  * \li \key false - Don't force decays (final output can contain resonances)
  *
+ * \key Persistent_Decay_Times (bool, optional, default = false): \n
+ * \li \key true - The decay time of a resonance is sampled once and kept
+ * until it decays, unless its momentum changes in an interaction. This
+ * avoids computing the decay widths of all resonances in every timestep.
+ * Not used together with potentials, where the widths change with time. \n
+ * \li \key false - The decay times are sampled in every timestep.
+ * Both give the same decay statistics.
+ *
  * \key No_Collisions (bool, optional, default = false) \n
  * Disable all possible collisions, only allow decays to occur
  * if not forbidden by other options. Useful for running SMASH
@@ -830,6 +929,9 @@ Experiment<Modus>::Experiment(Configuration config, const bf::path &output_path)
       force_decays_(
           config.take({"Collision_Term", "Force_Decays_At_End"}, true)),
       use_grid_(config.take({"General", "Use_Grid"}, true)),
+      grid_skin_(config.take({"General", "Grid_Skin"}, 1.)),
+      reorder_interval_(
+          config.take({"General", "Particle_Reordering_Interval"}, 0)),
       metric_(
           config.take({"General", "Metric_Type"}, ExpansionMode::NoExpansion),
           config.take({"General", "Expansion_Rate"}, 0.1)),
@@ -844,6 +946,14 @@ Experiment<Modus>::Experiment(Configuration config, const bf::path &output_path)
           config.take({"General", "Time_Step_Mode"}, TimeStepMode::Fixed)) {
   logg[LExperiment].info() << *this;
 
+  if (grid_skin_ < 0.) {
+    throw std::invalid_argument("The grid skin cannot be negative!");
+  }
+  if (reorder_interval_ < 0) {
+    throw std::invalid_argument(
+        "The particle reordering interval cannot be negative!");
+  }
+
   if (parameters_.coll_crit == CollisionCriterion::Stochastic &&
       time_step_mode_ != TimeStepMode::Fixed) {
     throw std::invalid_argument(
@@ -871,8 +981,18 @@ Experiment<Modus>::Experiment(Configuration config, const bf::path &output_path)
           "inelastically (e.g. resonance chains), else SMASH is known to "
           "hang.");
     }
-    action_finders_.emplace_back(
-        make_unique<DecayActionsFinder>(parameters_.res_lifetime_factor));
+    const bool persistent_decay_times =
+        config.take({"Collision_Term", "Persistent_Decay_Times"}, false);
+    if (persistent_decay_times && config.has_value({"Potentials"})) {
+      logg[LExperiment].warn(
+          "Persistent decay times are not used with potentials, because the "
+          "decay widths change with the potentials in every timestep.");
+    }
+    action_finders_.emplace_back(make_unique<DecayActionsFinder>(
+        parameters_.res_lifetime_factor,
+        persistent_decay_times && !config.has_value({"Potentials"})
+            ? &decay_schedule_
+            : nullptr));
   }
   bool no_coll = config.take({"Collision_Term", "No_Collisions"}, false);
   if ((parameters_.two_to_one || parameters_.included_2to2.any() ||
@@ -884,13 +1004,16 @@ Experiment<Modus>::Experiment(Configuration config, const bf::path &output_path)
     max_transverse_distance_sqr_ =
         scat_finder->max_transverse_distance_sqr(parameters_.testparticles);
     process_string_ptr_ = scat_finder->get_process_string_ptr();
+    /* Without wall-crossing actions, the collisions through the walls have to
+     * be found when the particles are produced. */
+    scat_finder->set_periodic_surroundings(modus_.inline_wall_crossing());
     action_finders_.emplace_back(std::move(scat_finder));
   } else {
     max_transverse_distance_sqr_ =
         parameters_.maximum_cross_section / M_PI * fm2_mb;
     process_string_ptr_ = NULL;
   }
-  if (modus_.is_box()) {
+  if (modus_.is_box() && !modus_.inline_wall_crossing()) {
     action_finders_.emplace_back(
         make_unique<WallCrossActionsFinder>(parameters_.box_length));
   }
@@ -920,7 +1043,8 @@ Experiment<Modus>::Experiment(Configuration config, const bf::path &output_path)
       }
     }
     action_finders_.emplace_back(
-        make_unique<HyperSurfaceCrossActionsFinder>(proper_time));
+        make_unique<HyperSurfaceCrossActionsFinder>(proper_time,
+                                                    &crossing_schedule_));
   }
 
   if (config.has_value({"Collision_Term", "Pauli_Blocking"})) {
@@ -952,6 +1076,7 @@ Experiment<Modus>::Experiment(Configuration config, const bf::path &output_path)
        Randomseed: -1
        Nevents: 20
        Use_Grid: True
+       Grid_Skin: 1.0
        Time_Step_Mode: Fixed
    \endverbatim
    *
@@ -1056,11 +1181,19 @@ Experiment<Modus>::Experiment(Configuration config, const bf::path &output_path)
    *   - This output can be opened by paraview to see the visulalization.
    *   - For "Particles" content \subpage format_vtk
    *   - For "Thermodynamics" content \subpage output_vtk_lattice_
+   * - \b "VTK_XML" - binary XML variant of the VTK output
+   *   - Much smaller and faster to write and to load than the "VTK" output
+   *   - Additionally writes a collection file per event, which contains the
+   *     whole time evolution
+   *   - Available for the same contents as "VTK", see \ref format_vtk and
+   *     \ref output_vtk_lattice_
    * - \b "ASCII" - a human-readable text-format table of values
    *   - Used for "Thermodynamics", "Initial_Conditions" and "HepMC", see
    * \subpage thermodyn_output_user_guide_
    * \subpage IC_output_user_guide_
    * \ref hepmc_output_user_guide_
+   * - \b "Compact_Binary" - binary variant of the "ASCII" initial conditions
+   *   - Only for "Initial_Conditions", see \ref IC_output_user_guide_
    *
    * \note Output of coordinates for the "Collisions" content in
    *       the periodic box has a feature:
@@ -1163,10 +1296,12 @@ Experiment<Modus>::Experiment(Configuration config, const bf::path &output_path)
    * initial conditions are enabled, the output file named SMASH_IC (followed by
    * the appropriate suffix) is generated when SMASH is executed. \n The output
    * is available in Oscar1999, Oscar2013, binary and ROOT format, as well as in
-   * an aditional ASCII format (see \ref IC_output_user_guide_). The latter is
-   * meant to directly serve
+   * an aditional ASCII format and its compact binary variant (see
+   * \ref IC_output_user_guide_). The latter are meant to directly serve
    * as an input for the vHLLE hydrodynamics code (I. Karpenko, P. Huovinen, M.
-   * Bleicher: Comput. Phys. Commun. 185, 3016 (2014)).\n \n
+   * Bleicher: Comput. Phys. Commun. 185, 3016 (2014)). If SMASH is used as a
+   * library, the same particles can also be received in memory with
+   * Experiment::add_initial_conditions_consumer.\n \n
    * ### Oscar output
    * In case
    * of the Oscar1999 and Oscar2013 format, the structure is identical to the
@@ -1270,6 +1405,25 @@ Experiment<Modus>::Experiment(Configuration config, const bf::path &output_path)
    * Include potential effects, since mean field potentials change the threshold
    * energies of the actions.
    *
+   * \key Smearing (string, optional, default = "Covariant"): \n
+   * How the densities on the lattice are computed from the particles.
+   * \li \key "Covariant" - Every particle is smeared onto all nodes within the
+   *     cut-off radius with a Lorentz-contracted Gaussian.
+   * \li \key "Separable" - Every particle is assigned to the 8 surrounding
+   *     nodes and the densities are then convolved with a Gaussian along x, y
+   *     and z. This is much faster for fine lattices and many test particles,
+   *     but the Lorentz contraction of the Gaussians is neglected, so it is
+   *     only accurate for slow particles. The cells have to be smaller than
+   *     \f$\sqrt{6}\f$ times \key Gaussian_Sigma. The energy-momentum tensor
+   *     on the lattice is always smeared covariantly.
+   *
+   * \key Interpolation (bool, optional, default = false): \n
+   * Interpolate the potentials and forces on the lattice trilinearly between
+   * the cell centers when they are evaluated at the positions of particles and
+   * interaction points, instead of taking the value of the cell the position
+   * is in. This avoids jumps of the forces at the cell borders, so that
+   * coarser lattices can be used.
+   *
    * For information on the format of the lattice output see
    * \ref output_vtk_lattice_. To configure the
    * thermodynamic output, see \ref input_output_options_.
@@ -1300,6 +1454,8 @@ Experiment<Modus>::Experiment(Configuration config, const bf::path &output_path)
     const std::array<int, 3> n = config.take({"Lattice", "Cell_Number"});
     const std::array<double, 3> origin = config.take({"Lattice", "Origin"});
     const bool periodic = config.take({"Lattice", "Periodic"});
+    const bool interpolation =
+        config.take({"Lattice", "Interpolation"}, false);
 
     if (printout_lattice_td_) {
       dens_type_lattice_printout_ = output_parameters.td_dens_type;
@@ -1323,6 +1479,8 @@ Experiment<Modus>::Experiment(Configuration config, const bf::path &output_path)
         FB_lat_ = make_unique<
             RectangularLattice<std::pair<ThreeVector, ThreeVector>>>(
             l, n, origin, periodic, LatticeUpdate::EveryTimestep);
+        UB_lat_->set_interpolation(interpolation);
+        FB_lat_->set_interpolation(interpolation);
       }
       if (potentials_->use_symmetry()) {
         jmu_I3_lat_ = make_unique<DensityLattice>(l, n, origin, periodic,
@@ -1332,6 +1490,8 @@ Experiment<Modus>::Experiment(Configuration config, const bf::path &output_path)
         FI3_lat_ = make_unique<
             RectangularLattice<std::pair<ThreeVector, ThreeVector>>>(
             l, n, origin, periodic, LatticeUpdate::EveryTimestep);
+        UI3_lat_->set_interpolation(interpolation);
+        FI3_lat_->set_interpolation(interpolation);
       }
     } else {
       if (dens_type_lattice_printout_ == DensityType::Baryon) {
@@ -1611,11 +1771,12 @@ bool Experiment<Modus>::perform_action(
   double rho = 0.0;
   if (dens_type_ != DensityType::None) {
     const FourVector r_interaction = action.get_interaction_point();
-    constexpr bool compute_grad = false;
     const bool smearing = true;
-    rho = std::get<0>(current_eckart(r_interaction.threevec(),
-                                     particles_before_actions, density_param_,
-                                     dens_type_, compute_grad, smearing));
+    rho = probe_thermodynamics({r_interaction.threevec()},
+                               particles_before_actions, density_param_,
+                               dens_type_, smearing, true, false, false)
+              .front()
+              .rho_eckart;
   }
   /*!\Userguide
    * \page collisions_output_in_box_modus_ Collision Output in Box Modus
@@ -1714,6 +1875,12 @@ bool Experiment<Modus>::perform_action(
 template <typename Modus>
 void Experiment<Modus>::run_time_evolution() {
   Actions actions;
+  // the grid, the decay and the crossing times of a previous event are of no
+  // use
+  grid_.reset();
+  decay_schedule_.clear();
+  crossing_schedule_.clear();
+  int timesteps_since_reordering = 0;
 
   while (parameters_.labclock->current_time() < end_time_) {
     const double t = parameters_.labclock->current_time();
@@ -1737,14 +1904,30 @@ void Experiment<Modus>::run_time_evolution() {
     }
 
     if (particles_.size() > 0 && action_finders_.size() > 0) {
-      /* (1.a) Create grid. */
       double min_cell_length = compute_min_cell_length(dt);
-      logg[LExperiment].debug("Creating grid with minimal cell length ",
-                              min_cell_length);
-      const auto &grid =
-          use_grid_ ? modus_.create_grid(particles_, min_cell_length, dt)
-                    : modus_.create_grid(particles_, min_cell_length, dt,
-                                         CellSizeStrategy::Largest);
+      /* (1.0) Sort the particles in memory. This invalidates all copies of
+       * particles, so it has to happen before any action is found. */
+      if (reorder_interval_ > 0 &&
+          ++timesteps_since_reordering >= reorder_interval_) {
+        particles_.reorder_spatially(min_cell_length);
+        timesteps_since_reordering = 0;
+      }
+
+      /* (1.a) Create grid or update the one of the previous timestep. */
+      const bool keep_grid =
+          parameters_.coll_crit != CollisionCriterion::Stochastic;
+      if (!(keep_grid && grid_ &&
+            grid_->update(particles_, min_cell_length, dt))) {
+        logg[LExperiment].debug("Creating grid with minimal cell length ",
+                                min_cell_length);
+        const double skin = keep_grid ? grid_skin_ : 0.;
+        grid_ = make_unique<typename Modus::GridType>(
+            use_grid_ ? modus_.create_grid(particles_, min_cell_length, dt,
+                                           CellSizeStrategy::Optimal, skin)
+                      : modus_.create_grid(particles_, min_cell_length, dt,
+                                           CellSizeStrategy::Largest, skin));
+      }
+      const auto &grid = *grid_;
 
       const double gcell_vol = grid.cell_volume();
 
@@ -1813,6 +1996,70 @@ template <typename Modus>
 void Experiment<Modus>::propagate_and_shine(double to_time) {
   const double dt =
       propagate_straight_line(&particles_, to_time, beam_momentum_);
+  if (modus_.inline_wall_crossing()) {
+    const bool write_crossings =
+        std::any_of(outputs_.begin(), outputs_.end(),
+                    [](const OutputPtr &output) {
+                      return output->is_collision_output();
+                    });
+    ActionList crossings;
+    const int wall_crossings = modus_.wrap_wall_crossings(
+        &particles_, write_crossings ? &crossings : nullptr);
+    /* Wall crossings count as interactions in the same way as the
+     * wall-crossing actions they replace. */
+    interactions_total_ += wall_crossings;
+    wall_actions_total_ += wall_crossings;
+    /* The density at a crossing is probed with the particles at the time of
+     * the crossing and wrapped into the box, like perform_action does after
+     * a wall-crossing action. These positions are obtained by propagating a
+     * single copy of the particles from one crossing to the next. */
+    ParticleList at_crossing;
+    if (!crossings.empty() && dens_type_ != DensityType::None) {
+      at_crossing = particles_.copy_to_vector();
+    }
+    /* All crossings happened before the action the particles were propagated
+     * to. Since they are sorted by time, the collision output stays in the
+     * order of time, like with wall-crossing actions. */
+    for (const ActionPtr &crossing : crossings) {
+      // Eckart rest frame density at the crossing, as in perform_action
+      double rho = 0.0;
+      if (dens_type_ != DensityType::None) {
+        const ParticleData &crossed = crossing->outgoing_particles()[0];
+        const double t_crossing = crossing->time_of_execution();
+        const double length = parameters_.box_length;
+        for (ParticleData &data : at_crossing) {
+          if (data.id() == crossed.id()) {
+            // on the wall it was moved to
+            data.set_4position(crossed.position());
+            continue;
+          }
+          const FourVector &p = data.momentum();
+          FourVector r = data.position() +
+                         p * ((t_crossing - data.position().x0()) / p.x0());
+          for (int i = 1; i < 4; i++) {
+            if (r[i] < 0.) {
+              r[i] += length;
+            } else if (r[i] >= length) {
+              r[i] -= length;
+            }
+          }
+          data.set_4position(r);
+        }
+        const FourVector r_interaction = crossing->get_interaction_point();
+        const bool smearing = true;
+        rho = probe_thermodynamics({r_interaction.threevec()}, at_crossing,
+                                   density_param_, dens_type_, smearing, true,
+                                   false, false)
+                  .front()
+                  .rho_eckart;
+      }
+      for (const auto &output : outputs_) {
+        if (output->is_collision_output()) {
+          output->at_interaction(*crossing, rho);
+        }
+      }
+    }
+  }
   if (dilepton_finder_ != nullptr) {
     for (const auto &output : outputs_) {
       dilepton_finder_->shine(particles_, output.get(), dt);
@@ -2087,28 +2334,34 @@ void Experiment<Modus>::do_final_decays() {
   /* At end of time evolution: Force all resonances to decay. In order to handle
    * decay chains, we need to loop until no further actions occur. */
   uint64_t interactions_old;
-  const auto particles_before_actions = particles_.copy_to_vector();
-  do {
-    Actions actions;
-
-    interactions_old = interactions_total_;
-
-    // Dileptons: shining of remaining resonances
-    if (dilepton_finder_ != nullptr) {
-      for (const auto &output : outputs_) {
-        dilepton_finder_->shine_final(particles_, output.get(), true);
+  {
+    /* The densities at the decay points are calculated from the particles
+     * before the final decays. The snapshot only copies the decayed ones and
+     * is released at the end of this block. */
+    const Particles::Snapshot particles_before_actions =
+        particles_.take_snapshot();
+    do {
+      Actions actions;
+
+      interactions_old = interactions_total_;
+
+      // Dileptons: shining of remaining resonances
+      if (dilepton_finder_ != nullptr) {
+        for (const auto &output : outputs_) {
+          dilepton_finder_->shine_final(particles_, output.get(), true);
+        }
       }
-    }
-    // Find actions.
-    for (const auto &finder : action_finders_) {
-      actions.insert(finder->find_final_actions(particles_));
-    }
-    // Perform actions.
-    while (!actions.is_empty()) {
-      perform_action(*actions.pop(), particles_before_actions);
-    }
-    // loop until no more decays occur
-  } while (interactions_total_ > interactions_old);
+      // Find actions.
+      for (const auto &finder : action_finders_) {
+        actions.insert(finder->find_final_actions(particles_));
+      }
+      // Perform actions.
+      while (!actions.is_empty()) {
+        perform_action(*actions.pop(), particles_before_actions);
+      }
+      // loop until no more decays occur
+    } while (interactions_total_ > interactions_old);
+  }
 
   // Dileptons: shining of stable particles at the end
   if (dilepton_finder_ != nullptr) {
@@ -2219,49 +2472,61 @@ void Experiment<Modus>::final_output(const int evt_num) {
 }
 
 template <typename Modus>
-void Experiment<Modus>::run() {
-  const auto &mainlog = logg[LMain];
-  for (int j = 0; j < nevents_; j++) {
-    mainlog.info() << "Event " << j;
-
-    // Sample initial particles, start clock, some printout and book-keeping
-    initialize_new_event(j);
-    /* In the ColliderModus, if the first collisions within the same nucleus are
-     * forbidden, 'nucleon_has_interacted_', which records whether a nucleon has
-     * collided with another nucleon, is initialized equal to false. If allowed,
-     * 'nucleon_has_interacted' is initialized equal to true, which means these
-     * incoming particles have experienced some fake scatterings, they can
-     * therefore collide with each other later on since these collisions are not
-     * "first" to them. */
-    if (modus_.is_collider()) {
-      if (!modus_.cll_in_nucleus()) {
-        nucleon_has_interacted_.assign(modus_.total_N_number(), false);
-      } else {
-        nucleon_has_interacted_.assign(modus_.total_N_number(), true);
-      }
+void Experiment<Modus>::run_event(int event_number) {
+  // Sample initial particles, start clock, some printout and book-keeping
+  initialize_new_event(event_number);
+  /* In the ColliderModus, if the first collisions within the same nucleus are
+   * forbidden, 'nucleon_has_interacted_', which records whether a nucleon has
+   * collided with another nucleon, is initialized equal to false. If allowed,
+   * 'nucleon_has_interacted' is initialized equal to true, which means these
+   * incoming particles have experienced some fake scatterings, they can
+   * therefore collide with each other later on since these collisions are not
+   * "first" to them. */
+  if (modus_.is_collider()) {
+    if (!modus_.cll_in_nucleus()) {
+      nucleon_has_interacted_.assign(modus_.total_N_number(), false);
+    } else {
+      nucleon_has_interacted_.assign(modus_.total_N_number(), true);
     }
-    /* In the ColliderModus, if Fermi motion is frozen, assign the beam momenta
-     * to the nucleons in both the projectile and the target. */
-    if (modus_.is_collider() && modus_.fermi_motion() == FermiMotion::Frozen) {
-      for (int i = 0; i < modus_.total_N_number(); i++) {
-        const auto mass_beam = particles_.copy_to_vector()[i].effective_mass();
-        const auto v_beam = i < modus_.proj_N_number()
-                                ? modus_.velocity_projectile()
-                                : modus_.velocity_target();
-        const auto gamma = 1.0 / std::sqrt(1.0 - v_beam * v_beam);
-        beam_momentum_.emplace_back(FourVector(gamma * mass_beam, 0.0, 0.0,
-                                               gamma * v_beam * mass_beam));
+  }
+  /* In the ColliderModus, if Fermi motion is frozen, assign the beam momenta
+   * to the nucleons in both the projectile and the target. They are indexed
+   * by the particle id, which equals the position of the nucleon in the
+   * initial list. */
+  if (modus_.is_collider() && modus_.fermi_motion() == FermiMotion::Frozen) {
+    const int n_nucleons = modus_.total_N_number();
+    beam_momentum_.assign(n_nucleons, FourVector());
+    for (const ParticleData &nucleon : particles_) {
+      const int i = nucleon.id();
+      if (i >= n_nucleons) {
+        continue;
       }
+      const auto mass_beam = nucleon.effective_mass();
+      const auto v_beam = i < modus_.proj_N_number()
+                              ? modus_.velocity_projectile()
+                              : modus_.velocity_target();
+      const auto gamma = 1.0 / std::sqrt(1.0 - v_beam * v_beam);
+      beam_momentum_[i] =
+          FourVector(gamma * mass_beam, 0.0, 0.0, gamma * v_beam * mass_beam);
     }
+  }
 
-    run_time_evolution();
+  run_time_evolution();
 
-    if (force_decays_) {
-      do_final_decays();
-    }
+  if (force_decays_) {
+    do_final_decays();
+  }
+
+  // Output at event end
+  final_output(event_number);
+}
 
-    // Output at event end
-    final_output(j);
+template <typename Modus>
+void Experiment<Modus>::run() {
+  const auto &mainlog = logg[LMain];
+  for (int j = 0; j < nevents_; j++) {
+    mainlog.info() << "Event " << j;
+    run_event(j);
   }
 }
 
@@ -37,6 +37,9 @@ struct ExperimentParameters {
   /// Distance at which gaussian is cut, i.e. set to zero, IN SIGMA (not fm)
   double gauss_cutoff_in_sigma;
 
+  /// How densities are smeared onto the lattice
+  SmearingMode smearing_mode;
+
   /// Employed collision criterion
   const CollisionCriterion coll_crit;
 
@@ -182,6 +182,14 @@ enum class NNbarTreatment {
   Strings,
 };
 
+/// How densities are smeared onto a lattice
+enum class SmearingMode {
+  /// Lorentz-contracted Gaussian evaluated for every particle and node
+  Covariant,
+  /// Rest-frame Gaussian applied as three one-dimensional convolutions
+  Separable,
+};
+
 /// Represents thermodynamic quantities that can be printed out
 enum class ThermodynamicQuantity : char {
   EckartDensity,
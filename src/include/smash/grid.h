@@ -58,9 +58,11 @@ class GridBase {
    * the particles in \p particles.
    *
    * \param[in] particles Particles in the system
+   * \param[in] skin Distance by which the box around the particles is
+   *                 enlarged in every direction [fm]
    */
   static std::pair<std::array<double, 3>, std::array<double, 3>>
-  find_min_and_length(const Particles &particles);
+  find_min_and_length(const Particles &particles, double skin = 0.);
 };
 
 /**
@@ -89,11 +91,14 @@ class Grid : public GridBase {
    * formation times treatment: if particle is fully or partially formed before
    * the end of the timestep, it has to be on the grid. \param[in] strategy The
    * strategy for determining the cell size
+   * \param[in] skin Distance by which the grid extends beyond the particles in
+   * every direction. A larger skin allows to reuse the grid for more
+   * timesteps, see update().
    */
   Grid(const Particles &particles, double min_cell_length,
        double timestep_duration,
-       CellSizeStrategy strategy = CellSizeStrategy::Optimal)
-      : Grid{find_min_and_length(particles), std::move(particles),
+       CellSizeStrategy strategy = CellSizeStrategy::Optimal, double skin = 0.)
+      : Grid{find_min_and_length(particles, skin), std::move(particles),
              min_cell_length, timestep_duration, strategy} {}
 
   /**
@@ -115,6 +120,25 @@ class Grid : public GridBase {
        double timestep_duration,
        CellSizeStrategy strategy = CellSizeStrategy::Optimal);
 
+  /**
+   * Places the current state of \p particles onto the existing cells, keeping
+   * the grid geometry. Only the assignment of particles to cells is updated,
+   * the bounding box, the cell sizes and the cell storage are reused.
+   *
+   * This fails if the grid is not suitable for the particles anymore, i.e.
+   * if a particle is outside of the grid, the cells are smaller than
+   * \p min_cell_length, or the number of particles changed by more than
+   * half since the grid was constructed. Then the grid has to be constructed
+   * anew and must not be used before.
+   *
+   * \param[in] particles The particles to place onto the grid.
+   * \param[in] min_cell_length The minimal length a cell must have.
+   * \param[in] timestep_duration Duration of the timestep in fm/c
+   * \return whether the grid could be updated
+   */
+  bool update(const Particles &particles, double min_cell_length,
+              double timestep_duration);
+
   /**
    * Iterates over all cells in the grid and calls the callback arguments with
    * a search cell and 0 to 13 neighbor cells.
@@ -156,9 +180,33 @@ class Grid : public GridBase {
     return make_index(idx[0], idx[1], idx[2]);
   }
 
+  /**
+   * Clears the cells and places the particles onto them.
+   *
+   * \param[in] particles The particles to place onto the grid.
+   * \param[in] timestep_duration Duration of the timestep in fm/c
+   * \return false if a particle lies outside of the grid
+   */
+  bool place_particles(const Particles &particles, double timestep_duration);
+
+  /// The minimum x,y,z coordinates of the grid.
+  const std::array<double, 3> min_position_;
+
   /// The 3 lengths of the complete grid. Used for periodic boundary wrapping.
   const std::array<double, 3> length_;
 
+  /// The minimal cell length the grid was constructed for.
+  const double min_cell_length_;
+
+  /// The number of particles the grid was constructed for.
+  const SizeType particle_count_;
+
+  /// The strategy used for determining the cell size.
+  const CellSizeStrategy strategy_;
+
+  /// The factors to obtain the x, y, z cell indices from a position.
+  std::array<double, 3> index_factor_;
+
   /// The volume of a single cell.
   double cell_volume_;
 
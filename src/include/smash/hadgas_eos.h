@@ -19,6 +19,7 @@
 
 #include "constants.h"
 #include "particletype.h"
+#include "random.h"
 
 namespace smash {
 
@@ -290,6 +291,60 @@ class HadronGasEos {
    * \return sampled mass
    */
   static double sample_mass_thermal(const ParticleType& ptype, double beta);
+
+  /**
+   * Rejection envelope of the thermal mass distribution of one resonance at
+   * one temperature, see sample_mass_thermal(). Finding the maximum is the
+   * expensive part of the mass sampling, so it is shared by all particles of
+   * one species.
+   */
+  struct ThermalMassEnvelope {
+    /// The hadron sort, for which mass is sampled
+    ParticleTypePtr ptype;
+    /// Inverse temperature 1/T [1/GeV]
+    double beta;
+    /// Maximum of the ratio of the thermal distribution and the envelope
+    double max_ratio;
+    /// Mass at which max_ratio was found [GeV]
+    double m_where_max;
+  };
+
+  /**
+   * Find the rejection envelope for sampling the mass of the given hadron
+   * sort in a thermal medium. This draws no random numbers.
+   *
+   * \param[in] ptype the hadron sort, for which mass is sampled
+   * \param[in] beta inverse temperature 1/T [1/GeV]
+   * \return envelope to be used with sample_mass_thermal(ThermalMassEnvelope&)
+   */
+  static ThermalMassEnvelope thermal_mass_envelope(const ParticleType& ptype,
+                                                   double beta);
+
+  /**
+   * \brief Sample resonance mass in a thermal medium from a given envelope
+   *
+   * Same distribution as sample_mass_thermal(const ParticleType&, double).
+   * If a larger maximum is found while sampling, the envelope is updated for
+   * subsequent calls. Nothing is logged, so that the masses can be sampled on
+   * other threads than the main thread; use warn_if_maximum_increased()
+   * afterwards.
+   *
+   * \param[in,out] envelope result of thermal_mass_envelope()
+   * \param[in,out] rng Random number engine; the common engine by default
+   * \return sampled mass
+   */
+  static double sample_mass_thermal(ThermalMassEnvelope& envelope,
+                                    random::Engine& rng = random::engine);
+
+  /**
+   * Warn if sampling with an envelope found a larger maximum than
+   * thermal_mass_envelope(), which means the envelope was not accurate.
+   *
+   * \param[in] initial envelope before sampling
+   * \param[in] updated the same envelope after sampling
+   */
+  static void warn_if_maximum_increased(const ThermalMassEnvelope& initial,
+                                        const ThermalMassEnvelope& updated);
   /**
    * Compute temperature and chemical potentials given energy-,
    * net baryon-, net strangeness- and net charge density and an
@@ -13,8 +13,12 @@
 
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "file.h"
 #include "forwarddeclarations.h"
+#include "fourvector.h"
 #include "outputinterface.h"
 #include "outputparameters.h"
 
@@ -45,7 +49,8 @@ class HepMcOutput : public OutputInterface {
    *
    * \param[in] path Output path.
    * \param[in] name Name of the output.
-   * \param[in] out_par Unused, needed since inhertied.
+   * \param[in] out_par Parameters of the output, selects whether the event
+   *                    record is written directly.
    * \param[in] total_N Total number of particles in both nuclei.
    * \param[in] proj_N  Number of particles in projectile.
    */
@@ -53,7 +58,7 @@ class HepMcOutput : public OutputInterface {
               const OutputParameters &out_par, const int total_N,
               const int proj_N);
 
-  /// Destructor renames file
+  /// Destructor closes and renames file
   ~HepMcOutput();
 
   /**
@@ -118,6 +123,35 @@ class HepMcOutput : public OutputInterface {
    */
   int construct_nuclear_pdg_code(int na, int nz) const;
 
+  /**
+   * Write the current event directly into the output file in the HepMC3
+   * Asciiv3 format, producing the same text as HepMC3::WriterAscii would
+   * for the equivalent GenEvent.
+   *
+   * \param[in] particles Final particles of the event.
+   * \param[in] event Event info, see \ref event_info
+   */
+  void write_event_directly(const Particles &particles,
+                            const EventInfo &event);
+
+  /// Whether the event record is written without building a GenEvent
+  const bool direct_;
+
+  /// Output file of the direct writer
+  FilePtr direct_file_;
+
+  /// Attribute string of the (dummy) cross section for the direct writer
+  std::string cross_section_string_;
+
+  /// Number of the current event for the direct writer
+  int event_number_ = 0;
+
+  /// Momenta and pdg codes of the initial particles for the direct writer
+  std::vector<std::pair<FourVector, int>> beam_particles_;
+
+  /// Text of the current event for the direct writer
+  std::string event_buffer_;
+
   /// Pointer to Ascii HepMC3 output file
   std::unique_ptr<HepMC3::WriterAscii> output_file_;
 
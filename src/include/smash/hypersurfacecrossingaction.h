@@ -10,10 +10,14 @@
 #ifndef SRC_INCLUDE_SMASH_HYPERSURFACECROSSINGACTION_H_
 #define SRC_INCLUDE_SMASH_HYPERSURFACECROSSINGACTION_H_
 
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
 #include <vector>
 
 #include "action.h"
 #include "actionfinderfactory.h"
+#include "fourvector.h"
 
 namespace smash {
 
@@ -52,6 +56,44 @@ class HypersurfacecrossingAction : public Action {
   void check_conservation(const uint32_t id_process) const override;
 };
 
+/**
+ * \ingroup action
+ * Times at which the particles cross the hypersurface, which are computed once
+ * per straight-line trajectory and kept until the trajectory changes.
+ */
+struct HyperSurfaceCrossingSchedule {
+  /// The crossing time computed for a trajectory
+  struct Entry {
+    /// Process id of the particle when the crossing time was computed
+    uint32_t id_process;
+    /// Momentum of the particle when the crossing time was computed
+    FourVector momentum;
+    /// Time of the crossing in the computational frame [fm]
+    double crossing_time;
+    /// Time at which the entry was used the last time [fm]
+    double last_used;
+  };
+
+  /// Crossing times, identified by the particle id
+  std::unordered_map<int32_t, Entry> entries;
+
+  /// Size of the schedule at which unused entries are removed
+  std::size_t purge_size = 1000;
+
+  /// Time of the current timestep [fm]
+  double current_time = -std::numeric_limits<double>::infinity();
+
+  /// Time of the previous timestep [fm]
+  double previous_time = -std::numeric_limits<double>::infinity();
+
+  /// Remove all entries, e.g. at the beginning of an event.
+  void clear() {
+    entries.clear();
+    current_time = -std::numeric_limits<double>::infinity();
+    previous_time = -std::numeric_limits<double>::infinity();
+  }
+};
+
 /**
  * \ingroup action
  * Finder for hypersurface crossing actions.
@@ -63,12 +105,22 @@ class HyperSurfaceCrossActionsFinder : public ActionFinderInterface {
   /**
    * Construct hypersurfacecrossing action finder.
    * \param[in] tau Proper time of the hypersurface. [fm]
+   * \param[in] crossing_schedule Schedule for keeping the crossing times
+   *                              across timesteps. If this is a null pointer,
+   *                              they are computed in every timestep.
    */
-  explicit HyperSurfaceCrossActionsFinder(double tau) : prop_time_{tau} {};
+  explicit HyperSurfaceCrossActionsFinder(
+      double tau, HyperSurfaceCrossingSchedule *crossing_schedule = nullptr)
+      : prop_time_{tau}, crossing_schedule_(crossing_schedule) {}
 
   /**
    * Find the next hypersurface crossings for each particle that occur within
    * the timestepless propagation.
+   *
+   * The crossing time is computed analytically for the whole straight-line
+   * trajectory of a particle. If a schedule is given, it is stored there and
+   * only computed again once the momentum or the process id of the particle
+   * changed.
    * \param[in] plist List of all particles.
    * \param[in] dt Time until crossing can appear (until end of timestep). [fm]
    * \param[in] beam_momentum [GeV] List of beam momenta for each particle;
@@ -103,32 +155,28 @@ class HyperSurfaceCrossActionsFinder : public ActionFinderInterface {
   /// Proper time of the hypersurface in fm.
   const double prop_time_;
 
+  /// Schedule of the crossing times (not owned), or null
+  HyperSurfaceCrossingSchedule *crossing_schedule_ = nullptr;
+
   /**
-   * Determine whether particle crosses hypersurface within next timestep
-   * during propagation
-   * \param[in] pdata_before_propagation Particle data at the beginning of time
-   *            step in question
-   * \param[in] pdata_after_propagation Particle data at the end of time step
-   *            in question
-   * \param[in] tau Proper time of the hypersurface that is tested
-   * \return Does particle cross the hypersurface?
+   * Determine when the straight-line trajectory of a particle crosses the
+   * hypersurface.
+   *
+   * \param[in] p Particle whose trajectory is considered
+   * \param[in] beam_momentum [GeV] List of beam momenta for each particle;
+   *            only necessary for frozen Fermi motion
+   * \return Time of the crossing in the future light cone [fm]. This may lie
+   *         before the current time of the particle, if it is already beyond
+   *         the hypersurface, and is infinite if it never reaches it.
    */
-  bool crosses_hypersurface(ParticleData &pdata_before_propagation,
-                            ParticleData &pdata_after_propagation,
-                            const double tau) const;
+  double crossing_time(const ParticleData &p,
+                       const std::vector<FourVector> &beam_momentum) const;
 
   /**
-   * Find the coordinates where particle crosses hypersurface
-   * \param[in] pdata_before_propagation Particle data at the beginning of time
-   *            in question
-   * \param[in] pdata_after_propagation Particle data at the end of time step
-   *            in question
-   * \param[in] tau Proper time of the hypersurface that is crossed
-   * \return Fourvector of the crossing position
+   * Remove the entries of the crossing schedule that were used neither in the
+   * current nor in the previous timestep.
    */
-  FourVector coordinates_on_hypersurface(ParticleData &pdata_before_propagation,
-                                         ParticleData &pdata_after_propagation,
-                                         const double tau) const;
+  void purge_crossing_schedule() const;
 };
 
 }  // namespace smash
@@ -18,16 +18,97 @@
 #include "file.h"
 #include "outputinterface.h"
 #include "outputparameters.h"
+#include "particledata.h"
+#include "pdgcode.h"
 #include "smash/config.h"
 
 namespace smash {
 
+/**
+ * Particle on the hypersurface of constant proper time in the variables used
+ * by hydrodynamic codes.
+ */
+struct ICParticle {
+  /**
+   * Compute the hypersurface variables of a particle.
+   *
+   * \param[in] data Particle at the hypersurface crossing point
+   */
+  explicit ICParticle(const ParticleData &data);
+
+  /// Proper time [fm]
+  double tau;
+  /// Cartesian x coordinate [fm]
+  double x;
+  /// Cartesian y coordinate [fm]
+  double y;
+  /// Space-time rapidity
+  double eta;
+  /// Transverse mass [GeV]
+  double mt;
+  /// x component of the momentum [GeV]
+  double px;
+  /// y component of the momentum [GeV]
+  double py;
+  /// Momentum space rapidity
+  double rapidity;
+  /// PDG code
+  PdgCode pdg;
+  /// Electric charge [e]
+  int charge;
+};
+
+/**
+ * Interface for receiving the initial conditions for hydrodynamic codes.
+ *
+ * The file formats of ICOutput are implemented as consumers, and a
+ * hydrodynamic code linked to SMASH can implement its own consumer to receive
+ * the particles directly from memory, see
+ * Experiment::add_initial_conditions_consumer.
+ */
+class ICConsumer {
+ public:
+  /// Virtual destructor, because there are derived classes.
+  virtual ~ICConsumer() = default;
+
+  /**
+   * Called at the start of every event.
+   *
+   * \param[in] event_number Number of the current event
+   */
+  virtual void at_eventstart(int /*event_number*/) {}
+
+  /**
+   * Called for every particle that crosses the hypersurface, except for the
+   * spectators.
+   *
+   * \param[in] particle Particle at the hypersurface crossing point
+   */
+  virtual void at_crossing(const ICParticle &particle) = 0;
+
+  /**
+   * Called at the end of every event.
+   *
+   * \param[in] event_number Number of the current event
+   */
+  virtual void at_eventend(int /*event_number*/) {}
+};
+
+/// Formats of the initial conditions files written by ICOutput
+enum class ICFormat {
+  /// Text file that can be read by vHLLE (SMASH_IC.dat)
+  ASCII,
+  /// Binary file with a header describing the fields (SMASH_IC_compact.bin)
+  CompactBinary,
+};
+
 /**
  * \ingroup output
  *
- * SMASH output in ASCII format containing initial conditions for hydrodynamic
- * codes. Formatted such that it can be directly processed by vHLLE
- * \iref{Karpenko:2015xea}.
+ * SMASH output containing initial conditions for hydrodynamic codes.
+ * Formatted such that it can be directly processed by vHLLE
+ * \iref{Karpenko:2015xea}, or in a compact binary format. Alternatively, the
+ * particles are handed over to an ICConsumer.
  */
 class ICOutput : public OutputInterface {
  public:
@@ -37,20 +118,34 @@ class ICOutput : public OutputInterface {
    * \param[in] path Path to the output file.
    * \param[in] name Name of the output.
    * \param[in] out_par Additional information on the configured output.
+   * \param[in] format Format of the output file.
    */
   ICOutput(const bf::path &path, const std::string &name,
-           const OutputParameters &out_par);
+           const OutputParameters &out_par,
+           ICFormat format = ICFormat::ASCII);
+
+  /**
+   * Create a new IC output that passes the particles to a consumer instead of
+   * writing them to a file.
+   *
+   * \param[in] name Name of the output.
+   * \param[in] out_par Additional information on the configured output.
+   * \param[in] consumer Receiver of the particles on the hypersurface.
+   */
+  ICOutput(const std::string &name, const OutputParameters &out_par,
+           std::shared_ptr<ICConsumer> consumer);
   ~ICOutput();
 
   /**
-   * Write event start line.
+   * Write event start line (ASCII format only).
    * \param[in] event_number Number of the current event.
    */
   void at_eventstart(const Particles &, const int event_number,
                      const EventInfo &) override;
 
   /**
-   * Write event end line.
+   * Write event end line, and the particles of the event in case of the
+   * binary format.
    * \param[in] particles Particles at end of event, expected to be empty
    * \param[in] event_number Number of the current event.
    */
@@ -71,8 +166,8 @@ class ICOutput : public OutputInterface {
   void at_interaction(const Action &action, const double) override;
 
  private:
-  /// Pointer to output file
-  RenamingFilePtr file_;
+  /// File writer or external receiver of the particles
+  std::shared_ptr<ICConsumer> consumer_;
   /// Structure that holds all the information about what to printout
   const OutputParameters out_par_;
 
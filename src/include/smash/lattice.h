@@ -10,7 +10,9 @@
 #ifndef SRC_INCLUDE_SMASH_LATTICE_H_
 #define SRC_INCLUDE_SMASH_LATTICE_H_
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <cstring>
 #include <functional>
 #include <utility>
@@ -39,6 +41,34 @@ enum class LatticeUpdate {
   EveryFixedInterval = 2,
 };
 
+/**
+ * Adds a weighted value to a sum, as needed to interpolate lattice quantities.
+ *
+ * \tparam T Type of the lattice quantity, which has to support
+ *           multiplication with a double and addition.
+ * \param[in,out] sum Sum to which the weighted value is added
+ * \param[in] value Value to be added
+ * \param[in] weight Weight of the value
+ */
+template <typename T>
+inline void add_weighted(T& sum, const T& value, double weight) {
+  sum += value * weight;
+}
+
+/**
+ * Adds a weighted pair of values to a sum of pairs, see add_weighted().
+ *
+ * \param[in,out] sum Sum to which the weighted values are added
+ * \param[in] value Values to be added
+ * \param[in] weight Weight of the values
+ */
+template <typename T1, typename T2>
+inline void add_weighted(std::pair<T1, T2>& sum,
+                         const std::pair<T1, T2>& value, double weight) {
+  add_weighted(sum.first, value.first, weight);
+  add_weighted(sum.second, value.second, weight);
+}
+
 /**
  * A container class to hold all the arrays on the lattice and access them.
  * \tparam T The type of the contained values.
@@ -96,7 +126,8 @@ class RectangularLattice {
         cell_sizes_(rl.cell_sizes_),
         origin_(rl.origin_),
         periodic_(rl.periodic_),
-        when_update_(rl.when_update_) {}
+        when_update_(rl.when_update_),
+        interpolation_(rl.interpolation_) {}
 
   /// Sets all values on lattice to zeros.
   void reset() { std::fill(lattice_.begin(), lattice_.end(), T()); }
@@ -166,6 +197,17 @@ class RectangularLattice {
   /// \return The enum, which tells at which time lattice needs to be updated.
   LatticeUpdate when_update() const { return when_update_; }
 
+  /// \return Whether evaluate_at() interpolates between the cells.
+  bool interpolation() const { return interpolation_; }
+
+  /**
+   * Sets whether evaluate_at() interpolates between the cells. This is off
+   * by default.
+   *
+   * \param[in] interpolate Whether to interpolate
+   */
+  void set_interpolation(bool interpolate) { interpolation_ = interpolate; }
+
   /// Iterator of lattice.
   using iterator = typename std::vector<T>::iterator;
   /// Const interator of lattice.
@@ -214,7 +256,7 @@ class RectangularLattice {
    * \return Boolean indicates whether the position r is located inside
    *         the lattice.
    *
-   * \todo (oliiny): maybe 1-order interpolation instead of 0-order?
+   * \see interpolated_value_at for the first-order interpolation
    */
   bool value_at(const ThreeVector& r, T& value) {
     const int ix = std::floor((r.x1() - origin_[0]) / cell_sizes_[0]);
@@ -229,6 +271,69 @@ class RectangularLattice {
     }
   }
 
+  /**
+   * Interpolates lattice quantity to coordinate r trilinearly between the
+   * centers of the 8 surrounding cells. Result is stored in the value
+   * variable. Like value_at(), returns false and sets the value to the
+   * default value if coordinate r is out of the lattice. On periodic
+   * lattices the cells on the opposite side are used beyond the border, on
+   * other lattices the value of the outermost cells is taken there.
+   * The lattice quantity has to support add_weighted().
+   *
+   * \param[in] r Position where the physical quantity would be evaluated.
+   * \param[out] value Physical quantity interpolated to the given position.
+   * \return Boolean indicates whether the position r is located inside
+   *         the lattice.
+   */
+  bool interpolated_value_at(const ThreeVector& r, T& value) {
+    std::array<int, 3> lower;
+    std::array<double, 3> fraction;
+    for (int k = 0; k < 3; k++) {
+      const double x = (r[k] - origin_[k]) / cell_sizes_[k];
+      if (!periodic_ && (x < 0. || x >= n_cells_[k])) {
+        value = T();
+        return false;
+      }
+      // Cell centers are at x = i + 0.5
+      lower[k] = std::floor(x - 0.5);
+      fraction[k] = x - 0.5 - lower[k];
+    }
+    value = T();
+    for (int dz = 0; dz < 2; dz++) {
+      for (int dy = 0; dy < 2; dy++) {
+        for (int dx = 0; dx < 2; dx++) {
+          const std::array<int, 3> offset = {dx, dy, dz};
+          std::array<int, 3> i;
+          double weight = 1.;
+          for (int k = 0; k < 3; k++) {
+            i[k] = lower[k] + offset[k];
+            if (!periodic_) {
+              i[k] = std::min(std::max(i[k], 0), n_cells_[k] - 1);
+            }
+            weight *= offset[k] ? fraction[k] : 1. - fraction[k];
+          }
+          add_weighted(value, node(i[0], i[1], i[2]), weight);
+        }
+      }
+    }
+    return true;
+  }
+
+  /**
+   * Evaluates lattice quantity at coordinate r with interpolated_value_at()
+   * if interpolation is switched on for the lattice and with value_at()
+   * otherwise.
+   *
+   * \param[in] r Position where the physical quantity would be evaluated.
+   * \param[out] value Physical quantity evaluated at the given position.
+   * \return Boolean indicates whether the position r is located inside
+   *         the lattice.
+   */
+  bool evaluate_at(const ThreeVector& r, T& value) {
+    return interpolation_ ? interpolated_value_at(r, value)
+                          : value_at(r, value);
+  }
+
   /**
    * A sub-lattice iterator, which iterates in a 3D-structured manner and
    * calls a function on every cell.
@@ -355,6 +460,8 @@ class RectangularLattice {
   const bool periodic_;
   /// When the lattice should be recalculated.
   const LatticeUpdate when_update_;
+  /// Whether evaluate_at() interpolates between the cells.
+  bool interpolation_ = false;
 
  private:
   /**
@@ -15,6 +15,7 @@
 
 #include "forwarddeclarations.h"
 #include "modusdefault.h"
+#include "particledata.h"
 
 namespace smash {
 
@@ -74,6 +75,9 @@ class ListModus : public ModusDefault {
   /**
    * Generates initial state of the particles in the system according to a list.
    *
+   * The particles given by set_next_event are used if there are any,
+   * otherwise the next event is read from the input list files.
+   *
    * \param[out] particles An empty list that gets filled up by this function
    * \param[in] parameters Unused, but necessary because of templated use of
    *                       this function
@@ -85,6 +89,19 @@ class ListModus : public ModusDefault {
    */
   double initial_conditions(Particles *particles,
                             const ExperimentParameters &parameters);
+
+  /**
+   * Sets the particles of the next event, which are then used by
+   * initial_conditions instead of reading the next event from the input list
+   * files. This allows to pass the particles from memory when SMASH is used as
+   * a library, see Experiment::run_event. Only the PDG codes, positions and
+   * momenta of the particles are used, and they are checked in the same way
+   * as the particles read from a file (see try_create_particle).
+   *
+   * \param[in] particles Initial particles of the next event
+   */
+  void set_next_event(ParticleList particles);
+
   /**
    * Judge whether formation times are the same for all the particles;
    * Don't do anti-freestreaming if all particles start already at the same
@@ -153,6 +170,12 @@ class ListModus : public ModusDefault {
   /// File prefix of the particle list
   std::string particle_list_file_prefix_;
 
+  /**
+   * First of File_Directory and File_Prefix that is missing in the
+   * configuration; empty if both are given
+   */
+  std::string missing_file_key_;
+
   /// File name of current file
   std::string current_particle_list_file_;
 
@@ -170,6 +193,12 @@ class ListModus : public ModusDefault {
   /// Counter for energy-momentum conservation warnings to avoid spamming
   int n_warns_mass_consistency_ = 0;
 
+  /// Particles of the next event given by set_next_event
+  ParticleList next_event_particles_;
+
+  /// Whether the next event is given by set_next_event instead of a file
+  bool has_next_event_particles_ = false;
+
   /** Check if the file given by filepath has events left after streampos
    * last_position
    *
@@ -191,6 +220,8 @@ class ListModus : public ModusDefault {
    * \return Absolute file path to file
    * \throws
    * runtime_error if file does not exist.
+   * \throws
+   * invalid_argument if File_Directory or File_Prefix is not configured.
    */
   bf::path file_path_(const int file_id);
 
@@ -203,6 +234,14 @@ class ListModus : public ModusDefault {
    */
   std::string next_event_();
 
+  /**
+   * Reads the next event from the input list files and creates its particles.
+   *
+   * \param[out] particles An empty list that gets filled up by this function
+   * \throw LoadFailure if an input list file is not correctly formatted
+   */
+  void read_next_event_(Particles *particles);
+
   /**\ingroup logging
    * Writes the initial state for the List to the output stream.
    *
@@ -61,6 +61,19 @@ class ModusDefault {
     return 0;
   }
 
+  /**
+   * Moves particles that left the simulation volume during propagation back
+   * into it, if the modus does so without wall-crossing actions.
+   *
+   * Only BoxModus can be set up to do this; the other Modi do nothing.
+   *
+   * \see BoxModus::wrap_wall_crossings
+   */
+  int wrap_wall_crossings(Particles* /*p*/,
+                          ActionList* /*crossings*/ = nullptr) {
+    return 0;
+  }
+
   /// \return Number of nucleons in both nuclei; only used in ColliderModus
   int total_N_number() const { return 0; }
   /// \return Number of nucleons in projectile; only used in ColliderModus
@@ -71,6 +84,9 @@ class ModusDefault {
   bool is_collider() const { return false; }
   /// \return Checks if modus is a box; overwritten in BoxModus
   bool is_box() const { return false; }
+  /** \return Whether wall crossings are applied during propagation instead of
+   * as actions; overwritten in BoxModus */
+  bool inline_wall_crossing() const { return false; }
   /// \return Checks if modus is list modus; overwritten in ListModus
   bool is_list() const { return false; }
   /// \return Center of mass energy per nucleon pair in ColliderModus
@@ -111,17 +127,22 @@ class ModusDefault {
    * \param[in] timestep_duration Duration of the timestep. It is necessary for
    * formation times treatment: if particle is fully or partially formed before
    * the end of the timestep, it has to be on the grid. \param[in] strategy The
-   * strategy to determine the cell size \return the Grid object
+   * strategy to determine the cell size \param[in] skin Distance by which the
+   * grid extends beyond the particles \return the Grid object
    *
    * \see Grid::Grid
    */
   Grid<GridOptions::Normal> create_grid(
       const Particles& particles, double min_cell_length,
       double timestep_duration,
-      CellSizeStrategy strategy = CellSizeStrategy::Optimal) const {
-    return {particles, min_cell_length, timestep_duration, strategy};
+      CellSizeStrategy strategy = CellSizeStrategy::Optimal,
+      double skin = 0.) const {
+    return {particles, min_cell_length, timestep_duration, strategy, skin};
   }
 
+  /// The type of the Grid created by create_grid
+  using GridType = Grid<GridOptions::Normal>;
+
   /**
    * Creates GrandCanThermalizer
    *
@@ -8,7 +8,9 @@
 #define SRC_INCLUDE_SMASH_NUCLEUS_H_
 
 #include <map>
+#include <ostream>
 #include <stdexcept>
+#include <string>
 #include <vector>
 
 #include "configuration.h"
@@ -16,6 +18,7 @@
 #include "forwarddeclarations.h"
 #include "fourvector.h"
 #include "particledata.h"
+#include "sha256.h"
 #include "threevector.h"
 
 namespace smash {
@@ -68,6 +71,17 @@ class Nucleus {
    */
   virtual ThreeVector distribute_nucleon();
 
+  /**
+   * Sample a radius from the spherically symmetric Woods-Saxon distribution
+   * \f$\frac{dN}{dr} = \frac{r^2}{\exp\left(\frac{r-r_0}{d}\right) + 1}\f$
+   * (without any upper bound for the radius), see distribute_nucleon.
+   *
+   * \param[in] radius Woods-Saxon radius \f$r_0\f$ (has to be positive).
+   * \param[in] diffusiveness Diffusiveness \f$d\f$ (has to be positive).
+   * \return Woods-Saxon distributed radius.
+   */
+  static double sample_woods_saxon_radius(double radius, double diffusiveness);
+
   /**
    * Woods-Saxon distribution
    * \param[in] x the position at which to evaluate the function
@@ -75,9 +89,40 @@ class Nucleus {
    */
   double woods_saxon(double x);
 
-  /// Sets the positions of the nucleons inside a nucleus.
+  /**
+   * Sets the positions of the nucleons inside a nucleus.
+   *
+   * If a configuration library was set up, the positions are taken from a
+   * randomly drawn configuration of the library instead of being sampled.
+   */
   virtual void arrange_nucleons();
 
+  /**
+   * Sets up a library of pre-sampled nucleon configurations, from which
+   * arrange_nucleons draws the positions for every event.
+   *
+   * The configurations are sampled with distribute_nucleon (for a custom
+   * nucleus this means reading them from the external file once) and stored
+   * recentered but unrotated. Each drawn configuration is randomly rotated
+   * (respecting the symmetry of the nucleus), such that a finite library
+   * still yields an unbiased sample of initial states.
+   *
+   * \param[in] n_configurations Number of configurations in the library.
+   * \param[in] file Path of a binary file to read the library from. If it is
+   *                 empty, the library is only kept in memory. If the file
+   *                 does not exist or does not match this nucleus and
+   *                 n_configurations, the library is sampled and written to
+   *                 the file.
+   * \throw runtime_error if the library file cannot be written.
+   */
+  void set_up_configuration_library(size_t n_configurations,
+                                    const std::string &file);
+
+  /// \return whether a configuration library was set up.
+  bool has_configuration_library() const {
+    return !configuration_library_.empty();
+  }
+
   /**
    * Sets the deformation parameters of the Woods-Saxon distribution
    * according to the current mass number.
@@ -262,11 +307,75 @@ class Nucleus {
   void random_euler_angles();
 
   /// Euler angel phi
-  double euler_phi_;
+  double euler_phi_ = 0.;
   /// Euler angel theta
-  double euler_theta_;
+  double euler_theta_ = 0.;
   /// Euler angel psi
-  double euler_psi_;
+  double euler_psi_ = 0.;
+
+  /**
+   * Library of pre-sampled nucleon positions (x, y, z for every particle of
+   * every configuration), see set_up_configuration_library. The particles of
+   * each configuration are stored in canonical order, so that every position
+   * keeps its isospin.
+   */
+  std::vector<float> configuration_library_;
+
+  /**
+   * \return Indices of the particles sorted by their PDG codes, keeping the
+   * order of particles of the same species. This is the order in which the
+   * positions of a configuration are stored in the library.
+   */
+  std::vector<size_t> canonical_order() const;
+
+  /**
+   * Set the nucleon positions from a randomly drawn and randomly rotated
+   * configuration of the library (and reset their momenta).
+   */
+  void draw_configuration_from_library();
+
+  /**
+   * Rotate a position of a drawn library configuration according to the
+   * random Euler angles. Nuclei that are not spherically symmetric have to
+   * restrict this to rotations that leave their distribution invariant.
+   *
+   * \param[inout] position Position that is rotated.
+   */
+  virtual void rotate_library_configuration(ThreeVector &position) const {
+    position.rotate(euler_phi_, euler_theta_, euler_psi_);
+  }
+
+  /**
+   * Write all parameters that determine the distribution of the nucleon
+   * positions to a stream. They are hashed to decide whether a configuration
+   * library stored in a file can be reused.
+   *
+   * \param[out] out Stream to which the parameters are written.
+   */
+  virtual void write_library_parameters(std::ostream &out) const;
+
+ private:
+  /**
+   * Try to read the configuration library from a file.
+   *
+   * \param[in] file Path of the library file.
+   * \param[in] hash Hash of the nucleus parameters, which has to match the
+   *                 one stored in the file.
+   * \param[in] n_configurations Expected number of configurations.
+   * \return whether a matching library was read.
+   */
+  bool read_configuration_library(const std::string &file, sha256::Hash hash,
+                                  size_t n_configurations);
+
+  /**
+   * Write the configuration library to a file.
+   *
+   * \param[in] file Path of the library file.
+   * \param[in] hash Hash of the nucleus parameters.
+   * \throw runtime_error if the file cannot be written.
+   */
+  void write_configuration_library(const std::string &file,
+                                   sha256::Hash hash) const;
 
  public:
   /// For iterators over the particle list:
@@ -71,7 +71,8 @@ class OutputInterface {
   explicit OutputInterface(std::string name)
       : is_dilepton_output_(name == "Dileptons"),
         is_photon_output_(name == "Photons"),
-        is_IC_output_(name == "SMASH_IC") {}
+        is_IC_output_(name == "SMASH_IC"),
+        is_collision_output_(name == "Collisions") {}
   virtual ~OutputInterface() = default;
 
   /**
@@ -176,6 +177,9 @@ class OutputInterface {
   /// Get, whether this is the IC output?
   bool is_IC_output() const { return is_IC_output_; }
 
+  /// Get, whether this output writes the collision history?
+  bool is_collision_output() const { return is_collision_output_; }
+
   /**
    * Convert thermodynamic quantities to strings.
    * \param[in] tq Enum value of the thermodynamic quantity.
@@ -233,6 +237,9 @@ class OutputInterface {
 
   /// Is this the IC output?
   const bool is_IC_output_;
+
+  /// Does this output write the collision history?
+  const bool is_collision_output_;
 };
 
 }  // namespace smash
@@ -8,6 +8,7 @@
 #define SRC_INCLUDE_SMASH_OUTPUTPARAMETERS_H_
 
 #include <set>
+#include <stdexcept>
 #include <string>
 
 #include "configuration.h"
@@ -39,7 +40,15 @@ struct OutputParameters {
         coll_printstartend(false),
         dil_extended(false),
         photons_extended(false),
-        ic_extended(false) {}
+        ic_extended(false),
+        hepmc_direct(false),
+        vtk_compression(false),
+        root_buffer_size(500000),
+        root_basket_size(32000),
+        root_auto_flush(-30000000),
+        root_compression_algorithm(-1),
+        root_compression_level(-1),
+        root_threaded_fill(false) {}
 
   /// Constructor from configuration
   explicit OutputParameters(Configuration&& conf) : OutputParameters() {
@@ -89,6 +98,35 @@ struct OutputParameters {
     if (conf.has_value({"Initial_Conditions"})) {
       ic_extended = conf.take({"Initial_Conditions", "Extended"}, false);
     }
+
+    if (conf.has_value({"HepMC"})) {
+      hepmc_direct = conf.take({"HepMC", "Direct_Writer"}, false);
+    }
+
+    vtk_compression = conf.take({"VTK_Compression"}, false);
+
+    root_buffer_size = conf.take({"Root_Buffer_Size"}, root_buffer_size);
+    root_basket_size = conf.take({"Root_Basket_Size"}, root_basket_size);
+    root_auto_flush = conf.take({"Root_Auto_Flush"}, root_auto_flush);
+    if (conf.has_value({"Root_Compression_Algorithm"})) {
+      const std::string algorithm = conf.take({"Root_Compression_Algorithm"});
+      // numbering of ROOT::RCompressionSetting::EAlgorithm
+      if (algorithm == "zlib") {
+        root_compression_algorithm = 1;
+      } else if (algorithm == "lzma") {
+        root_compression_algorithm = 2;
+      } else if (algorithm == "lz4") {
+        root_compression_algorithm = 4;
+      } else if (algorithm == "zstd") {
+        root_compression_algorithm = 5;
+      } else {
+        throw std::invalid_argument("Unknown ROOT compression algorithm \"" +
+                                    algorithm + "\".");
+      }
+    }
+    root_compression_level =
+        conf.take({"Root_Compression_Level"}, root_compression_level);
+    root_threaded_fill = conf.take({"Root_Threaded_Fill"}, false);
   }
 
   /**
@@ -158,6 +196,30 @@ struct OutputParameters {
 
   /// Extended initial conditions output
   bool ic_extended;
+
+  /// Write the HepMC event record directly instead of building a GenEvent
+  bool hepmc_direct;
+
+  /// Compress the binary data arrays of the XML VTK output
+  bool vtk_compression;
+
+  /// Maximal number of particles in one entry of the ROOT particles tree
+  int root_buffer_size;
+
+  /// Basket size of the ROOT branches [bytes]
+  int root_basket_size;
+
+  /// Auto-flush setting of the ROOT trees, see TTree::SetAutoFlush
+  int root_auto_flush;
+
+  /// ROOT compression algorithm, -1 for the default of the ROOT installation
+  int root_compression_algorithm;
+
+  /// ROOT compression level, -1 for the default of the ROOT installation
+  int root_compression_level;
+
+  /// Fill the ROOT trees from a background thread
+  bool root_threaded_fill;
 };
 
 }  // namespace smash
@@ -7,6 +7,8 @@
 #ifndef SRC_INCLUDE_SMASH_PARTICLES_H_
 #define SRC_INCLUDE_SMASH_PARTICLES_H_
 
+#include <cstdint>
+#include <map>
 #include <memory>
 #include <type_traits>
 #include <vector>
@@ -108,6 +110,56 @@ class Particles {
    */
   void reset();
 
+  /**
+   * Reorder the stored particles along a Morton (Z-order) space-filling curve
+   * of their positions and compact away all holes.
+   *
+   * The positions are mapped onto a cubic lattice with cells of size
+   * \p cell_length and the particles are sorted by the bit-interleaved cell
+   * coordinates. Particles that are close in space are thus also close in
+   * memory, which improves cache locality of the grid based action search.
+   * The particle ids and id_process are unchanged, but the storage index of
+   * every particle may change. Therefore all ParticleData copies taken
+   * before the call become invalid for Particles::is_valid and
+   * Particles::lookup; the function must only be called when no actions
+   * referring to the stored particles are pending.
+   *
+   * \param[in] cell_length Edge length of the lattice cells used for the
+   *            sorting key [fm]. Has to be positive.
+   */
+  void reorder_spatially(double cell_length);
+
+  class Snapshot;
+
+  /**
+   * Take a snapshot of the current particles without copying them.
+   *
+   * Until the snapshot is released, the original state of every storage
+   * slot is saved right before it is modified for the first time by
+   * insert(), create(), remove(), replace() or update_particle(). The
+   * returned Snapshot combines these saved states with the unmodified
+   * entries of data_, so it yields the same particles in the same order as
+   * copy_to_vector() at the time of the call, while only the changed
+   * particles are copied. Changes made through the iterators are not
+   * tracked. The snapshot is released when the returned Snapshot is
+   * destroyed. Taking a snapshot releases the previous one; reset() and
+   * reorder_spatially() release it, too.
+   *
+   * \return View of the particles as they are now, which must not outlive
+   *         this Particles object
+   */
+  Snapshot take_snapshot();
+
+  /// Release the current snapshot and discard the saved particle states.
+  void release_snapshot();
+
+  /**
+   * \return Number of the current snapshot generation. It is increased
+   *         whenever a snapshot is taken or released, so a Snapshot is only
+   *         valid as long as its generation is the current one.
+   */
+  uint64_t snapshot_generation() const { return snapshot_generation_; }
+
   /**
    * Check whether the ParticleData copy is still a valid copy of the one
    * stored in the Particles object.
@@ -176,6 +228,7 @@ class Particles {
                                       const ParticleData &new_state) {
     assert(is_valid(p));
     assert(p.type() == new_state.type());
+    save_for_snapshot(p.index_);
     ParticleData &original = data_[p.index_];
     new_state.copy_to(original);
     return original;
@@ -355,6 +408,158 @@ class Particles {
   /// An alias to the GenericIterator class of const ParticleData
   using const_iterator = GenericIterator<const ParticleData>;
 
+  /**
+   * Read-only view of the particles at the time Particles::take_snapshot was
+   * called. It implements a forward range over const ParticleData objects.
+   *
+   * The view owns the snapshot: it releases it when it is destroyed, unless
+   * the snapshot was released or replaced before.
+   */
+  class Snapshot {
+    friend class Particles;
+
+   public:
+    /// Cannot be copied, since only one view may release the snapshot.
+    Snapshot(const Snapshot &) = delete;
+    /// Cannot be copied, since only one view may release the snapshot.
+    Snapshot &operator=(const Snapshot &) = delete;
+    /**
+     * Move constructor. The moved-from view does not release the snapshot
+     * anymore.
+     *
+     * \param[in] other View that is moved from
+     */
+    Snapshot(Snapshot &&other)
+        : particles_(other.particles_), generation_(other.generation_) {
+      other.particles_ = nullptr;
+    }
+    /// Release the snapshot, if it is still the current one.
+    ~Snapshot() {
+      if (particles_ != nullptr && is_current()) {
+        particles_->release_snapshot();
+      }
+    }
+
+    /**
+     * Iterator over the particles of the snapshot. It walks over the storage
+     * slots that existed when the snapshot was taken and yields the saved
+     * original state for the slots that were modified since then.
+     */
+    class const_iterator
+        : public std::iterator<std::forward_iterator_tag, const ParticleData> {
+      friend class Snapshot;
+
+     private:
+      /**
+       * Constructs an iterator pointing to storage slot \p index and skips
+       * the slots that were holes when the snapshot was taken.
+       *
+       * \param[in] particles The Particles object the snapshot belongs to
+       * \param[in] index Storage slot the iterator points to
+       * \param[in] saved First saved slot with an index of at least \p index
+       */
+      const_iterator(const Particles *particles, unsigned index,
+                     std::map<unsigned, ParticleData>::const_iterator saved)
+          : particles_(particles), index_(index), saved_(saved) {
+        skip_holes();
+      }
+
+      /// Advance to the next slot that was not a hole, if the current was.
+      void skip_holes() {
+        while (index_ < particles_->snapshot_size_ && operator*().hole_) {
+          advance();
+        }
+      }
+      /// Advance to the next slot.
+      void advance() {
+        if (saved_ != particles_->snapshot_originals_.end() &&
+            saved_->first == index_) {
+          ++saved_;
+        }
+        ++index_;
+      }
+
+      /// The Particles object the snapshot belongs to
+      const Particles *particles_;
+      /// Storage slot this iterator points to
+      unsigned index_;
+      /// First saved slot with an index of at least index_
+      std::map<unsigned, ParticleData>::const_iterator saved_;
+
+     public:
+      /// \return the particle as it was when the snapshot was taken.
+      const ParticleData &operator*() const {
+        if (saved_ != particles_->snapshot_originals_.end() &&
+            saved_->first == index_) {
+          return saved_->second;
+        }
+        return particles_->data_[index_];
+      }
+      /// \return pointer to the particle the iterator points to.
+      const ParticleData *operator->() const { return &operator*(); }
+
+      /// \return the iterator to the next particle of the snapshot.
+      const_iterator &operator++() {
+        advance();
+        skip_holes();
+        return *this;
+      }
+      /**
+       * Postfix variant of the above prefix increment operator.
+       *
+       * \return the iterator before increment.
+       */
+      const_iterator operator++(int) {
+        const_iterator old = *this;
+        operator++();
+        return old;
+      }
+
+      /// \return whether two iterators point to the same slot.
+      bool operator==(const const_iterator &rhs) const {
+        return index_ == rhs.index_;
+      }
+      /// \return whether two iterators point to different slots.
+      bool operator!=(const const_iterator &rhs) const {
+        return index_ != rhs.index_;
+      }
+    };
+
+    /// \return an iterator pointing to the first particle of the snapshot.
+    const_iterator begin() const {
+      assert(is_current());
+      return {particles_, 0u, particles_->snapshot_originals_.begin()};
+    }
+    /// \return an iterator pointing behind the last particle of the snapshot.
+    const_iterator end() const {
+      return {particles_, particles_->snapshot_size_,
+              particles_->snapshot_originals_.end()};
+    }
+
+    /**
+     * \return whether the snapshot has not been released yet. This is an
+     *         O(1) check of the snapshot generation.
+     */
+    bool is_current() const {
+      return generation_ == particles_->snapshot_generation_;
+    }
+
+   private:
+    /**
+     * Constructs the view of the current snapshot of \p particles.
+     *
+     * \param[in] particles The Particles object the snapshot belongs to
+     */
+    explicit Snapshot(Particles *particles)
+        : particles_(particles),
+          generation_(particles->snapshot_generation_) {}
+
+    /// The Particles object the snapshot belongs to
+    Particles *particles_;
+    /// Snapshot generation of particles_ this view belongs to
+    uint64_t generation_;
+  };
+
   /// \return a reference to the first particle in the list.
   ParticleData &front() { return *begin(); }
   /**
@@ -487,6 +692,31 @@ class Particles {
    * be reused when new particles are added.
    */
   std::vector<unsigned> dirty_;
+
+  /**
+   * \internal
+   * Save the state of storage slot \p index for the current snapshot unless
+   * it was saved already or did not exist when the snapshot was taken. This
+   * has to be called before the slot is modified.
+   *
+   * \param[in] index Storage slot which is going to be modified
+   */
+  void save_for_snapshot(unsigned index) {
+    if (unlikely(index < snapshot_size_)) {
+      snapshot_originals_.emplace(index, data_[index]);
+    }
+  }
+
+  /**
+   * \internal
+   * Number of storage slots (data_size_) when the current snapshot was taken.
+   * It is 0 if there is no snapshot.
+   */
+  unsigned snapshot_size_ = 0u;
+  /// \internal Original states of the slots modified since the snapshot
+  std::map<unsigned, ParticleData> snapshot_originals_;
+  /// \internal Generation of the current snapshot, see snapshot_generation()
+  uint64_t snapshot_generation_ = 0u;
 };
 
 }  // namespace smash
@@ -8,6 +8,7 @@
 #define SRC_INCLUDE_SMASH_PARTICLETYPE_H_
 
 #include <cassert>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -130,9 +131,12 @@ class ParticleType {
   ParticleType &operator=(const ParticleType &) = delete;
 
   /// move ctors are needed for std::sort
-  ParticleType(ParticleType &&) = default;
+  ParticleType(ParticleType &&);
   /// move ctors are needed for std::sort
-  ParticleType &operator=(ParticleType &&) = default;
+  ParticleType &operator=(ParticleType &&);
+
+  /// Destructor (defined out of line, where Tabulation is complete)
+  ~ParticleType();
 
   /// \return the DecayModes object for this particle type.
   const DecayModes &decay_modes() const;
@@ -391,6 +395,12 @@ class ParticleType {
    * Resonance mass sampling for 2-particle final state with one resonance
    * (type given by 'this') and one stable particle.
    *
+   * The masses are sampled from a Cauchy distribution and accepted according
+   * to the ratio of the full to the simple spectral function, which is
+   * tabulated once per particle type (see tabulate_spectral_functions). The
+   * maximum of the rejection sampling is taken from the tabulated running
+   * maximum of that ratio, so that no state is modified while sampling.
+   *
    * \param[in] mass_stable Mass of the stable particle.
    * \param[in] cms_energy center-of-mass energy of the 2-particle final state.
    * \param[in] L relative angular momentum of the final-state particles
@@ -414,6 +424,22 @@ class ParticleType {
                                                     const double cms_energy,
                                                     int L = 0) const;
 
+  /**
+   * Tabulate the ratio of the full to the simple spectral function (and its
+   * running maximum) for all unstable particle types. These tables are used
+   * by sample_resonance_mass and sample_resonance_masses. They are otherwise
+   * created on first use, but creating them at initialization ensures that
+   * the particle types are not modified anymore during the time evolution.
+   * This also initializes the normalization of the spectral functions and
+   * the tabulations of the decays. It is called at the start of SMASH and
+   * by sample_in_batches before sampling on several threads, since this
+   * state must not be initialized concurrently.
+   *
+   * Note that the particles and decay modes have to be initialized, otherwise
+   * calling this is undefined behavior.
+   */
+  static void tabulate_spectral_functions();
+
   /**
    * Prints out width and spectral function versus mass to the
    * standard output. This is useful for debugging and analysis.
@@ -641,10 +667,46 @@ class ParticleType {
   /// Container for the isospin multiplet information
   IsoParticleType *iso_multiplet_ = nullptr;
 
-  /// Maximum factor for single-res mass sampling, cf. sample_resonance_mass.
-  mutable double max_factor1_ = 1.;
-  /// Maximum factor for double-res mass sampling, cf. sample_resonance_masses.
-  mutable double max_factor2_ = 1.;
+  /**
+   * Tabulation of the ratio of the full to the simple spectral function,
+   * which is the acceptance weight in the resonance mass sampling.
+   * Mutable, because it is created at first use if it was not created by
+   * tabulate_spectral_functions. The creation is not synchronized, so it must
+   * not happen during concurrent sampling.
+   */
+  mutable std::unique_ptr<Tabulation> sf_ratio_tabulation_;
+  /**
+   * Running maximum of sf_ratio_tabulation_, which is used as the maximum for
+   * the rejection sampling of resonance masses.
+   */
+  mutable std::unique_ptr<Tabulation> sf_ratio_max_tabulation_;
+
+  /// Create sf_ratio_tabulation_ and sf_ratio_max_tabulation_, if needed.
+  void tabulate_spectral_function_ratio() const;
+
+  /**
+   * Ratio of the full to the simple spectral function.
+   *
+   * Within the tabulated mass range, the tabulated ratio is used, otherwise
+   * it is evaluated directly.
+   *
+   * \param[in] m Actual off-shell mass of the resonance.
+   * \return spectral_function(m) / spectral_function_simple(m)
+   */
+  double spectral_function_ratio(double m) const;
+
+  /**
+   * Upper bound of spectral_function_ratio between min_mass_spectral and
+   * a given mass.
+   *
+   * Within the tabulated mass range, this is exact. Beyond it, the ratio is
+   * assumed to be maximal at the largest mass (which is the case for all
+   * known resonances, since the ratio grows with the mass-dependent width).
+   *
+   * \param[in] m_max Largest mass to consider.
+   * \return maximum of the ratio of full to simple spectral function
+   */
+  double spectral_function_ratio_max(double m_max) const;
 
   /**\ingroup logging
    * Writes all information about the particle type to the output stream.
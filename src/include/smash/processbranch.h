@@ -7,8 +7,11 @@
 #ifndef SRC_INCLUDE_SMASH_PROCESSBRANCH_H_
 #define SRC_INCLUDE_SMASH_PROCESSBRANCH_H_
 
+#include <algorithm>
+#include <array>
 #include <iostream>
 #include <memory>
+#include <stdexcept>
 #include <utility>
 #include <vector>
 
@@ -105,6 +108,53 @@ bool is_string_soft_process(ProcessType p);
  */
 std::ostream &operator<<(std::ostream &os, ProcessType process_type);
 
+/**
+ * \ingroup data
+ *
+ * Read-only view of the particle types of a ProcessBranch. It points into
+ * the storage of the branch, so it does not allocate memory, but it is only
+ * valid as long as the branch is.
+ */
+class ParticleTypePtrView {
+ public:
+  /**
+   * Construct a view of a range of particle types.
+   * \param[in] first Pointer to the first particle type
+   * \param[in] last Pointer past the last particle type
+   */
+  ParticleTypePtrView(const ParticleTypePtr *first,
+                      const ParticleTypePtr *last)
+      : first_(first), last_(last) {}
+
+  /// \return pointer to the first particle type
+  const ParticleTypePtr *begin() const { return first_; }
+  /// \return pointer past the last particle type
+  const ParticleTypePtr *end() const { return last_; }
+  /// \return number of particle types
+  std::size_t size() const { return last_ - first_; }
+  /// \return particle type \p i
+  const ParticleTypePtr &operator[](std::size_t i) const { return first_[i]; }
+  /**
+   * \return particle type \p i
+   * \throw out_of_range if \p i is not smaller than size()
+   */
+  const ParticleTypePtr &at(std::size_t i) const {
+    if (i >= size()) {
+      throw std::out_of_range("ParticleTypePtrView: index out of range");
+    }
+    return first_[i];
+  }
+
+  /// \return a list of copies of the particle types
+  operator ParticleTypePtrList() const { return {first_, last_}; }
+
+ private:
+  /// Pointer to the first particle type
+  const ParticleTypePtr *first_;
+  /// Pointer past the last particle type
+  const ParticleTypePtr *last_;
+};
+
 /**
  * \ingroup data
  *
@@ -162,8 +212,11 @@ class ProcessBranch {
   /// \return the process type
   virtual ProcessType get_type() const = 0;
 
-  /// \return the particle types associated with this branch.
-  virtual const ParticleTypePtrList &particle_types() const = 0;
+  /**
+   * \return a view of the particle types associated with this branch, which
+   *         is only valid as long as the branch is.
+   */
+  virtual ParticleTypePtrView particle_types() const = 0;
 
   /**
    * \return a list of ParticleData initialized with the stored ParticleType
@@ -234,10 +287,10 @@ class CollisionBranch : public ProcessBranch {
    * \param[in] p_type Process type of created branch.
    */
   CollisionBranch(const ParticleType &type, double w, ProcessType p_type)
-      : ProcessBranch(w), process_type_(p_type) {
-    particle_types_.reserve(1);
-    particle_types_.push_back(&type);
-  }
+      : ProcessBranch(w),
+        particle_types_{{&type}},
+        particle_number_(1),
+        process_type_(p_type) {}
   /**
    * Construct collision branch with 2 particles in final state.
    * \param[in] type_a Particle types of one final state particle.
@@ -247,11 +300,10 @@ class CollisionBranch : public ProcessBranch {
    */
   CollisionBranch(const ParticleType &type_a, const ParticleType &type_b,
                   double w, ProcessType p_type)
-      : ProcessBranch(w), process_type_(p_type) {
-    particle_types_.reserve(2);
-    particle_types_.push_back(&type_a);
-    particle_types_.push_back(&type_b);
-  }
+      : ProcessBranch(w),
+        particle_types_{{&type_a, &type_b}},
+        particle_number_(2),
+        process_type_(p_type) {}
 
   /**
    * Construct collision branch with 3 particles in final state.
@@ -263,30 +315,37 @@ class CollisionBranch : public ProcessBranch {
    */
   CollisionBranch(const ParticleType &type_a, const ParticleType &type_b,
                   const ParticleType &type_c, double w, ProcessType p_type)
-      : ProcessBranch(w), process_type_(p_type) {
-    particle_types_.reserve(3);
-    particle_types_.push_back(&type_a);
-    particle_types_.push_back(&type_b);
-    particle_types_.push_back(&type_c);
-  }
+      : ProcessBranch(w),
+        particle_types_{{&type_a, &type_b, &type_c}},
+        particle_number_(3),
+        process_type_(p_type) {}
 
   /**
    * Construct collision branch with a list of particles in final state.
    * \param[in] new_types List of particle types of final state particles.
    * \param[in] w Weight of created branch.
    * \param[in] p_type Process type of created branch.
+   * \throw invalid_argument if there are more than max_particles types
    */
-  CollisionBranch(ParticleTypePtrList new_types, double w, ProcessType p_type)
+  CollisionBranch(const ParticleTypePtrList &new_types, double w,
+                  ProcessType p_type)
       : ProcessBranch(w),
-        particle_types_(std::move(new_types)),
-        process_type_(p_type) {}
-  /// The move constructor efficiently moves the particle-type list member.
+        particle_number_(new_types.size()),
+        process_type_(p_type) {
+    if (new_types.size() > max_particles) {
+      throw std::invalid_argument(
+          "CollisionBranch: too many particles in the final state");
+    }
+    std::copy(new_types.begin(), new_types.end(), particle_types_.begin());
+  }
+  /// The move constructor copies the stored particle types.
   CollisionBranch(CollisionBranch &&rhs)
       : ProcessBranch(rhs.branch_weight_),
-        particle_types_(std::move(rhs.particle_types_)),
+        particle_types_(rhs.particle_types_),
+        particle_number_(rhs.particle_number_),
         process_type_(rhs.process_type_) {}
-  const ParticleTypePtrList &particle_types() const override {
-    return particle_types_;
+  ParticleTypePtrView particle_types() const override {
+    return {particle_types_.data(), particle_types_.data() + particle_number_};
   }
   /**
    * Set the process type
@@ -297,13 +356,22 @@ class CollisionBranch : public ProcessBranch {
   /// \return type of the process
   inline ProcessType get_type() const override { return process_type_; }
   /// \return number of particles involved in the process
-  unsigned int particle_number() const override {
-    return particle_types_.size();
-  }
+  unsigned int particle_number() const override { return particle_number_; }
+
+  /// Maximal number of particles in the final state of a collision branch
+  static constexpr unsigned int max_particles = 3;
 
  private:
-  /// List of particles appearing in this process outcome.
-  ParticleTypePtrList particle_types_;
+  /**
+   * Types of the particles appearing in this process outcome. They are
+   * stored in place, so that creating a branch does not allocate memory for
+   * them, which matters because many branches are created for every
+   * collision but only the chosen one is turned into particles. The entries
+   * past particle_number_ are invalid (null) pointers.
+   */
+  std::array<ParticleTypePtr, max_particles> particle_types_{};
+  /// Number of particles appearing in this process outcome.
+  unsigned int particle_number_ = 0;
 
   /**
    * Process type are used to distinguish different types of processes,
@@ -339,8 +407,9 @@ class DecayBranch : public ProcessBranch {
       : ProcessBranch(rhs.branch_weight_), type_(rhs.type_) {}
   /// \return the quantized angular momentum of this branch.
   inline int angular_momentum() const { return type_.angular_momentum(); }
-  const ParticleTypePtrList &particle_types() const override {
-    return type_.particle_types();
+  ParticleTypePtrView particle_types() const override {
+    const ParticleTypePtrList &types = type_.particle_types();
+    return {types.data(), types.data() + types.size()};
   }
   unsigned int particle_number() const override {
     return type_.particle_number();
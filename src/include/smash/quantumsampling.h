@@ -13,6 +13,7 @@
 #include <gsl/gsl_multiroots.h>
 #include <gsl/gsl_vector.h>
 #include <map>
+#include <vector>
 
 #include "smash/pdgcode.h"
 #include "smash/random.h"
@@ -148,7 +149,17 @@ class QuantumSampling {
    * \param[in] pdg the pdg code of the sampled particle species
    * return the sampled momentum [GeV]
    */
-  double sample(const PdgCode pdg);
+  double sample(const PdgCode pdg) const;
+
+  /**
+   * Sampling radial momenta of many particles of one species. The properties
+   * of the species are looked up only once.
+   * \param[in] pdg the pdg code of the sampled particle species
+   * \param[out] momenta all entries are filled with sampled momenta [GeV]
+   * \param[in,out] rng Random number engine; the common engine by default
+   */
+  void sample(const PdgCode pdg, std::vector<double>& momenta,
+              random::Engine& rng = random::engine) const;
 
  private:
   /// Tabulated effective chemical potentials for every particle species
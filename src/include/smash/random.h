@@ -83,10 +83,11 @@ inline Engine::result_type advance() { return engine(); }
  *
  * \param min Minimal sampled value.
  * \param max Maximal sampled value.
+ * \param rng Random number engine; the common engine by default.
  */
 template <typename T>
-T uniform(T min, T max) {
-  return std::uniform_real_distribution<T>(min, max)(engine);
+T uniform(T min, T max, Engine &rng = engine) {
+  return std::uniform_real_distribution<T>(min, max)(rng);
 }
 
 /**
@@ -108,21 +109,23 @@ T uniform_int(T min, T max) {
  *
  * https://gcc.gnu.org/bugzilla/show_bug.cgi?id=64351
  * https://llvm.org/bugs/show_bug.cgi?id=18767
+ *
+ * \param rng Random number engine; the common engine by default.
  */
 template <typename T = double>
-T canonical() {
-  return std::generate_canonical<T, std::numeric_limits<double>::digits>(
-      engine);
+T canonical(Engine &rng = engine) {
+  return std::generate_canonical<T, std::numeric_limits<double>::digits>(rng);
 }
 
 /**
  * \return A uniformly distributed random number \f$\chi \in (0,1]\f$.
+ * \param rng Random number engine; the common engine by default.
  */
 template <typename T = double>
-T canonical_nonzero() {
+T canonical_nonzero(Engine &rng = engine) {
   // use 'nextafter' to generate a value that is guaranteed to be larger than 0
   return std::nextafter(
-      std::generate_canonical<T, std::numeric_limits<double>::digits>(engine),
+      std::generate_canonical<T, std::numeric_limits<double>::digits>(rng),
       T(1));
 }
 
@@ -301,16 +304,17 @@ class discrete_dist {
  * sharpness of the peak.
  * \param min Minimum value to be returned.
  * \param max Maximum value to be returned.
+ * \param rng Random number engine; the common engine by default.
  * \return Sampled random number.
  */
 template <typename T = double>
-T cauchy(T pole, T width, T min, T max) {
+T cauchy(T pole, T width, T min, T max, Engine &rng = engine) {
   /* Use double-precision variables, in order to work around a glibc bug in
    * tanf:
    * https://sourceware.org/bugzilla/show_bug.cgi?id=18221 */
   const double u_min = std::atan((min - pole) / width);
   const double u_max = std::atan((max - pole) / width);
-  const double u = uniform(u_min, u_max);
+  const double u = uniform(u_min, u_max, rng);
   return pole + width * std::tan(u);
 }
 
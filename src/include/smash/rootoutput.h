@@ -10,8 +10,11 @@
 #ifndef SRC_INCLUDE_SMASH_ROOTOUTPUT_H_
 #define SRC_INCLUDE_SMASH_ROOTOUTPUT_H_
 
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <boost/filesystem.hpp>
@@ -88,7 +91,10 @@ class RootOutput : public OutputInterface {
   RootOutput(const bf::path &path, const std::string &name,
              const OutputParameters &out_par);
 
-  /// Destructor
+  /**
+   * Destructor. Waits for the background filling to finish (if enabled) and
+   * writes the trees to the file.
+   */
   ~RootOutput();
 
   /**
@@ -141,14 +147,14 @@ class RootOutput : public OutputInterface {
    * TFile takes ownership of all TTrees.
    * That's why TTree is not a unique pointer.
    */
-  TTree *particles_tree_;
+  TTree *particles_tree_ = nullptr;
   /**
    * TTree for collision output.
    *
    * TFile takes ownership of all TTrees.
    * That's why TTree is not a unique pointer.
    */
-  TTree *collisions_tree_;
+  TTree *collisions_tree_ = nullptr;
   /**
    * Writes particles to a tree defined by treename.
    * \param[in] particles Particles or ParticleList to be written to output.
@@ -174,35 +180,20 @@ class RootOutput : public OutputInterface {
    * Maximal buffer size.
    * When the number of particles N exceeds the buffer size B, data is flushed
    * to the ROOT file every B particles. This creates ceil(N/B) entries in the
-   * ROOT Tree at every output.
+   * ROOT Tree at every output. The buffers themselves start small and grow
+   * up to this size as needed.
    */
-  static const int max_buffer_size_;
+  const int max_buffer_size_;
 
   /** @name Buffer for filling TTree
    * See class documentation for definitions.
    */
   //@{
   /// Property that is written to ROOT output.
-  std::vector<double> p0_ = std::vector<double>(max_buffer_size_, 0.0);
-  std::vector<double> px_ = std::vector<double>(max_buffer_size_, 0.0);
-  std::vector<double> py_ = std::vector<double>(max_buffer_size_, 0.0);
-  std::vector<double> pz_ = std::vector<double>(max_buffer_size_, 0.0);
-  std::vector<double> t_ = std::vector<double>(max_buffer_size_, 0.0);
-  std::vector<double> x_ = std::vector<double>(max_buffer_size_, 0.0);
-  std::vector<double> y_ = std::vector<double>(max_buffer_size_, 0.0);
-  std::vector<double> z_ = std::vector<double>(max_buffer_size_, 0.0);
-  std::vector<double> formation_time_ =
-      std::vector<double>(max_buffer_size_, 0.0);
-  std::vector<double> xsec_factor_ = std::vector<double>(max_buffer_size_, 0.0);
-  std::vector<double> time_last_coll_ =
-      std::vector<double>(max_buffer_size_, 0.0);
-  std::vector<int> pdgcode_ = std::vector<int>(max_buffer_size_, 0);
-  std::vector<int> charge_ = std::vector<int>(max_buffer_size_, 0);
-  std::vector<int> coll_per_part_ = std::vector<int>(max_buffer_size_, 0);
-  std::vector<int> proc_id_origin_ = std::vector<int>(max_buffer_size_, 0);
-  std::vector<int> proc_type_origin_ = std::vector<int>(max_buffer_size_, 0);
-  std::vector<int> pdg_mother1_ = std::vector<int>(max_buffer_size_, 0);
-  std::vector<int> pdg_mother2_ = std::vector<int>(max_buffer_size_, 0);
+  std::vector<double> p0_, px_, py_, pz_, t_, x_, y_, z_;
+  std::vector<double> formation_time_, xsec_factor_, time_last_coll_;
+  std::vector<int> pdgcode_, charge_, coll_per_part_, proc_id_origin_,
+      proc_type_origin_, pdg_mother1_, pdg_mother2_;
   int npart_, tcounter_, ev_, nin_, nout_, test_p_;
   double wgt_, par_wgt_, impact_b_, modus_l_, current_t_;
   double E_kinetic_tot_, E_fields_tot_, E_tot_;
@@ -239,11 +230,61 @@ class RootOutput : public OutputInterface {
   /// Whether extended ic output is on
   const bool ic_extended_;
 
+  /// Size of the baskets of all branches [bytes]
+  const int basket_size_;
+
+  /// Auto-flush setting of the trees, see TTree::SetAutoFlush
+  const int auto_flush_;
+
   /**
    * Basic initialization routine, creating the TTree objects
    * for particles and collisions.
    */
   void init_trees();
+
+  /**
+   * Grow the array buffers such that they hold at least \p n particles and
+   * point the array branches of the trees to the new memory.
+   *
+   * \param[in] n Required number of particles in one tree entry.
+   */
+  void ensure_buffer_size(size_t n);
+
+  /**
+   * Set the addresses of all existing array branches of a tree to the
+   * current buffers.
+   *
+   * \param[in] tree Tree whose branches are updated.
+   */
+  void set_array_addresses(TTree *tree);
+
+  /**
+   * Fill the current content of the buffers into a tree. With threaded
+   * filling this only hands the tree over to the background thread and the
+   * buffers must not be modified before wait_for_fill returns.
+   *
+   * \param[in] tree Tree to be filled.
+   */
+  void fill(TTree *tree);
+
+  /// Block until the background thread has filled the last entry.
+  void wait_for_fill();
+
+  /// Main loop of the background thread filling the trees.
+  void fill_loop();
+
+  /// Whether the trees are filled by a background thread
+  const bool threaded_fill_;
+  /// Background thread filling the trees
+  std::thread fill_thread_;
+  /// Mutex protecting the hand-over of trees to the background thread
+  std::mutex fill_mutex_;
+  /// Signals a new tree to fill, the end of filling or a stop request
+  std::condition_variable fill_condition_;
+  /// Tree to be filled by the background thread, nullptr if idle
+  TTree *tree_to_fill_ = nullptr;
+  /// Whether the background thread should terminate
+  bool stop_fill_thread_ = false;
 };
 
 }  // namespace smash
@@ -71,6 +71,37 @@ class ScatterActionMulti : public Action {
    */
   const CollisionBranchList& reaction_channels() { return reaction_channels_; }
 
+  /**
+   * Integrate the three-body phase-space integral \f$I_3\f$ numerically, see
+   * calculate_I3() for the definition.
+   *
+   * \param[in] sqrts center of mass energy of the three particles [GeV]
+   * \param[in] m1 mass of the first particle [GeV]
+   * \param[in] m2 mass of the second particle [GeV]
+   * \param[in] m3 mass of the third particle [GeV]
+   * \return result of the integral [GeV\f$^4\f$]
+   */
+  static double integrate_I3(double sqrts, double m1, double m2, double m3);
+
+  /**
+   * Interpolate the three-body phase-space integral \f$I_3\f$ from a
+   * tabulation for the given masses.
+   *
+   * The tabulation for a set of masses is created when it is needed for the
+   * first time. Since \f$I_3\f$ vanishes quadratically with the kinetic energy
+   * \f$Q = \sqrt{s} - m_1 - m_2 - m_3\f$ at the threshold, \f$I_3/Q^2\f$ is
+   * tabulated as a function of \f$Q\f$, which keeps the relative error of the
+   * linear interpolation small down to the threshold. Outside of the
+   * tabulated range the integral is calculated by integrate_I3().
+   *
+   * \param[in] sqrts center of mass energy of the three particles [GeV]
+   * \param[in] m1 mass of the first particle [GeV]
+   * \param[in] m2 mass of the second particle [GeV]
+   * \param[in] m3 mass of the third particle [GeV]
+   * \return result of the integral [GeV\f$^4\f$]
+   */
+  static double tabulated_I3(double sqrts, double m1, double m2, double m3);
+
   /**
    * \ingroup exception
    * Thrown when ScatterActionMulti is called to perform with unknown
@@ -178,6 +209,10 @@ class ScatterActionMulti : public Action {
    * outgoing particles in this case, since we are looking at the backreaction
    * to the 1-to-3 decay.
    *
+   * If the incoming particles are on their pole masses, which is the case for
+   * the stable pions, η and nucleons, the integral is interpolated from a
+   * tabulation (see tabulated_I3()); otherwise it is integrated directly.
+   *
    * \param[in] sqrts center of mass energy of incoming particles
    *                  (= mass of outgoing particle)
    * \return result of integral
@@ -228,6 +228,56 @@ class ScatterActionPhoton : public ScatterAction {
   /// Total hadronic cross section
   const double hadronic_cross_section_;
 
+  /**
+   * Kinematics and weight normalization of the photon final state that are
+   * the same for all fractional photons of one hadronic scattering.
+   */
+  struct FinalStateSetup {
+    /// Interaction point, where the outgoing particles are placed
+    FourVector middle_point;
+    /// Mandelstam s [GeV^2]
+    double s;
+    /// Center-of-mass energy [GeV]
+    double sqrts;
+    /// Lower limit of the sampled Mandelstam t [GeV^2]
+    double t1;
+    /// Upper limit of the sampled Mandelstam t [GeV^2]
+    double t2;
+    /// Squared mass of the second (non-pion) incoming particle [GeV^2]
+    double m2_sqr;
+    /// t-independent shift in the numerator of cos(theta) [GeV^2]
+    double costheta_shift;
+    /// Denominator of cos(theta) [GeV^2]
+    double costheta_norm;
+    /// Center-of-mass momentum of the outgoing particles [GeV]
+    double pcm_out;
+    /// Velocity of the center-of-mass frame of the outgoing particles
+    ThreeVector beta_cm;
+    /// Mass of the participating rho meson [GeV], see rho_mass()
+    double m_rho;
+    /// Number of fractional photons times the hadronic cross section [mb]
+    double weight_norm;
+    /// Product of the cross section scaling factors of the incoming particles
+    double xsec_scaling;
+  };
+
+  /**
+   * Select the photon process, set up the outgoing particles and compute
+   * the quantities shared by all fractional photons of this scattering.
+   * No random numbers are drawn here.
+   *
+   * \return Kinematics for sample_final_state()
+   */
+  FinalStateSetup setup_final_state();
+
+  /**
+   * Sample one photon / hadron pair and its weight for the given
+   * per-scattering setup.
+   *
+   * \param[in] setup Result of setup_final_state() for this action
+   */
+  void sample_final_state(const FinalStateSetup &setup);
+
   /**
    * Find the mass of the participating rho-particle.
    *
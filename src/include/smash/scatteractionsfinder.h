@@ -10,6 +10,7 @@
 #ifndef SRC_INCLUDE_SMASH_SCATTERACTIONSFINDER_H_
 #define SRC_INCLUDE_SMASH_SCATTERACTIONSFINDER_H_
 
+#include <cassert>
 #include <memory>
 #include <set>
 #include <vector>
@@ -21,6 +22,16 @@
 
 namespace smash {
 
+/// Output formats of the reaction and cross-section dumps
+enum class DumpFormat {
+  /// Human-readable table, as printed by default
+  Table,
+  /// Comma-separated values
+  CSV,
+  /// JSON document
+  JSON,
+};
+
 /**
  * \ingroup action
  * A simple scatter finder:
@@ -188,6 +199,10 @@ class ScatterActionsFinder : public ActionFinderInterface {
    * Search for all the possible secondary collisions between the outgoing
    * particles and the rest.
    *
+   * If periodic surroundings are enabled (see set_periodic_surroundings()),
+   * the surrounding particles are also searched in the neighboring images of
+   * the box.
+   *
    * \param[in] search_list A list of particles within the current cell
    * \param[in] surrounding_list The whole particle list
    * \param[in] dt The maximum time interval at the current time step [fm/c]
@@ -242,8 +257,15 @@ class ScatterActionsFinder : public ActionFinderInterface {
   /**
    * Prints out all the 2-> n (n > 1) reactions with non-zero cross-sections
    * between all possible pairs of particle types.
+   *
+   * The pairs can be distributed over several worker processes. The output
+   * does not depend on their number.
+   *
+   * \param[in] format Output format.
+   * \param[in] n_workers Number of worker processes.
    */
-  void dump_reactions() const;
+  void dump_reactions(DumpFormat format = DumpFormat::Table,
+                      int n_workers = 1) const;
 
   /**
    * Print out partial cross-sections of all processes that can occur in
@@ -257,10 +279,32 @@ class ScatterActionsFinder : public ActionFinderInterface {
    *                        printed.
    * \param[in] plab Optional momenta in lab frame to be evaluated [GeV].
    *                 Ignored if empty.
+   * \param[in] format Output format.
+   * \param[in] n_workers Number of worker processes, over which the momenta
+   *                      are distributed. The output does not depend on it.
    */
   void dump_cross_sections(const ParticleType &a, const ParticleType &b,
                            double m_a, double m_b, bool final_state,
-                           std::vector<double> &plab) const;
+                           std::vector<double> &plab,
+                           DumpFormat format = DumpFormat::Table,
+                           int n_workers = 1) const;
+
+  /**
+   * Enable or disable the search for collisions through the walls of the box
+   * in find_actions_with_surrounding_particles().
+   *
+   * Without wall-crossing actions, particles are wrapped into the box without
+   * another search for their collision partners on the other side of the
+   * wall. Searching the neighboring images of the box for newly produced
+   * particles finds these collisions at the same times.
+   *
+   * \param[in] periodic Whether to search the neighboring images of the box.
+   *            Requires a positive box length.
+   */
+  void set_periodic_surroundings(bool periodic) {
+    assert(!periodic || box_length_ > 0.);
+    periodic_surroundings_ = periodic;
+  }
 
   /**
    * \return Pointer to the string process class object.
@@ -365,6 +409,8 @@ class ScatterActionsFinder : public ActionFinderInterface {
    * Ignored if negative.
    */
   const double box_length_;
+  /// Search the neighboring images of the box for surrounding particles.
+  bool periodic_surroundings_ = false;
   /**
    * Parameter to record whether the nucleon has experienced a collision or not.
    */
@@ -131,6 +131,8 @@ class SphereModus : public ModusDefault {
    * Initial momentum of the jet particle; only used if insert_jet_ is true
    */
   const double jet_mom_;
+  /// Number of threads used to sample the initial momenta and positions
+  const int sampling_threads_;
   /**\ingroup logging
    * Writes the initial state for the Sphere to the output stream.
    *
@@ -47,6 +47,28 @@ void isoclean(std::string &s);
  */
 std::vector<std::string> split(const std::string &s, char delim);
 
+/**
+ * Quote a string as a field of a CSV file, if necessary.
+ *
+ * Fields containing a comma, a double quote or a line break are enclosed in
+ * double quotes, and double quotes inside them are doubled (RFC 4180).
+ *
+ * \param[in] s String to be quoted.
+ * \return CSV field.
+ */
+std::string quote_csv(const std::string &s);
+
+/**
+ * Quote a string as a JSON string literal.
+ *
+ * Double quotes, backslashes and control characters are escaped. Other
+ * characters, including multi-byte UTF-8 sequences, are kept as they are.
+ *
+ * \param[in] s String to be quoted.
+ * \return JSON string including the enclosing double quotes.
+ */
+std::string quote_json(const std::string &s);
+
 namespace utf8 {
 /**
  * Fill string with characters to the left until the given width is reached.
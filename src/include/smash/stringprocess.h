@@ -10,9 +10,13 @@
 #ifndef SRC_INCLUDE_SMASH_STRINGPROCESS_H_
 #define SRC_INCLUDE_SMASH_STRINGPROCESS_H_
 
+#include <array>
+#include <cstdint>
+#include <cstdlib>
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -198,6 +202,191 @@ class StringProcess {
    */
   Pythia8::Event event_intermediate_;
 
+  /// A resonance which can be formed from a pair of string ends
+  struct ResonanceCandidate {
+    /// PDG id (decimal)
+    int pdgid;
+    /// Pole mass [GeV]
+    double mass_pole;
+    /// Minimum mass of the spectral function [GeV]
+    double mass_min;
+  };
+
+  /**
+   * Unstable hadrons for get_resonance_from_quark, grouped by their baryon
+   * number, isospin3, strangeness, charmness and bottomness (see
+   * quantum_number_key). Within a group, they are kept in the order of
+   * ParticleType::list_all(), on which the selection of the closest resonance
+   * depends.
+   */
+  std::unordered_map<uint64_t, std::vector<ResonanceCandidate>>
+      resonances_by_quantum_numbers_;
+
+  /// The hadrons which can be formed from a pair of string ends
+  struct HadronCandidates {
+    /// PDG ids (decimal), in the order of ParticleType::list_all()
+    std::vector<int> pdgids;
+    /**
+     * Running sum of the weights (spin degeneracy / pole mass), starting
+     * with 0. It has one element more than #pdgids.
+     */
+    std::vector<double> weight_summed;
+  };
+
+  /**
+   * Hadrons known to PYTHIA for get_hadrontype_from_quark, grouped in the same
+   * way as #resonances_by_quantum_numbers_.
+   */
+  std::unordered_map<uint64_t, HadronCandidates> hadrons_by_quantum_numbers_;
+
+  /**
+   * Pack the quantum numbers of a hadron into a key of
+   * #resonances_by_quantum_numbers_ and #hadrons_by_quantum_numbers_.
+   * \param[in] baryon baryon number
+   * \param[in] iso3 twice the isospin3
+   * \param[in] strange strangeness
+   * \param[in] charm charmness
+   * \param[in] bottom bottomness
+   * \return key for the given quantum numbers
+   */
+  static uint64_t quantum_number_key(int baryon, int iso3, int strange,
+                                     int charm, int bottom);
+
+  /// Properties of a quark or diquark, as given by PYTHIA
+  struct ConstituentProperties {
+    /// Whether PYTHIA knows the quark or diquark
+    bool valid = false;
+    /// Whether it is a diquark
+    bool is_diquark = false;
+    /// Baryon number times 3
+    int baryon_number_type = 0;
+    /// Nominal mass [GeV]
+    double mass = 0.;
+    /// Numbers of d, u, s, c and b quarks
+    std::array<int, 5> n_quarks = {{0, 0, 0, 0, 0}};
+  };
+
+  /**
+   * Properties of the quarks and diquarks (see constituent_index), which are
+   * looked up in the string fragmentation instead of querying the particle
+   * data of PYTHIA.
+   */
+  std::array<ConstituentProperties, 55> constituents_;
+
+  /// Width of the transverse momentum of string breaks (StringPT:sigma) [GeV]
+  double pythia_sigma_pt_ = 0.;
+  /**
+   * Mass below which a string breaks into two hadrons
+   * (StringFragmentation:stopMass) [GeV]
+   */
+  double pythia_stop_mass_ = 0.;
+  /// Relative smearing of the stop mass (StringFragmentation:stopSmear)
+  double pythia_stop_smear_ = 0.;
+  /**
+   * Probability of an enhanced transverse momentum width
+   * (StringPT:enhancedFraction)
+   */
+  double pythia_enhanced_fraction_ = 0.;
+  /// Factor of the enhanced width (StringPT:enhancedWidth)
+  double pythia_enhanced_width_ = 0.;
+
+  /**
+   * \param[in] pdgid non-negative PDG id
+   * \return index of a quark or diquark in #constituents_ or -1, if pdgid does
+   *         not have the form of a quark or diquark code
+   */
+  static int constituent_index(int pdgid) {
+    if (pdgid >= 1 && pdgid <= 5) {
+      return pdgid - 1;
+    }
+    const int q1 = pdgid / 1000;
+    const int q2 = (pdgid / 100) % 10;
+    const int spin = pdgid % 100;
+    if (pdgid < 1000 || q1 > 5 || q2 < 1 || q2 > q1 ||
+        (spin != 1 && spin != 3)) {
+      return -1;
+    }
+    return 5 + 2 * (5 * (q1 - 1) + q2 - 1) + (spin == 3);
+  }
+
+  /**
+   * \param[in] pdgid PDG id of a (anti)quark or (anti)diquark
+   * \return its properties, or a null pointer if PYTHIA does not know it as
+   *         a quark or diquark
+   */
+  const ConstituentProperties *find_constituent(int pdgid) const {
+    const int index = constituent_index(std::abs(pdgid));
+    if (index < 0 || !constituents_[index].valid) {
+      return nullptr;
+    }
+    return &constituents_[index];
+  }
+
+  /**
+   * Same as Pythia8::ParticleData::m0, but faster for quarks and diquarks.
+   * \param[in] pdgid PDG id
+   * \return nominal mass [GeV]
+   */
+  double constituent_mass(int pdgid) const {
+    const ConstituentProperties *constituent = find_constituent(pdgid);
+    return constituent ? constituent->mass
+                       : pythia_hadron_->particleData.m0(pdgid);
+  }
+
+  /**
+   * Same as Pythia8::ParticleData::baryonNumberType, but faster for quarks and
+   * diquarks.
+   * \param[in] pdgid PDG id
+   * \return baryon number times 3
+   */
+  int baryon_number_type(int pdgid) const {
+    const ConstituentProperties *constituent = find_constituent(pdgid);
+    if (!constituent) {
+      return pythia_hadron_->particleData.baryonNumberType(pdgid);
+    }
+    return pdgid > 0 ? constituent->baryon_number_type
+                     : -constituent->baryon_number_type;
+  }
+
+  /**
+   * Same as Pythia8::ParticleData::nQuarksInCode, but faster for quarks and
+   * diquarks.
+   * \param[in] pdgid non-negative PDG id
+   * \param[in] flavor quark flavor (1 to 5 for d, u, s, c and b)
+   * \return number of quarks of the given flavor
+   */
+  int n_quarks_in_code(int pdgid, int flavor) const {
+    const ConstituentProperties *constituent = find_constituent(pdgid);
+    return constituent
+               ? constituent->n_quarks[flavor - 1]
+               : pythia_hadron_->particleData.nQuarksInCode(pdgid, flavor);
+  }
+
+  /**
+   * Same as Pythia8::ParticleData::isDiquark, but faster for quarks and
+   * diquarks.
+   * \param[in] pdgid PDG id
+   * \return whether it is a (anti)diquark
+   */
+  bool is_diquark(int pdgid) const {
+    const ConstituentProperties *constituent = find_constituent(pdgid);
+    return constituent ? constituent->is_diquark
+                       : pythia_hadron_->particleData.isDiquark(pdgid);
+  }
+
+  /**
+   * Fill #constituents_ and the cached PYTHIA parameters. It requires
+   * #pythia_hadron_ to be initialized.
+   */
+  void cache_pythia_properties();
+
+  /**
+   * Sort the hadron species into #resonances_by_quantum_numbers_ and
+   * #hadrons_by_quantum_numbers_. It requires the particle types and decay
+   * modes to be set up and #pythia_hadron_ to be initialized.
+   */
+  void build_quantum_number_index();
+
  public:
   // clang-format off
 
@@ -1004,9 +1193,11 @@ class StringProcess {
    * Sample lightcone momentum fraction according to
    * the LUND fragmentation function.
    * \f$ f(z) = \frac{1}{z} (1 - z)^a \exp{ \left(- \frac{b m_T^2}{z} \right) } \f$
-   * \param[in] a parameter for the fragmentation function
-   * \param[in] b parameter for the fragmentation function
-   * \param[in] mTrn transverse mass of the fragmented hadron
+   * The envelope of the rejection sampling is adapted to the position of the
+   * maximum as in PYTHIA 8 \iref{Sjostrand:2014zea}.
+   * \param[in] a parameter for the fragmentation function (non-negative)
+   * \param[in] b parameter for the fragmentation function (positive)
+   * \param[in] mTrn transverse mass of the fragmented hadron (positive)
    * \return sampled lightcone momentum fraction
    */
   static double sample_zLund(double a, double b, double mTrn);
@@ -0,0 +1,51 @@
+/*
+ *
+ *    Copyright (c) 2020
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_SUBPROCESSES_H_
+#define SRC_INCLUDE_SMASH_SUBPROCESSES_H_
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace smash {
+
+/**
+ * Evaluate independent tasks in several worker processes.
+ *
+ * The tasks are numbered from 0 to \p n_tasks - 1. Worker \f$k\f$ evaluates
+ * the tasks \f$k, k + n, k + 2n, \dots\f$ for \f$n\f$ workers. Each worker is
+ * a forked copy of the calling process, so the tasks may use (and lazily
+ * initialize) any global state, like particle types and their tabulations,
+ * without synchronization. The workers write their results to temporary files,
+ * which are read after all workers have finished.
+ *
+ * The results are returned in the order of the tasks. As long as each task is
+ * deterministic, they are therefore independent of the number of workers. With
+ * a single worker, or a single task, everything is evaluated in the calling
+ * process.
+ *
+ * Since the tasks run in separate processes, changes to global state made by
+ * a task are not visible to the calling process or to the other tasks.
+ *
+ * \param[in] n_tasks Number of tasks.
+ * \param[in] n_workers Maximal number of worker processes.
+ * \param[in] task Function evaluating the task with the given number.
+ * \return Results of all tasks.
+ * \throws std::runtime_error if a worker could not be started or did not
+ *         finish successfully.
+ */
+std::vector<std::string> run_in_subprocesses(
+    size_t n_tasks, int n_workers,
+    const std::function<std::string(size_t)> &task);
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_SUBPROCESSES_H_
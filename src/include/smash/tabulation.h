@@ -96,6 +96,21 @@ class Tabulation {
   double get_value_linear(
       double x, Extrapolation extrapolation = Extrapolation::Linear) const;
 
+  /**
+   * Create a tabulation on the same grid, where each value is the maximum of
+   * all tabulated values up to and including the following tabulation point.
+   *
+   * Looking up a value of the result with get_value_step at \par x thus gives
+   * an upper bound of get_value_linear on the interval [x_min, x] (as long as
+   * x lies within the tabulated range).
+   *
+   * \return Tabulation of the running maximum.
+   */
+  Tabulation running_maximum() const;
+
+  /// \return upper bound of the tabulation domain
+  double x_max() const { return x_max_; }
+
   /**
    * Write a binary representation of the tabulation to a stream.
    *
@@ -10,8 +10,11 @@
 #ifndef SRC_INCLUDE_SMASH_VTKOUTPUT_H_
 #define SRC_INCLUDE_SMASH_VTKOUTPUT_H_
 
+#include <map>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <boost/filesystem.hpp>
 
@@ -22,6 +25,17 @@
 
 namespace smash {
 
+/// Flavors of the VTK file format written by VtkOutput
+enum class VtkFormat {
+  /// Legacy VTK files with ASCII data (.vtk)
+  Legacy,
+  /**
+   * XML VTK files with appended binary data (.vtu for particles, .vti for
+   * lattices) and a ParaView collection file (.pvd) per event
+   */
+  XmlBinary,
+};
+
 /**
  * \ingroup output
  * SMASH output in a paraview format, intended for simple visualization.
@@ -34,9 +48,11 @@ class VtkOutput : public OutputInterface {
    * \param path Path to the output file.
    * \param name Name of the output.
    * \param out_par Additional information on the configured output.
+   * \param format Flavor of the VTK files, see VtkFormat.
    */
   VtkOutput(const bf::path &path, const std::string &name,
-            const OutputParameters &out_par);
+            const OutputParameters &out_par,
+            VtkFormat format = VtkFormat::Legacy);
   ~VtkOutput();
 
   /**
@@ -51,9 +67,9 @@ class VtkOutput : public OutputInterface {
                      const EventInfo &event) override;
 
   /**
-   * Writes the final particle information list of an event to the VTK
-   * output. This currently does not do anything, because it is not
-   * required for the VTK output.
+   * Finishes the VTK output of an event. For the XML format the collection
+   * files listing all outputs of the event are written, for the legacy format
+   * nothing is done.
    *
    * \param particles Unused. Current list of particles.
    * \param event_number Unused. Number of event.
@@ -66,7 +82,8 @@ class VtkOutput : public OutputInterface {
    * Writes out all current particles.
    *
    * \param particles Current list of particles.
-   * \param clock Unused, needed since inherited.
+   * \param clock Clock of the output, which provides the time of the
+   *              snapshot for the collection files of the XML format.
    * \param dens_param Unused, needed since inherited.
    * \param event Event info, see \ref event_info
    */
@@ -108,6 +125,16 @@ class VtkOutput : public OutputInterface {
   void thermodynamics_output(const GrandCanThermalizer &gct) override;
 
  private:
+  /// Values of one quantity on all nodes of a lattice
+  struct LatticeField {
+    /// Name of the quantity
+    std::string name;
+    /// Number of components per node (1 for scalars, 3 for vectors)
+    int components;
+    /// Values with the x index running fastest
+    std::vector<double> values;
+  };
+
   /**
    * Write the given particles to the output.
    *
@@ -115,6 +142,23 @@ class VtkOutput : public OutputInterface {
    */
   void write(const Particles &particles);
 
+  /**
+   * Write the given particles to the output as legacy VTK file.
+   *
+   * \param particles The particles.
+   * \param filename Name of the file.
+   */
+  void write_legacy(const Particles &particles, const std::string &filename);
+
+  /**
+   * Write the given particles to the output as XML VTK unstructured grid
+   * with the data arrays appended in binary.
+   *
+   * \param particles The particles.
+   * \param filename Name of the file.
+   */
+  void write_xml(const Particles &particles, const std::string &filename);
+
   /**
    * Make a file name given a description and a counter.
    *
@@ -133,39 +177,52 @@ class VtkOutput : public OutputInterface {
                            const DensityType dens_type);
 
   /**
-   * Write the VTK header.
+   * Sample a scalar quantity on all nodes of the lattice.
    *
-   * \param file Output file.
    * \param lat Lattice corresponding to output.
-   * \param description Description of the output.
+   * \param varname Name of the output variable.
+   * \param function Function that gets the scalar given a lattice node.
+   * \return Field with one value per node.
    */
-  template <typename T>
-  void write_vtk_header(std::ofstream &file, RectangularLattice<T> &lat,
-                        const std::string &description);
+  template <typename T, typename F>
+  LatticeField lattice_scalar(RectangularLattice<T> &lat,
+                              const std::string &varname, F &&function);
 
   /**
-   * Write a VTK scalar.
+   * Sample a vector quantity on all nodes of the lattice.
    *
-   * \param file Output file.
    * \param lat Lattice corresponding to output.
    * \param varname Name of the output variable.
-   * \param function Function that gets the scalar given a lattice node.
+   * \param function Function that gets the vector given a lattice node.
+   * \return Field with three values per node.
    */
   template <typename T, typename F>
-  void write_vtk_scalar(std::ofstream &file, RectangularLattice<T> &lat,
-                        const std::string &varname, F &&function);
+  LatticeField lattice_vector(RectangularLattice<T> &lat,
+                              const std::string &varname, F &&function);
 
   /**
-   * Write a VTK vector.
+   * Write fields on a lattice into a new file, either as legacy VTK
+   * structured points or as XML VTK image data.
    *
-   * \param file Output file.
+   * \param description Description of the output, which also determines the
+   *                    file name.
+   * \param counter The counter enumerating the outputs of this description.
    * \param lat Lattice corresponding to output.
-   * \param varname Name of the output variable.
-   * \param function Function that gets the vector given a lattice node.
+   * \param fields Fields to be written.
    */
-  template <typename T, typename F>
-  void write_vtk_vector(std::ofstream &file, RectangularLattice<T> &lat,
-                        const std::string &varname, F &&function);
+  template <typename T>
+  void write_lattice(const std::string &description, int counter,
+                     RectangularLattice<T> &lat,
+                     const std::vector<LatticeField> &fields);
+
+  /**
+   * Remember a file written in the current event for the collection file.
+   *
+   * \param collection Name of the collection file without extension.
+   * \param filename Name of the data file.
+   */
+  void add_to_collection(const std::string &collection,
+                         const std::string &filename);
 
   /// filesystem path for output
   const bf::path base_path_;
@@ -187,6 +244,19 @@ class VtkOutput : public OutputInterface {
   int vtk_fluidization_counter_ = 0;
   /// Is the VTK output a thermodynamics output
   bool is_thermodynamics_output_;
+
+  /// Flavor of the written files
+  const VtkFormat format_;
+  /// Whether the binary data arrays of the XML format are compressed
+  bool compress_;
+  /// Time of the current output [fm/c]
+  double current_time_ = 0.;
+  /**
+   * Times and file names of the outputs in the current event, grouped by
+   * the collection file they belong to (XML format only)
+   */
+  std::map<std::string, std::vector<std::pair<double, std::string>>>
+      collections_;
 };
 
 }  // namespace smash
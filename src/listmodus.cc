@@ -43,14 +43,22 @@ static constexpr int LList = LogArea::List::id;
  * parameters are:
  *
  * \key File_Directory (string, required):\n
- * Directory for the external particle lists.
+ * Directory for the external particle lists. Only optional if SMASH is used
+ * as a library and the particles are passed from memory, see below.
  *
  * \key File_Prefix    (string, required):\n
- * Prefix for the external particle lists file.
+ * Prefix for the external particle lists file. Only optional if SMASH is used
+ * as a library and the particles are passed from memory, see below.
  *
- * \key Shift_Id (int, required):\n
+ * \key Shift_Id (int, optional, default = 0):\n
  * Starting id for file_id_, i.e. the first file which is read.
  *
+ * If SMASH is used as a library, the particles of every event can instead be
+ * passed from memory with ListModus::set_next_event and
+ * Experiment::run_event. File_Directory and File_Prefix are not needed then.
+ * If they are missing, an error is only raised when a particle list file is
+ * read, i.e. when an event is run without passing its particles.
+ *
  * \n
  * **Example: Configuring an Afterburner Simulation**\n
  * The following example sets up an afterburner simulation for a set of particle
@@ -114,11 +122,19 @@ static constexpr int LList = LogArea::List::id;
  */
 
 ListModus::ListModus(Configuration modus_config, const ExperimentParameters &)
-    : shift_id_(modus_config.take({"List", "Shift_Id"})) {
-  std::string fd = modus_config.take({"List", "File_Directory"});
+    : shift_id_(modus_config.take({"List", "Shift_Id"}, 0)) {
+  /* The files are not needed if the particles are passed with
+   * set_next_event, so missing keys are only reported when reading a file. */
+  for (const char *key : {"File_Directory", "File_Prefix"}) {
+    if (missing_file_key_.empty() && !modus_config.has_value({"List", key})) {
+      missing_file_key_ = key;
+    }
+  }
+  std::string fd =
+      modus_config.take({"List", "File_Directory"}, std::string());
   particle_list_file_directory_ = fd;
 
-  std::string fp = modus_config.take({"List", "File_Prefix"});
+  std::string fp = modus_config.take({"List", "File_Prefix"}, std::string());
   particle_list_file_prefix_ = fp;
 
   event_id_ = 0;
@@ -223,9 +239,38 @@ void ListModus::try_create_particle(Particles &particles, PdgCode pdgcode,
   }
 }
 
+void ListModus::set_next_event(ParticleList particles) {
+  next_event_particles_ = std::move(particles);
+  has_next_event_particles_ = true;
+}
+
 /* initial_conditions - sets particle data for @particles */
 double ListModus::initial_conditions(Particles *particles,
                                      const ExperimentParameters &) {
+  if (has_next_event_particles_) {
+    for (const ParticleData &data : next_event_particles_) {
+      const FourVector r = data.position();
+      const FourVector p = data.momentum();
+      try_create_particle(*particles, data.pdgcode(), r.x0(), r.x1(), r.x2(),
+                          r.x3(), data.effective_mass(), p.x0(), p.x1(),
+                          p.x2(), p.x3());
+    }
+    next_event_particles_.clear();
+    has_next_event_particles_ = false;
+  } else {
+    read_next_event_(particles);
+  }
+  if (particles->size() > 0) {
+    backpropagate_to_same_time(*particles);
+  } else {
+    start_time_ = 0.0;
+  }
+  event_id_++;
+
+  return start_time_;
+}
+
+void ListModus::read_next_event_(Particles *particles) {
   std::string particle_list = next_event_();
 
   for (const Line &line : line_parser(particle_list)) {
@@ -253,17 +298,16 @@ double ListModus::initial_conditions(Particles *particles,
     }
     try_create_particle(*particles, pdgcode, t, x, y, z, mass, E, px, py, pz);
   }
-  if (particles->size() > 0) {
-    backpropagate_to_same_time(*particles);
-  } else {
-    start_time_ = 0.0;
-  }
-  event_id_++;
-
-  return start_time_;
 }
 
 bf::path ListModus::file_path_(const int file_id) {
+  if (!missing_file_key_.empty()) {
+    throw std::invalid_argument(
+        "Configuration value for \"" + missing_file_key_ +
+        "\" is missing or invalid. The List modus needs File_Directory and "
+        "File_Prefix to read the particle lists, unless the particles of "
+        "every event are passed with ListModus::set_next_event.");
+  }
   std::stringstream fname;
   fname << particle_list_file_prefix_ << file_id;
 
@@ -6,10 +6,13 @@
  */
 #include "smash/nucleus.h"
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <iomanip>
 #include <limits>
 #include <map>
+#include <sstream>
 #include <string>
 
 #include "smash/angles.h"
@@ -221,7 +224,13 @@ ThreeVector Nucleus::distribute_nucleon() {
   if (almost_equal(nuclear_radius_, 0.)) {
     return smash::ThreeVector();
   }
-  double radius_scaled = nuclear_radius_ / diffusiveness_;
+  return dir.threevec() *
+         sample_woods_saxon_radius(nuclear_radius_, diffusiveness_);
+}
+
+double Nucleus::sample_woods_saxon_radius(double radius,
+                                          double diffusiveness) {
+  double radius_scaled = radius / diffusiveness;
   double prob_range1 = 1.0;
   double prob_range2 = 3. / radius_scaled;
   double prob_range3 = 2. * prob_range2 / radius_scaled;
@@ -252,8 +261,7 @@ ThreeVector Nucleus::distribute_nucleon() {
   } while (random::canonical() > 1. / (1. + std::exp(-std::abs(t))));
   /// \li Shift and rescale \f$t\f$ to \f$r = d\cdot t + r_0\f$
   double position_scaled = t + radius_scaled;
-  double position = position_scaled * diffusiveness_;
-  return dir.threevec() * position;
+  return position_scaled * diffusiveness;
 }
 
 double Nucleus::woods_saxon(double r) {
@@ -261,6 +269,11 @@ double Nucleus::woods_saxon(double r) {
 }
 
 void Nucleus::arrange_nucleons() {
+  if (has_configuration_library()) {
+    draw_configuration_from_library();
+    rotate();
+    return;
+  }
   for (auto i = begin(); i != end(); i++) {
     // Initialize momentum
     i->set_4momentum(i->pole_mass(), 0.0, 0.0, 0.0);
@@ -277,6 +290,162 @@ void Nucleus::arrange_nucleons() {
   rotate();
 }
 
+void Nucleus::set_up_configuration_library(size_t n_configurations,
+                                           const std::string &file) {
+  if (n_configurations == 0) {
+    throw std::invalid_argument(
+        "The nucleus configuration library needs at least one "
+        "configuration.");
+  }
+  std::ostringstream parameters;
+  parameters << std::setprecision(17) << n_configurations << ' '
+             << testparticles_ << ' ';
+  const std::vector<size_t> reference_order = canonical_order();
+  for (size_t i : reference_order) {
+    parameters << particles_[i].pdgcode() << ' ';
+  }
+  write_library_parameters(parameters);
+  const std::string parameter_string = parameters.str();
+  const sha256::Hash hash = sha256::calculate(
+      reinterpret_cast<const uint8_t *>(parameter_string.c_str()),
+      parameter_string.size());
+
+  if (!file.empty() &&
+      read_configuration_library(file, hash, n_configurations)) {
+    logg[LNucleus].info("Read ", n_configurations,
+                        " nucleus configurations from ", file);
+    return;
+  }
+
+  logg[LNucleus].info("Sampling ", n_configurations,
+                      " nucleus configurations for the library");
+  const size_t A = size();
+  configuration_library_.clear();
+  configuration_library_.reserve(3 * A * n_configurations);
+  std::vector<ThreeVector> positions(A);
+  for (size_t k = 0; k < n_configurations; k++) {
+    ThreeVector center;
+    for (size_t i = 0; i < A; i++) {
+      positions[i] = distribute_nucleon();
+      center += positions[i];
+    }
+    center /= A;
+    /* A custom nucleus refills the particles with the isospins of every
+     * configuration it reads, so the positions are stored in the canonical
+     * order of their own configuration. */
+    const std::vector<size_t> order = canonical_order();
+    for (size_t i = 0; i < A; i++) {
+      if (particles_[order[i]].pdgcode() !=
+          particles_[reference_order[i]].pdgcode()) {
+        throw std::runtime_error(
+            "The nucleus configurations for the library differ in their "
+            "numbers of protons and neutrons.");
+      }
+    }
+    for (size_t i : order) {
+      for (size_t j = 0; j < 3; j++) {
+        configuration_library_.push_back(positions[i][j] - center[j]);
+      }
+    }
+  }
+  if (!file.empty()) {
+    write_configuration_library(file, hash);
+  }
+}
+
+void Nucleus::draw_configuration_from_library() {
+  const size_t A = size();
+  const size_t n_configurations = configuration_library_.size() / (3 * A);
+  const size_t k = random::uniform_int<size_t>(0, n_configurations - 1);
+  const float *config = &configuration_library_[3 * A * k];
+  // The library positions are stored in canonical order, see canonical_order.
+  const std::vector<size_t> order = canonical_order();
+  random_euler_angles();
+  for (size_t i = 0; i < A; i++) {
+    ParticleData &p = particles_[order[i]];
+    p.set_4momentum(p.pole_mass(), 0.0, 0.0, 0.0);
+    ThreeVector pos(config[3 * i], config[3 * i + 1], config[3 * i + 2]);
+    rotate_library_configuration(pos);
+    p.set_4position(FourVector(0.0, pos));
+  }
+  // Remove the residual shift due to the single precision of the library.
+  align_center();
+}
+
+std::vector<size_t> Nucleus::canonical_order() const {
+  std::vector<size_t> order(size());
+  for (size_t i = 0; i < order.size(); i++) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+    return particles_[a].pdgcode() < particles_[b].pdgcode();
+  });
+  return order;
+}
+
+void Nucleus::write_library_parameters(std::ostream &out) const {
+  out << "Woods-Saxon " << nuclear_radius_ << ' ' << diffusiveness_ << ' '
+      << saturation_density_;
+}
+
+/// Identifier at the beginning of a nucleus configuration library file.
+static constexpr char library_magic[8] = {'S', 'M', 'A', 'S',
+                                          'H', 'N', 'U', 'C'};
+
+bool Nucleus::read_configuration_library(const std::string &file,
+                                         sha256::Hash hash,
+                                         size_t n_configurations) {
+  std::ifstream stream(file, std::ios::binary);
+  if (!stream) {
+    return false;
+  }
+  char magic[sizeof(library_magic)];
+  sha256::Hash hash_from_file;
+  uint64_t n_particles, n_from_file;
+  stream.read(magic, sizeof(magic));
+  stream.read(reinterpret_cast<char *>(hash_from_file.data()),
+              hash_from_file.size());
+  stream.read(reinterpret_cast<char *>(&n_particles), sizeof(n_particles));
+  stream.read(reinterpret_cast<char *>(&n_from_file), sizeof(n_from_file));
+  if (!stream || !std::equal(magic, magic + sizeof(magic), library_magic) ||
+      hash_from_file != hash || n_particles != size() ||
+      n_from_file != n_configurations) {
+    logg[LNucleus].info("Nucleus configuration library ", file,
+                        " does not match the nucleus and is replaced.");
+    return false;
+  }
+  std::vector<float> library(3 * n_particles * n_from_file);
+  stream.read(reinterpret_cast<char *>(library.data()),
+              sizeof(float) * library.size());
+  if (!stream) {
+    logg[LNucleus].warn("Nucleus configuration library ", file,
+                        " is truncated and is replaced.");
+    return false;
+  }
+  configuration_library_ = std::move(library);
+  return true;
+}
+
+void Nucleus::write_configuration_library(const std::string &file,
+                                          sha256::Hash hash) const {
+  std::ofstream stream(file, std::ios::binary);
+  const uint64_t n_particles = size();
+  const uint64_t n_configurations =
+      configuration_library_.size() / (3 * n_particles);
+  stream.write(library_magic, sizeof(library_magic));
+  stream.write(reinterpret_cast<const char *>(hash.data()), hash.size());
+  stream.write(reinterpret_cast<const char *>(&n_particles),
+               sizeof(n_particles));
+  stream.write(reinterpret_cast<const char *>(&n_configurations),
+               sizeof(n_configurations));
+  stream.write(reinterpret_cast<const char *>(configuration_library_.data()),
+               sizeof(float) * configuration_library_.size());
+  if (!stream) {
+    throw std::runtime_error("Could not write nucleus configuration library " +
+                             file);
+  }
+}
+
 void Nucleus::set_parameters_automatic() {
   int A = Nucleus::number_of_particles();
   int Z = Nucleus::number_of_protons();
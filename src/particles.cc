@@ -9,8 +9,14 @@
 
 #include "smash/particles.h"
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <iomanip>
 #include <iostream>
+#include <limits>
+#include <utility>
+#include <vector>
 
 namespace smash {
 
@@ -50,6 +56,7 @@ inline void Particles::copy_in(ParticleData &to, const ParticleData &from) {
 const ParticleData &Particles::insert(const ParticleData &p) {
   if (likely(dirty_.empty())) {
     ensure_capacity(1);
+    save_for_snapshot(data_size_);
     ParticleData &in_vector = data_[data_size_];
     copy_in(in_vector, p);
     ++data_size_;
@@ -57,6 +64,7 @@ const ParticleData &Particles::insert(const ParticleData &p) {
   } else {
     const auto offset = dirty_.back();
     dirty_.pop_back();
+    save_for_snapshot(offset);
     copy_in(data_[offset], p);
     data_[offset].hole_ = false;
     return data_[offset];
@@ -68,6 +76,7 @@ void Particles::create(size_t number, PdgCode pdg) {
   while (number && !dirty_.empty()) {
     const auto offset = dirty_.back();
     dirty_.pop_back();
+    save_for_snapshot(offset);
     pd.copy_to(data_[offset]);
     data_[offset].id_ = ++id_max_;
     data_[offset].type_ = pd.type_;
@@ -78,6 +87,7 @@ void Particles::create(size_t number, PdgCode pdg) {
     ensure_capacity(number);
     const auto end_ptr = &data_[data_size_ + number];
     for (auto ptr = &data_[data_size_]; ptr < end_ptr; ++ptr) {
+      save_for_snapshot(ptr->index_);
       pd.copy_to(*ptr);
       ptr->id_ = ++id_max_;
       ptr->type_ = pd.type_;
@@ -91,11 +101,13 @@ ParticleData &Particles::create(const PdgCode pdg) {
   ParticleData *ptr;
   if (likely(dirty_.empty())) {
     ensure_capacity(1);
+    save_for_snapshot(data_size_);
     ptr = &data_[data_size_];
     ++data_size_;
   } else {
     const auto offset = dirty_.back();
     dirty_.pop_back();
+    save_for_snapshot(offset);
     ptr = &data_[offset];
     ptr->hole_ = false;
   }
@@ -108,6 +120,7 @@ ParticleData &Particles::create(const PdgCode pdg) {
 void Particles::remove(const ParticleData &p) {
   assert(is_valid(p));
   const unsigned index = p.index_;
+  save_for_snapshot(index);
   if (index == data_size_ - 1) {
     --data_size_;
   } else {
@@ -122,6 +135,7 @@ void Particles::replace(const ParticleList &to_remove, ParticleList &to_add) {
   for (; i < std::min(to_remove.size(), to_add.size()); ++i) {
     assert(is_valid(to_remove[i]));
     const auto index = to_remove[i].index_;
+    save_for_snapshot(index);
     copy_in(data_[index], to_add[i]);
     to_add[i].id_ = data_[index].id_;
     to_add[i].index_ = index;
@@ -137,6 +151,7 @@ void Particles::replace(const ParticleList &to_remove, ParticleList &to_add) {
 }
 
 void Particles::reset() {
+  release_snapshot();
   id_max_ = -1;
   data_size_ = 0;
   for (auto index : dirty_) {
@@ -145,6 +160,86 @@ void Particles::reset() {
   dirty_.clear();
 }
 
+namespace {
+/**
+ * Spread the lowest 21 bits of \p x such that two zero bits are inserted
+ * between any two consecutive bits.
+ *
+ * \param[in] x Integer cell coordinate
+ * \return Bit pattern to be interleaved with those of the other two
+ *         coordinates
+ */
+uint64_t spread_bits(uint64_t x) {
+  x &= 0x1fffff;
+  x = (x | x << 32) & 0x1f00000000ffffull;
+  x = (x | x << 16) & 0x1f0000ff0000ffull;
+  x = (x | x << 8) & 0x100f00f00f00f00full;
+  x = (x | x << 4) & 0x10c30c30c30c30c3ull;
+  x = (x | x << 2) & 0x1249249249249249ull;
+  return x;
+}
+}  // unnamed namespace
+
+void Particles::reorder_spatially(double cell_length) {
+  assert(cell_length > 0.);
+  release_snapshot();
+  const unsigned n = size();
+  if (n < 2) {
+    return;
+  }
+  std::array<double, 3> min_position = {{std::numeric_limits<double>::max(),
+                                         std::numeric_limits<double>::max(),
+                                         std::numeric_limits<double>::max()}};
+  for (const ParticleData &p : *this) {
+    const ThreeVector r = p.position().threevec();
+    for (int i = 0; i < 3; ++i) {
+      min_position[i] = std::min(min_position[i], r[i]);
+    }
+  }
+
+  // Pairs of the Morton key and the current storage index. The index makes
+  // the order unique for particles in the same cell.
+  constexpr double max_cell_index = 0x1fffff;
+  std::vector<std::pair<uint64_t, unsigned>> order;
+  order.reserve(n);
+  for (const ParticleData &p : *this) {
+    const ThreeVector r = p.position().threevec();
+    uint64_t key = 0;
+    for (int i = 0; i < 3; ++i) {
+      const double cell =
+          std::min((r[i] - min_position[i]) / cell_length, max_cell_index);
+      key |= spread_bits(static_cast<uint64_t>(cell)) << i;
+    }
+    order.emplace_back(key, p.index_);
+  }
+  std::sort(order.begin(), order.end());
+
+  std::unique_ptr<ParticleData[]> new_memory(new ParticleData[data_capacity_]);
+  unsigned i = 0;
+  for (; i < n; ++i) {
+    new_memory[i] = data_[order[i].second];
+    new_memory[i].index_ = i;
+  }
+  for (; i < data_capacity_; ++i) {
+    new_memory[i].index_ = i;
+  }
+  std::swap(data_, new_memory);
+  data_size_ = n;
+  dirty_.clear();
+}
+
+Particles::Snapshot Particles::take_snapshot() {
+  release_snapshot();
+  snapshot_size_ = data_size_;
+  return Snapshot(this);
+}
+
+void Particles::release_snapshot() {
+  snapshot_size_ = 0;
+  snapshot_originals_.clear();
+  ++snapshot_generation_;
+}
+
 std::ostream &operator<<(std::ostream &out, const Particles &particles) {
   out << particles.size() << " Particles:\n";
   for (unsigned i = 0; i < particles.data_size_; ++i) {
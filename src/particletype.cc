@@ -15,6 +15,7 @@
 #include <vector>
 
 #include "smash/constants.h"
+#include "smash/batchsampling.h"
 #include "smash/cxx14compat.h"
 #include "smash/decaymodes.h"
 #include "smash/distributions.h"
@@ -26,6 +27,7 @@
 #include "smash/logging.h"
 #include "smash/potential_globals.h"
 #include "smash/stringfunctions.h"
+#include "smash/tabulation.h"
 
 namespace smash {
 static constexpr int LParticleType = LogArea::ParticleType::id;
@@ -132,6 +134,10 @@ ParticleType::ParticleType(std::string n, double m, double w, Parity p,
       isospin_(-1),
       I3_(pdgcode_.isospin3()) {}
 
+ParticleType::ParticleType(ParticleType &&) = default;
+ParticleType &ParticleType::operator=(ParticleType &&) = default;
+ParticleType::~ParticleType() = default;
+
 /**
  * Construct an antiparticle name-string from the given name-string for the
  * particle and its PDG code.
@@ -497,10 +503,10 @@ DecayBranchList ParticleType::get_partial_widths(const FourVector p,
   FourVector UB = FourVector();
   FourVector UI3 = FourVector();
   if (UB_lat_pointer != nullptr) {
-    UB_lat_pointer->value_at(x, UB);
+    UB_lat_pointer->evaluate_at(x, UB);
   }
   if (UI3_lat_pointer != nullptr) {
-    UI3_lat_pointer->value_at(x, UI3);
+    UI3_lat_pointer->evaluate_at(x, UI3);
   }
   /* Loop over decay modes and calculate all partial widths. */
   DecayBranchList partial;
@@ -570,7 +576,10 @@ double ParticleType::get_partial_in_width(const double m,
 double ParticleType::spectral_function(double m) const {
   if (norm_factor_ < 0.) {
     /* Initialize the normalization factor
-     * by integrating over the unnormalized spectral function. */
+     * by integrating over the unnormalized spectral function. It is
+     * initialized by tabulate_spectral_functions before any concurrent
+     * sampling. */
+    assert(!sampling_in_batches_concurrently());
     static /*thread_local (see #3075)*/ Integrator integrate;
     const double width = width_at_pole();
     const double m_pole = mass();
@@ -611,6 +620,54 @@ double ParticleType::spectral_function_simple(double m) const {
   return breit_wigner_nonrel(m, mass(), width_at_pole());
 }
 
+/// Mass range above min_mass_spectral covered by the spectral-function
+/// tabulation for the resonance mass sampling [GeV].
+static constexpr double sf_tabulation_range = 4.;
+/// Number of intervals of the spectral-function tabulation.
+static constexpr size_t sf_tabulation_intervals = 2000;
+
+void ParticleType::tabulate_spectral_function_ratio() const {
+  if (sf_ratio_tabulation_) {
+    return;
+  }
+  /* The tables are created by tabulate_spectral_functions before any
+   * concurrent sampling. */
+  assert(!sampling_in_batches_concurrently());
+  sf_ratio_tabulation_ = make_unique<Tabulation>(
+      min_mass_spectral(), sf_tabulation_range, sf_tabulation_intervals,
+      [&](double m) {
+        return spectral_function(m) / spectral_function_simple(m);
+      });
+  sf_ratio_max_tabulation_ =
+      make_unique<Tabulation>(sf_ratio_tabulation_->running_maximum());
+}
+
+void ParticleType::tabulate_spectral_functions() {
+  for (const ParticleType &type : list_all()) {
+    if (!type.is_stable()) {
+      type.tabulate_spectral_function_ratio();
+    }
+  }
+}
+
+double ParticleType::spectral_function_ratio(double m) const {
+  tabulate_spectral_function_ratio();
+  if (m <= sf_ratio_tabulation_->x_max()) {
+    return sf_ratio_tabulation_->get_value_linear(m);
+  }
+  return spectral_function(m) / spectral_function_simple(m);
+}
+
+double ParticleType::spectral_function_ratio_max(double m_max) const {
+  tabulate_spectral_function_ratio();
+  const double tab_max = sf_ratio_max_tabulation_->get_value_step(m_max);
+  if (m_max <= sf_ratio_max_tabulation_->x_max()) {
+    return tab_max;
+  }
+  return std::max(tab_max, spectral_function(m_max) /
+                               spectral_function_simple(m_max));
+}
+
 /* Resonance mass sampling for 2-particle final state */
 double ParticleType::sample_resonance_mass(const double mass_stable,
                                            const double cms_energy,
@@ -625,41 +682,38 @@ double ParticleType::sample_resonance_mass(const double mass_stable,
   // largest possible cm momentum (from smallest mass)
   const double pcm_max = pCM(cms_energy, mass_stable, min_mass);
   const double blw_max = pcm_max * blatt_weisskopf_sqr(pcm_max, L);
-  /* The maximum of the spectral-function ratio 'usually' happens at the
-   * largest mass. However, this is not always the case, therefore we need
-   * and additional fudge factor (determined automatically). Additionally,
-   * a heuristic knowledge is used that usually such mass exist that
-   * spectral_function(m) > spectral_function_simple(m). */
-  const double sf_ratio_max =
-      std::max(1., this->spectral_function(max_mass) /
-                       this->spectral_function_simple(max_mass));
+  /* The maximum of the spectral-function ratio is taken from its tabulated
+   * running maximum. Only beyond the tabulated range an additional fudge
+   * factor might be needed, which is determined automatically for this call
+   * (without modifying the particle type). */
+  const double q_max = this->spectral_function_ratio_max(max_mass);
+  double max_factor = 1.;
 
   double mass_res, val;
   // outer loop: repeat if maximum is too small
   do {
-    const double q_max = sf_ratio_max * this->max_factor1_;
-    const double max = blw_max * q_max;  // maximum value for rejection sampling
+    // maximum value for rejection sampling
+    const double max = blw_max * q_max * max_factor;
     // inner loop: rejection sampling
     do {
       // sample mass from a simple Breit-Wigner (aka Cauchy) distribution
       mass_res = random::cauchy(this->mass(), this->width_at_pole() / 2.,
-                                this->min_mass_spectral(), max_mass);
+                                min_mass, max_mass);
       // determine cm momentum for this case
       const double pcm = pCM(cms_energy, mass_stable, mass_res);
       const double blw = pcm * blatt_weisskopf_sqr(pcm, L);
       // determine ratio of full to simple spectral function
-      const double q = this->spectral_function(mass_res) /
-                       this->spectral_function_simple(mass_res);
+      const double q = this->spectral_function_ratio(mass_res);
       val = q * blw;
     } while (val < random::uniform(0., max));
 
     // check that we are using the proper maximum value
     if (val > max) {
       logg[LResonances].debug(
-          "maximum is being increased in sample_resonance_mass: ",
-          this->max_factor1_, " ", val / max, " ", this->pdgcode(), " ",
-          mass_stable, " ", cms_energy, " ", mass_res);
-      this->max_factor1_ *= val / max;
+          "maximum is being increased in sample_resonance_mass: ", max_factor,
+          " ", val / max, " ", this->pdgcode(), " ", mass_stable, " ",
+          cms_energy, " ", mass_res);
+      max_factor *= val / max;
     } else {
       break;  // maximum ok, exit loop
     }
@@ -682,12 +736,16 @@ std::pair<double, double> ParticleType::sample_resonance_masses(
   const double pcm_max =
       pCM(cms_energy, t1.min_mass_spectral(), t2.min_mass_spectral());
   const double blw_max = pcm_max * blatt_weisskopf_sqr(pcm_max, L);
+  // maximum of the product of the spectral-function ratios (tabulated)
+  const double q_max = t1.spectral_function_ratio_max(max_mass_1) *
+                       t2.spectral_function_ratio_max(max_mass_2);
+  double max_factor = 1.;
 
   double mass_1, mass_2, val;
   // outer loop: repeat if maximum is too small
   do {
-    // maximum value for rejection sampling (determined automatically)
-    const double max = blw_max * t1.max_factor2_;
+    // maximum value for rejection sampling
+    const double max = blw_max * q_max * max_factor;
     // inner loop: rejection sampling
     do {
       // sample mass from a simple Breit-Wigner (aka Cauchy) distribution
@@ -699,19 +757,17 @@ std::pair<double, double> ParticleType::sample_resonance_masses(
       const double pcm = pCM(cms_energy, mass_1, mass_2);
       const double blw = pcm * blatt_weisskopf_sqr(pcm, L);
       // determine ratios of full to simple spectral function
-      const double q1 =
-          t1.spectral_function(mass_1) / t1.spectral_function_simple(mass_1);
-      const double q2 =
-          t2.spectral_function(mass_2) / t2.spectral_function_simple(mass_2);
+      const double q1 = t1.spectral_function_ratio(mass_1);
+      const double q2 = t2.spectral_function_ratio(mass_2);
       val = q1 * q2 * blw;
     } while (val < random::uniform(0., max));
 
     if (val > max) {
       logg[LResonances].debug(
           "maximum is being increased in sample_resonance_masses: ",
-          t1.max_factor2_, " ", val / max, " ", t1.pdgcode(), " ", t2.pdgcode(),
+          max_factor, " ", val / max, " ", t1.pdgcode(), " ", t2.pdgcode(),
           " ", cms_energy, " ", mass_1, " ", mass_2);
-      t1.max_factor2_ *= val / max;
+      max_factor *= val / max;
     } else {
       break;  // maximum ok, exit loop
     }
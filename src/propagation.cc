@@ -133,8 +133,8 @@ void update_momenta(
      * 2) r is not out of required lattices */
     const bool use_lattice =
         possibly_use_lattice &&
-        (pot.use_skyrme() ? FB_lat->value_at(r, FB) : true) &&
-        (pot.use_symmetry() ? FI3_lat->value_at(r, FI3) : true);
+        (pot.use_skyrme() ? FB_lat->evaluate_at(r, FB) : true) &&
+        (pot.use_symmetry() ? FI3_lat->evaluate_at(r, FI3) : true);
     if (!pot.use_skyrme()) {
       FB = std::make_pair(ThreeVector(0., 0., 0.), ThreeVector(0., 0., 0.));
     }
@@ -253,29 +253,64 @@ QuantumSampling::QuantumSampling(
  * This sampler is the simplest implementation of sampling based on sampling
  * from a uniform distribution.
  */
-double QuantumSampling::sample(const PdgCode pdg) {
-  const ParticleType &ptype = ParticleType::find(pdg);
-  const double mass = ptype.mass();
-  const double mu = effective_chemical_potentials_.find(pdg)->second;
-  const double distr_max = distribution_function_maximums_.find(pdg)->second;
+namespace {
+/**
+ * Sample one radial momentum from the Bose, Fermi or Boltzmann distribution
+ * by rejection from a uniform envelope.
+ *
+ * \param[in] mass (pole) mass m of the particle species [GeV]
+ * \param[in] temperature temperature T of the system [GeV]
+ * \param[in] mu effective chemical potential of the particle species [GeV]
+ * \param[in] statistics quantum statistics of the particles species
+ *            (+1 for Fermi, -1 for Bose, 0 for Boltzmann)
+ * \param[in] distr_max maximum of p^2 times the distribution function
+ * \param[in,out] rng Random number engine
+ * \return the sampled momentum [GeV]
+ */
+double sample_quantum_momentum(double mass, double temperature, double mu,
+                               double statistics, double distr_max,
+                               random::Engine &rng) {
   /*
    * The variable maximum_momentum denotes the "far right" boundary of the
    * sampled region; we assume that no particle has momentum larger than 10 GeV
    */
   constexpr double maximum_momentum = 10.0;  // in [GeV]
-  const double statistics = (pdg.spin() % 2 == 0) ? -1.0 : 1.0;
   double sampled_momentum = 0.0, sampled_ratio = 0.0;
 
   do {
-    sampled_momentum = random::uniform(0.0, maximum_momentum);
+    sampled_momentum = random::uniform(0.0, maximum_momentum, rng);
     double distribution_at_sampled_p =
         sampled_momentum * sampled_momentum *
-        juttner_distribution_func(sampled_momentum, mass, temperature_, mu,
+        juttner_distribution_func(sampled_momentum, mass, temperature, mu,
                                   statistics);
     sampled_ratio = distribution_at_sampled_p / distr_max;
-  } while (random::canonical() > sampled_ratio);
+  } while (random::canonical(rng) > sampled_ratio);
 
   return sampled_momentum;
 }
+}  // unnamed namespace
+
+double QuantumSampling::sample(const PdgCode pdg) const {
+  const ParticleType &ptype = ParticleType::find(pdg);
+  const double mass = ptype.mass();
+  const double mu = effective_chemical_potentials_.find(pdg)->second;
+  const double distr_max = distribution_function_maximums_.find(pdg)->second;
+  const double statistics = (pdg.spin() % 2 == 0) ? -1.0 : 1.0;
+  return sample_quantum_momentum(mass, temperature_, mu, statistics,
+                                 distr_max, random::engine);
+}
+
+void QuantumSampling::sample(const PdgCode pdg, std::vector<double> &momenta,
+                             random::Engine &rng) const {
+  const ParticleType &ptype = ParticleType::find(pdg);
+  const double mass = ptype.mass();
+  const double mu = effective_chemical_potentials_.find(pdg)->second;
+  const double distr_max = distribution_function_maximums_.find(pdg)->second;
+  const double statistics = (pdg.spin() % 2 == 0) ? -1.0 : 1.0;
+  for (double &momentum : momenta) {
+    momentum = sample_quantum_momentum(mass, temperature_, mu, statistics,
+                                       distr_max, rng);
+  }
+}
 
 }  // namespace smash
@@ -8,7 +8,17 @@
  */
 
 #include "smash/rootoutput.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+#include "RVersion.h"
+#include "TBranch.h"
 #include "TFile.h"
+#include "TROOT.h"
 #include "TTree.h"
 #include "smash/action.h"
 #include "smash/clock.h"
@@ -19,8 +29,6 @@ namespace smash {
 static constexpr int LHyperSurfaceCrossing = LogArea::HyperSurfaceCrossing::id;
 static constexpr int LOutput = LogArea::Output::id;
 
-const int RootOutput::max_buffer_size_ = 500000;
-
 /*!\Userguide
  * \page format_root ROOT Format
  * SMASH ROOT output is a fast and disk-space efficient, but not human-readable
@@ -57,10 +65,12 @@ const int RootOutput::max_buffer_size_ = 500000;
  * px[npart] py[npart] pz[npart] E_kinetic_tot E_fields_tot E_tot
  * \endcode
  * The maximal
- * number of particles in one entry is limited to 500000. This is done to limit
- * the buffer size needed for ROOT output. If the number of particles in one
- * block exceeds 500000, then they are written in separate blocks with the same
- * \c tcounter and \c ev. The fields have the following meaning:
+ * number of particles in one entry is limited by the output option
+ * \key Root_Buffer_Size (default 500000, see \ref output_general_). This is
+ * done to limit the buffer size needed for ROOT output. If the number of
+ * particles in one block exceeds this limit, then they are written in
+ * separate blocks with the same \c tcounter and \c ev. The fields have the
+ * following meaning:
  *
  * \li \c ev is event number
  * \li \c tcounter is number of output block in a given event in terms of
@@ -95,6 +105,14 @@ const int RootOutput::max_buffer_size_ = 500000;
  * Currently writing initial and final configuration to collisions tree is
  * not supported.
  *
+ * The compression of the files, the basket sizes and the auto-flush
+ * behaviour of the trees can be chosen with the general output options
+ * \key Root_Compression_Algorithm, \key Root_Compression_Level,
+ * \key Root_Basket_Size and \key Root_Auto_Flush. With
+ * \key Root_Threaded_Fill the trees are filled by a background thread, such
+ * that the serialization and compression of an entry overlaps with the
+ * simulation.
+ *
  * See also \ref collisions_output_in_box_modus_.
  *
  * Here is an example of a basic ROOT macro to read the ROOT output of SMASH:
@@ -226,6 +244,7 @@ RootOutput::RootOutput(const bf::path &path, const std::string &name,
                        const OutputParameters &out_par)
     : OutputInterface(name),
       filename_(path / (name + ".root")),
+      max_buffer_size_(out_par.root_buffer_size),
       write_collisions_(name == "Collisions" || name == "Dileptons" ||
                         name == "Photons"),
       write_particles_(name == "Particles"),
@@ -234,12 +253,47 @@ RootOutput::RootOutput(const bf::path &path, const std::string &name,
       autosave_frequency_(1000),
       part_extended_(out_par.part_extended),
       coll_extended_(out_par.coll_extended),
-      ic_extended_(out_par.ic_extended) {
+      ic_extended_(out_par.ic_extended),
+      basket_size_(out_par.root_basket_size),
+      auto_flush_(out_par.root_auto_flush),
+      threaded_fill_(out_par.root_threaded_fill) {
+  if (max_buffer_size_ < 1) {
+    throw std::invalid_argument("Root_Buffer_Size has to be positive.");
+  }
+  if (basket_size_ < 1) {
+    throw std::invalid_argument("Root_Basket_Size has to be positive.");
+  }
+  if (out_par.root_compression_level > 9) {
+    throw std::invalid_argument(
+        "Root_Compression_Level has to be between 0 and 9.");
+  }
+  // The buffers grow when needed, so large limits cost no memory upfront.
+  ensure_buffer_size(std::min(max_buffer_size_, 1000));
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 0, 0)
+  if (threaded_fill_) {
+    // several outputs might fill their trees at the same time
+    ROOT::EnableThreadSafety();
+  }
+#endif
+
   filename_unfinished_ = filename_;
   filename_unfinished_ += ".unfinished";
   root_out_file_ =
       make_unique<TFile>(filename_unfinished_.native().c_str(), "NEW");
+  if (out_par.root_compression_algorithm >= 0 ||
+      out_par.root_compression_level >= 0) {
+    /* An algorithm of 0 tells ROOT to use its global default, and level 1 is
+     * the classic default level of ROOT. */
+    const int algorithm = std::max(out_par.root_compression_algorithm, 0);
+    const int level = out_par.root_compression_level >= 0
+                          ? out_par.root_compression_level
+                          : 1;
+    root_out_file_->SetCompressionSettings(100 * algorithm + level);
+  }
   init_trees();
+  if (threaded_fill_) {
+    fill_thread_ = std::thread(&RootOutput::fill_loop, this);
+  }
 }
 
 void RootOutput::init_trees() {
@@ -331,6 +385,98 @@ void RootOutput::init_trees() {
                                "pdg_mother2[npart]/I");
     }
   }
+
+  for (TTree *tree : {particles_tree_, collisions_tree_}) {
+    if (tree) {
+      tree->SetBasketSize("*", basket_size_);
+      tree->SetAutoFlush(auto_flush_);
+    }
+  }
+}
+
+void RootOutput::ensure_buffer_size(size_t n) {
+  if (n <= p0_.size()) {
+    return;
+  }
+  const size_t new_size = std::max(n, 2 * p0_.size());
+  for (std::vector<double> *buffer :
+       {&p0_, &px_, &py_, &pz_, &t_, &x_, &y_, &z_, &formation_time_,
+        &xsec_factor_, &time_last_coll_}) {
+    buffer->resize(new_size);
+  }
+  for (std::vector<int> *buffer :
+       {&pdgcode_, &charge_, &coll_per_part_, &proc_id_origin_,
+        &proc_type_origin_, &pdg_mother1_, &pdg_mother2_}) {
+    buffer->resize(new_size);
+  }
+  // the branches still point to the old memory
+  set_array_addresses(particles_tree_);
+  set_array_addresses(collisions_tree_);
+}
+
+void RootOutput::set_array_addresses(TTree *tree) {
+  if (!tree) {
+    return;
+  }
+  const std::pair<const char *, void *> arrays[] = {
+      {"pdgcode", pdgcode_.data()},
+      {"charge", charge_.data()},
+      {"p0", p0_.data()},
+      {"px", px_.data()},
+      {"py", py_.data()},
+      {"pz", pz_.data()},
+      {"t", t_.data()},
+      {"x", x_.data()},
+      {"y", y_.data()},
+      {"z", z_.data()},
+      {"ncoll", coll_per_part_.data()},
+      {"form_time", formation_time_.data()},
+      {"xsecfac", xsec_factor_.data()},
+      {"proc_id_origin", proc_id_origin_.data()},
+      {"proc_type_origin", proc_type_origin_.data()},
+      {"time_last_coll", time_last_coll_.data()},
+      {"pdg_mother1", pdg_mother1_.data()},
+      {"pdg_mother2", pdg_mother2_.data()}};
+  for (const auto &array : arrays) {
+    TBranch *branch = tree->GetBranch(array.first);
+    if (branch) {
+      branch->SetAddress(array.second);
+    }
+  }
+}
+
+void RootOutput::fill(TTree *tree) {
+  if (!threaded_fill_) {
+    tree->Fill();
+    return;
+  }
+  std::lock_guard<std::mutex> lock(fill_mutex_);
+  assert(tree_to_fill_ == nullptr);
+  tree_to_fill_ = tree;
+  fill_condition_.notify_all();
+}
+
+void RootOutput::wait_for_fill() {
+  if (!threaded_fill_) {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(fill_mutex_);
+  fill_condition_.wait(lock, [this] { return tree_to_fill_ == nullptr; });
+}
+
+void RootOutput::fill_loop() {
+  std::unique_lock<std::mutex> lock(fill_mutex_);
+  while (true) {
+    fill_condition_.wait(
+        lock, [this] { return tree_to_fill_ != nullptr || stop_fill_thread_; });
+    if (tree_to_fill_) {
+      tree_to_fill_->Fill();
+      tree_to_fill_ = nullptr;
+      fill_condition_.notify_all();
+    } else {
+      return;
+    }
+  }
 }
 
 /**
@@ -338,6 +484,15 @@ void RootOutput::init_trees() {
  * it.
  */
 RootOutput::~RootOutput() {
+  if (threaded_fill_) {
+    wait_for_fill();
+    {
+      std::lock_guard<std::mutex> lock(fill_mutex_);
+      stop_fill_thread_ = true;
+    }
+    fill_condition_.notify_all();
+    fill_thread_.join();
+  }
   // kOverwrite option prevents from writing extra TKey objects into root file
   root_out_file_->Write("", TObject::kOverwrite);
   root_out_file_->Close();
@@ -346,6 +501,8 @@ RootOutput::~RootOutput() {
 
 void RootOutput::at_eventstart(const Particles &particles,
                                const int event_number, const EventInfo &event) {
+  // the buffers are only written after the previous entry has been filled
+  wait_for_fill();
   // save event number
   current_event_ = event_number;
 
@@ -370,6 +527,7 @@ void RootOutput::at_intermediate_time(const Particles &particles,
                                       const std::unique_ptr<Clock> &,
                                       const DensityParameters &,
                                       const EventInfo &event) {
+  wait_for_fill();
   modus_l_ = event.modus_length;
   test_p_ = event.test_particles;
   current_t_ = event.current_time;
@@ -386,6 +544,7 @@ void RootOutput::at_intermediate_time(const Particles &particles,
 void RootOutput::at_eventend(const Particles &particles,
                              const int /*event_number*/,
                              const EventInfo &event) {
+  wait_for_fill();
   modus_l_ = event.modus_length;
   test_p_ = event.test_particles;
   current_t_ = event.current_time;
@@ -403,6 +562,7 @@ void RootOutput::at_eventend(const Particles &particles,
   /* Forced regular dump from operational memory to disk. Very demanding!
    * If program crashes written data will NOT be lost. */
   if (current_event_ > 0 && current_event_ % autosave_frequency_ == 0) {
+    wait_for_fill();
     if (write_particles_ || write_initial_conditions_) {
       particles_tree_->AutoSave("SaveSelf");
     }
@@ -425,6 +585,7 @@ void RootOutput::at_eventend(const Particles &particles,
 
 void RootOutput::at_interaction(const Action &action,
                                 const double /*density*/) {
+  wait_for_fill();
   if (write_collisions_) {
     collisions_to_tree(action.incoming_particles(), action.outgoing_particles(),
                        action.get_total_weight(), action.get_partial_weight());
@@ -442,59 +603,58 @@ void RootOutput::particles_to_tree(T &particles) {
 
   ev_ = current_event_;
   tcounter_ = output_counter_;
-  bool exceeded_buffer_message = true;
+  const int n_particles = particles.size();
+  ensure_buffer_size(std::min(n_particles, max_buffer_size_));
+  if (n_particles > max_buffer_size_) {
+    logg[LOutput].warn()
+        << "\nThe number of particles N = " << n_particles
+        << " exceeds the maximum buffer size B = " << max_buffer_size_
+        << ".\nceil(N/B) = "
+        << std::ceil(n_particles / static_cast<double>(max_buffer_size_))
+        << " separate ROOT Tree entries will be created at this output."
+        << "\nMaximum buffer size can be changed with the Root_Buffer_Size "
+        << "output option.\n\n";
+  }
 
   for (const auto &p : particles) {
-    // Buffer full - flush to tree, else fill with particles
-    if (i >= max_buffer_size_) {
-      if (exceeded_buffer_message) {
-        logg[LOutput].warn()
-            << "\nThe number of particles N = " << particles.size()
-            << " exceeds the maximum buffer size B = " << max_buffer_size_
-            << ".\nceil(N/B) = "
-            << std::ceil(particles.size() /
-                         static_cast<double>(max_buffer_size_))
-            << " separate ROOT Tree entries will be created at this output."
-            << "\nMaximum buffer size (max_buffer_size_) can be changed in "
-            << "rootoutput.h\n\n";
-        exceeded_buffer_message = false;
-      }
-      npart_ = max_buffer_size_;
+    // Buffer full - flush to tree before adding the particle
+    if (i == max_buffer_size_) {
+      npart_ = i;
+      fill(particles_tree_);
+      wait_for_fill();
       i = 0;
-      particles_tree_->Fill();
-    } else {
-      pdgcode_[i] = p.pdgcode().get_decimal();
-      charge_[i] = p.type().charge();
-
-      p0_[i] = p.momentum().x0();
-      px_[i] = p.momentum().x1();
-      py_[i] = p.momentum().x2();
-      pz_[i] = p.momentum().x3();
+    }
+    pdgcode_[i] = p.pdgcode().get_decimal();
+    charge_[i] = p.type().charge();
 
-      t_[i] = p.position().x0();
-      x_[i] = p.position().x1();
-      y_[i] = p.position().x2();
-      z_[i] = p.position().x3();
+    p0_[i] = p.momentum().x0();
+    px_[i] = p.momentum().x1();
+    py_[i] = p.momentum().x2();
+    pz_[i] = p.momentum().x3();
 
-      if (part_extended_ || ic_extended_) {
-        const auto h = p.get_history();
-        formation_time_[i] = p.formation_time();
-        xsec_factor_[i] = p.xsec_scaling_factor();
-        time_last_coll_[i] = h.time_last_collision;
-        coll_per_part_[i] = h.collisions_per_particle;
-        proc_id_origin_[i] = h.id_process;
-        proc_type_origin_[i] = static_cast<int>(h.process_type);
-        pdg_mother1_[i] = h.p1.get_decimal();
-        pdg_mother2_[i] = h.p2.get_decimal();
-      }
+    t_[i] = p.position().x0();
+    x_[i] = p.position().x1();
+    y_[i] = p.position().x2();
+    z_[i] = p.position().x3();
 
-      i++;
+    if (part_extended_ || ic_extended_) {
+      const auto h = p.get_history();
+      formation_time_[i] = p.formation_time();
+      xsec_factor_[i] = p.xsec_scaling_factor();
+      time_last_coll_[i] = h.time_last_collision;
+      coll_per_part_[i] = h.collisions_per_particle;
+      proc_id_origin_[i] = h.id_process;
+      proc_type_origin_[i] = static_cast<int>(h.process_type);
+      pdg_mother1_[i] = h.p1.get_decimal();
+      pdg_mother2_[i] = h.p2.get_decimal();
     }
+
+    i++;
   }
   // Flush rest to tree
   if (i > 0) {
     npart_ = i;
-    particles_tree_->Fill();
+    fill(particles_tree_);
   }
 }
 
@@ -511,10 +671,8 @@ void RootOutput::collisions_to_tree(const ParticleList &incoming,
 
   int i = 0;
 
-  /* It is assumed that nin + nout < max_buffer_size_
-   * This is true for any possible reaction for current buffer size: 10000
-   * But if one wants initial/final particles written to collisions
-   * then implementation should be updated. */
+  // A collision is always written as a single entry.
+  ensure_buffer_size(npart_);
 
   for (const ParticleList &plist : {incoming, outgoing}) {
     for (const auto &p : plist) {
@@ -547,6 +705,6 @@ void RootOutput::collisions_to_tree(const ParticleList &incoming,
     }
   }
 
-  collisions_tree_->Fill();
+  fill(collisions_tree_);
 }
 }  // namespace smash
@@ -9,9 +9,14 @@
 
 #include "smash/scatteractionmulti.h"
 
+#include <algorithm>
+#include <array>
+#include <map>
+
 #include "smash/crosssections.h"
 #include "smash/integrate.h"
 #include "smash/logging.h"
+#include "smash/tabulation.h"
 
 namespace smash {
 static constexpr int LScatterActionMulti = LogArea::ScatterActionMulti::id;
@@ -279,11 +284,18 @@ void ScatterActionMulti::generate_final_state() {
   }
 }
 
-double ScatterActionMulti::calculate_I3(const double sqrts) const {
-  static Integrator integrate;
-  const double m1 = incoming_particles_[0].effective_mass();
-  const double m2 = incoming_particles_[1].effective_mass();
-  const double m3 = incoming_particles_[2].effective_mass();
+/**
+ * Integrate the three-body phase-space integral with the given integrator.
+ *
+ * \param[in] integrate Integrator used for the integration
+ * \param[in] sqrts center of mass energy of the three particles [GeV]
+ * \param[in] m1 mass of the first particle [GeV]
+ * \param[in] m2 mass of the second particle [GeV]
+ * \param[in] m3 mass of the third particle [GeV]
+ * \return result of the integral [GeV^4]
+ */
+static double integrate_I3_with(Integrator &integrate, double sqrts,
+                                double m1, double m2, double m3) {
   const double lower_bound = (m1 + m2) * (m1 + m2);
   const double upper_bound = (sqrts - m3) * (sqrts - m3);
   const auto result = integrate(lower_bound, upper_bound, [&](double m12_sqr) {
@@ -306,6 +318,71 @@ double ScatterActionMulti::calculate_I3(const double sqrts) const {
   return result;
 }
 
+double ScatterActionMulti::integrate_I3(double sqrts, double m1, double m2,
+                                        double m3) {
+  static Integrator integrate;
+  return integrate_I3_with(integrate, sqrts, m1, m2, m3);
+}
+
+/// Step size in the kinetic energy of the tabulations of I3 [GeV]
+static constexpr double I3_tabulation_spacing = 0.01;
+
+/// Range in the kinetic energy above the threshold covered by the
+/// tabulations of I3 [GeV]
+static constexpr double I3_tabulation_range = 4.0;
+
+/**
+ * Tabulations of I3/Q^2 as a function of the kinetic energy Q.
+ *
+ * Keys are the masses of the three particles in ascending order.
+ */
+static std::map<std::array<double, 3>, Tabulation> I3_tabulations;
+
+double ScatterActionMulti::tabulated_I3(double sqrts, double m1, double m2,
+                                        double m3) {
+  const double q = sqrts - m1 - m2 - m3;
+  if (q <= 0. || q >= I3_tabulation_range) {
+    return integrate_I3(sqrts, m1, m2, m3);
+  }
+  // I3 is symmetric in the masses, so one tabulation serves all orders.
+  std::array<double, 3> masses = {{m1, m2, m3}};
+  std::sort(masses.begin(), masses.end());
+  auto tabulation = I3_tabulations.find(masses);
+  if (tabulation == I3_tabulations.end()) {
+    static Integrator integrate;
+    /* The values are tiny close to the threshold, so only the relative
+     * precision is required. */
+    integrate.set_precision(0., 1e-5);
+    const double threshold = masses[0] + masses[1] + masses[2];
+    const auto num =
+        static_cast<size_t>(I3_tabulation_range / I3_tabulation_spacing);
+    // I3/Q^2 is finite at the threshold, evaluate it slightly above.
+    const double q_min = 1e-3 * I3_tabulation_spacing;
+    Tabulation tab(0., I3_tabulation_range, num, [&](double q_tab) {
+      const double q_eval = std::max(q_tab, q_min);
+      return integrate_I3_with(integrate, threshold + q_eval, masses[0],
+                               masses[1], masses[2]) /
+             (q_eval * q_eval);
+    });
+    tabulation = I3_tabulations.emplace(masses, std::move(tab)).first;
+  }
+  return tabulation->second.get_value_linear(q) * q * q;
+}
+
+double ScatterActionMulti::calculate_I3(const double sqrts) const {
+  std::array<double, 3> pole_masses;
+  for (int i = 0; i < 3; i++) {
+    const ParticleData &in_part = incoming_particles_[i];
+    pole_masses[i] = in_part.pole_mass();
+    if (std::abs(in_part.effective_mass() - pole_masses[i]) > really_small) {
+      return integrate_I3(sqrts, incoming_particles_[0].effective_mass(),
+                          incoming_particles_[1].effective_mass(),
+                          incoming_particles_[2].effective_mass());
+    }
+  }
+  return tabulated_I3(sqrts, pole_masses[0], pole_masses[1], pole_masses[2]);
+}
+
 double ScatterActionMulti::probability_three_to_one(
     const ParticleType& type_out, double dt, const double gcell_vol,
     const int degen_factor) const {
@@ -88,8 +88,11 @@ ScatterActionPhoton::ReactionType ScatterActionPhoton::photon_reaction_type(
 }
 
 void ScatterActionPhoton::perform_photons(const OutputsList &outputs) {
+  /* The kinematics of the incoming particles are the same for all fractional
+   * photons, only t and phi are sampled per photon. */
+  const FinalStateSetup setup = setup_final_state();
   for (int i = 0; i < number_of_fractional_photons_; i++) {
-    generate_final_state();
+    sample_final_state(setup);
     for (const auto &output : outputs) {
       if (output->is_photon_output()) {
         // we do not care about the local density
@@ -189,6 +192,10 @@ bool ScatterActionPhoton::is_kinematically_possible(const double s_sqrt,
 }
 
 void ScatterActionPhoton::generate_final_state() {
+  sample_final_state(setup_final_state());
+}
+
+ScatterActionPhoton::FinalStateSetup ScatterActionPhoton::setup_final_state() {
   // we have only one reaction per incoming particle pair
   if (collision_processes_photons_.size() != 1) {
     logg[LScatterAction].fatal()
@@ -200,7 +207,8 @@ void ScatterActionPhoton::generate_final_state() {
   outgoing_particles_ = proc->particle_list();
   process_type_ = proc->get_type();
 
-  FourVector middle_point = get_interaction_point();
+  FinalStateSetup setup;
+  setup.middle_point = get_interaction_point();
 
   // t is defined to be the momentum exchanged between the rho meson and the
   // photon in pi + rho -> pi + photon channel. Therefore,
@@ -221,17 +229,38 @@ void ScatterActionPhoton::generate_final_state() {
   const double s = mandelstam_s();
   const double sqrts = sqrt_s();
   std::array<double, 2> mandelstam_t = get_t_range(sqrts, m1, m2, m_out, 0.0);
-  const double t1 = mandelstam_t[1];
-  const double t2 = mandelstam_t[0];
   const double pcm_in = cm_momentum();
-  const double pcm_out = pCM(sqrts, m_out, 0.0);
+  setup.s = s;
+  setup.sqrts = sqrts;
+  setup.t1 = mandelstam_t[1];
+  setup.t2 = mandelstam_t[0];
+  setup.m2_sqr = pow_int(m2, 2);
+  setup.costheta_shift = 0.5 * (s + pow_int(m2, 2) - pow_int(m1, 2)) *
+                         (s - pow_int(m_out, 2)) / s;
+  setup.costheta_norm = pcm_in * (s - pow_int(m_out, 2)) / sqrts;
+  setup.pcm_out = pCM(sqrts, m_out, 0.0);
+
+  /* The total momentum of the outgoing particles only depends on the incoming
+   * particles and the outgoing types, so the potentials at the interaction
+   * point are looked up once per scattering. */
+  setup.beta_cm = total_momentum_of_outgoing_particles().velocity();
+
+  // if rho in final state take already sampled mass (same as m_out). If rho
+  // is incoming take the mass of the incoming particle
+  setup.m_rho = rho_mass();
+  setup.weight_norm = number_of_fractional_photons_ * hadronic_cross_section();
+  setup.xsec_scaling = incoming_particles_[0].xsec_scaling_factor() *
+                       incoming_particles_[1].xsec_scaling_factor();
+  return setup;
+}
 
+void ScatterActionPhoton::sample_final_state(const FinalStateSetup &setup) {
+  const double t1 = setup.t1;
+  const double t2 = setup.t2;
   const double t = random::uniform(t1, t2);
 
-  double costheta = (t - pow_int(m2, 2) +
-                     0.5 * (s + pow_int(m2, 2) - pow_int(m1, 2)) *
-                         (s - pow_int(m_out, 2)) / s) /
-                    (pcm_in * (s - pow_int(m_out, 2)) / sqrts);
+  double costheta =
+      (t - setup.m2_sqr + setup.costheta_shift) / setup.costheta_norm;
 
   // on very rare occasions near the kinematic threshold numerical issues give
   // unphysical angles.
@@ -247,29 +276,24 @@ void ScatterActionPhoton::generate_final_state() {
   }
   Angles phitheta(random::uniform(0.0, twopi), costheta);
   outgoing_particles_[0].set_4momentum(hadron_out_mass_,
-                                       phitheta.threevec() * pcm_out);
-  outgoing_particles_[1].set_4momentum(0.0, -phitheta.threevec() * pcm_out);
+                                       phitheta.threevec() * setup.pcm_out);
+  outgoing_particles_[1].set_4momentum(0.0,
+                                       -phitheta.threevec() * setup.pcm_out);
 
   // Set positions & boost to computational frame.
   for (ParticleData &new_particle : outgoing_particles_) {
-    new_particle.set_4position(middle_point);
-    new_particle.boost_momentum(
-        -total_momentum_of_outgoing_particles().velocity());
+    new_particle.set_4position(setup.middle_point);
+    new_particle.boost_momentum(-setup.beta_cm);
   }
 
   const double E_Photon = outgoing_particles_[1].momentum()[0];
 
   // Weighing of the fractional photons
   if (number_of_fractional_photons_ > 1) {
-    // if rho in final state take already sampled mass (same as m_out). If rho
-    // is incoming take the mass of the incoming particle
-    const double m_rho = rho_mass();
-
     // compute the differential cross section with form factor included
-    const double diff_xs = diff_cross_section_w_ff(t, m_rho, E_Photon);
+    const double diff_xs = diff_cross_section_w_ff(t, setup.m_rho, E_Photon);
 
-    weight_ = diff_xs * (t2 - t1) /
-              (number_of_fractional_photons_ * hadronic_cross_section());
+    weight_ = diff_xs * (t2 - t1) / setup.weight_norm;
   } else {
     // compute the total cross section with form factor included
     const double total_xs = total_cross_section_w_ff(E_Photon);
@@ -277,8 +301,7 @@ void ScatterActionPhoton::generate_final_state() {
     weight_ = total_xs / hadronic_cross_section();
   }
   // Scale weight by cross section scaling factor of incoming particles
-  weight_ *= incoming_particles_[0].xsec_scaling_factor() *
-             incoming_particles_[1].xsec_scaling_factor();
+  weight_ *= setup.xsec_scaling;
 
   // Photons are not really part of the normal processes, so we have to set a
   // constant arbitrary number.
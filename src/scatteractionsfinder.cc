@@ -10,7 +10,14 @@
 #include "smash/scatteractionsfinder.h"
 
 #include <algorithm>
+#include <array>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
 #include <map>
+#include <sstream>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "smash/constants.h"
@@ -21,6 +28,7 @@
 #include "smash/scatteractionmulti.h"
 #include "smash/scatteractionphoton.h"
 #include "smash/stringfunctions.h"
+#include "smash/subprocesses.h"
 
 namespace smash {
 static constexpr int LFindScatter = LogArea::FindScatter::id;
@@ -623,6 +631,35 @@ ActionList ScatterActionsFinder::find_actions_with_neighbors(
   return actions;
 }
 
+/**
+ * Find the periodic images of a particle along one axis of the box that can
+ * collide with another particle within a time interval. These are the images
+ * that are, along this axis, the closest one to the other particle at some
+ * time within the interval. Like for the neighboring cells of the periodic
+ * grid, only the images in the neighboring boxes are considered.
+ *
+ * \param[in] distance Distance of the particle to the other one along the
+ *            axis [fm]
+ * \param[in] displacement Change of this distance within the time interval
+ *            [fm]
+ * \param[in] length Length of the box [fm]
+ * \param[out] shifts Shifts of the images along the axis [fm]
+ * \return Number of images written to \p shifts
+ */
+static int periodic_image_shifts(double distance, double displacement,
+                                 double length, std::array<double, 3> *shifts) {
+  int n_images = 0;
+  for (int k = -1; k <= 1; k++) {
+    const double start = distance + k * length;
+    const double end = start + displacement;
+    if (std::min(start, end) <= 0.5 * length &&
+        std::max(start, end) >= -0.5 * length) {
+      (*shifts)[n_images++] = k * length;
+    }
+  }
+  return n_images;
+}
+
 ActionList ScatterActionsFinder::find_actions_with_surrounding_particles(
     const ParticleList& search_list, const Particles& surrounding_list,
     double dt, const std::vector<FourVector>& beam_momentum) const {
@@ -641,93 +678,177 @@ ActionList ScatterActionsFinder::find_actions_with_surrounding_particles(
       continue;
     }
     for (const ParticleData& p1 : search_list) {
-      // Check if a collision is possible.
-      ActionPtr act = check_collision_two_part(p1, p2, dt, beam_momentum);
-      if (act) {
-        actions.push_back(std::move(act));
+      if (!periodic_surroundings_) {
+        // Check if a collision is possible.
+        ActionPtr act = check_collision_two_part(p1, p2, dt, beam_momentum);
+        if (act) {
+          actions.push_back(std::move(act));
+        }
+        continue;
+      }
+      // Check the images of p2 that can collide with p1 through the walls.
+      const ThreeVector distance =
+          p2.position().threevec() - p1.position().threevec();
+      const ThreeVector displacement = (p2.velocity() - p1.velocity()) * dt;
+      std::array<std::array<double, 3>, 3> shifts;
+      std::array<int, 3> n_images;
+      for (int i = 0; i < 3; i++) {
+        n_images[i] = periodic_image_shifts(distance[i], displacement[i],
+                                            box_length_, &shifts[i]);
+      }
+      for (int ix = 0; ix < n_images[0]; ix++) {
+        for (int iy = 0; iy < n_images[1]; iy++) {
+          for (int iz = 0; iz < n_images[2]; iz++) {
+            const FourVector shift(0., shifts[0][ix], shifts[1][iy],
+                                   shifts[2][iz]);
+            ActionPtr act;
+            if (shift == FourVector()) {
+              act = check_collision_two_part(p1, p2, dt, beam_momentum);
+            } else {
+              ParticleData image = p2;
+              image.set_4position(p2.position() + shift);
+              act = check_collision_two_part(p1, image, dt, beam_momentum);
+            }
+            if (act) {
+              actions.push_back(std::move(act));
+            }
+          }
+        }
       }
     }
   }
   return actions;
 }
 
-void ScatterActionsFinder::dump_reactions() const {
+void ScatterActionsFinder::dump_reactions(DumpFormat format,
+                                          int n_workers) const {
   constexpr double time = 0.0;
 
   const size_t N_isotypes = IsoParticleType::list_all().size();
   const size_t N_pairs = N_isotypes * (N_isotypes - 1) / 2;
 
-  std::cout << N_isotypes << " iso-particle types." << std::endl;
-  std::cout << "They can make " << N_pairs << " pairs." << std::endl;
-  std::vector<double> momentum_scan_list = {0.1, 0.3, 0.5, 1.0,
-                                            2.0, 3.0, 5.0, 10.0};
+  if (format == DumpFormat::Table) {
+    std::cout << N_isotypes << " iso-particle types." << std::endl;
+    std::cout << "They can make " << N_pairs << " pairs." << std::endl;
+  }
+  std::vector<std::pair<const IsoParticleType*, const IsoParticleType*>>
+      isotype_pairs;
   for (const IsoParticleType& A_isotype : IsoParticleType::list_all()) {
     for (const IsoParticleType& B_isotype : IsoParticleType::list_all()) {
-      if (&A_isotype > &B_isotype) {
-        continue;
+      if (&A_isotype <= &B_isotype) {
+        isotype_pairs.emplace_back(&A_isotype, &B_isotype);
       }
-      bool any_nonzero_cs = false;
-      std::vector<std::string> r_list;
-      for (const ParticleTypePtr A_type : A_isotype.get_states()) {
-        for (const ParticleTypePtr B_type : B_isotype.get_states()) {
-          if (A_type > B_type) {
+    }
+  }
+  const std::vector<double> momentum_scan_list = {0.1, 0.3, 0.5, 1.0,
+                                                  2.0, 3.0, 5.0, 10.0};
+  /* Every pair of iso-particle types yields its sorted reactions, each
+   * terminated by a line break. The pairs are evaluated independently. */
+  auto find_reactions = [&](size_t i_pair) {
+    const IsoParticleType& A_isotype = *isotype_pairs[i_pair].first;
+    const IsoParticleType& B_isotype = *isotype_pairs[i_pair].second;
+    std::vector<std::string> r_list;
+    for (const ParticleTypePtr A_type : A_isotype.get_states()) {
+      for (const ParticleTypePtr B_type : B_isotype.get_states()) {
+        if (A_type > B_type) {
+          continue;
+        }
+        ParticleData A(*A_type), B(*B_type);
+        for (auto mom : momentum_scan_list) {
+          A.set_4momentum(A.pole_mass(), mom, 0.0, 0.0);
+          B.set_4momentum(B.pole_mass(), -mom, 0.0, 0.0);
+          ScatterActionPtr act = make_unique<ScatterAction>(
+              A, B, time, isotropic_, string_formation_time_);
+          if (strings_switch_) {
+            act->set_string_interface(string_process_interface_.get());
+          }
+          act->add_all_scatterings(
+              elastic_parameter_, two_to_one_, incl_set_, incl_multi_set_,
+              low_snn_cut_, strings_switch_, use_AQM_,
+              strings_with_probability_, nnbar_treatment_, scale_xs_,
+              additional_el_xs_);
+          const double total_cs = act->cross_section();
+          if (total_cs <= 0.0) {
             continue;
           }
-          ParticleData A(*A_type), B(*B_type);
-          for (auto mom : momentum_scan_list) {
-            A.set_4momentum(A.pole_mass(), mom, 0.0, 0.0);
-            B.set_4momentum(B.pole_mass(), -mom, 0.0, 0.0);
-            ScatterActionPtr act = make_unique<ScatterAction>(
-                A, B, time, isotropic_, string_formation_time_);
-            if (strings_switch_) {
-              act->set_string_interface(string_process_interface_.get());
-            }
-            act->add_all_scatterings(
-                elastic_parameter_, two_to_one_, incl_set_, incl_multi_set_,
-                low_snn_cut_, strings_switch_, use_AQM_,
-                strings_with_probability_, nnbar_treatment_, scale_xs_,
-                additional_el_xs_);
-            const double total_cs = act->cross_section();
-            if (total_cs <= 0.0) {
-              continue;
-            }
-            any_nonzero_cs = true;
-            for (const auto& channel : act->collision_channels()) {
-              const auto type = channel->get_type();
-              std::string r;
-              if (is_string_soft_process(type) ||
-                  type == ProcessType::StringHard) {
-                r = A_type->name() + B_type->name() + std::string(" → strings");
-              } else {
-                std::string r_type =
-                    (type == ProcessType::Elastic)
-                        ? std::string(" (el)")
-                        : (channel->get_type() == ProcessType::TwoToTwo)
-                              ? std::string(" (inel)")
-                              : std::string(" (?)");
-                r = A_type->name() + B_type->name() + std::string(" → ") +
-                    channel->particle_types()[0]->name() +
-                    channel->particle_types()[1]->name() + r_type;
-              }
-              isoclean(r);
-              r_list.push_back(r);
+          for (const auto& channel : act->collision_channels()) {
+            const auto type = channel->get_type();
+            std::string r;
+            if (is_string_soft_process(type) ||
+                type == ProcessType::StringHard) {
+              r = A_type->name() + B_type->name() + std::string(" → strings");
+            } else {
+              std::string r_type =
+                  (type == ProcessType::Elastic)
+                      ? std::string(" (el)")
+                      : (channel->get_type() == ProcessType::TwoToTwo)
+                            ? std::string(" (inel)")
+                            : std::string(" (?)");
+              r = A_type->name() + B_type->name() + std::string(" → ") +
+                  channel->particle_types()[0]->name() +
+                  channel->particle_types()[1]->name() + r_type;
             }
+            isoclean(r);
+            r_list.push_back(r);
           }
         }
       }
-      std::sort(r_list.begin(), r_list.end());
-      r_list.erase(std::unique(r_list.begin(), r_list.end()), r_list.end());
-      if (any_nonzero_cs) {
-        for (auto r : r_list) {
-          std::cout << r;
-          if (r_list.back() != r) {
-            std::cout << ", ";
-          }
+    }
+    std::sort(r_list.begin(), r_list.end());
+    r_list.erase(std::unique(r_list.begin(), r_list.end()), r_list.end());
+    std::string reactions;
+    for (const auto& r : r_list) {
+      reactions += r + '\n';
+    }
+    return reactions;
+  };
+  const std::vector<std::string> reactions_of_pairs =
+      run_in_subprocesses(isotype_pairs.size(), n_workers, find_reactions);
+
+  bool first_pair = true;
+  if (format == DumpFormat::CSV) {
+    std::cout << "isotype_a,isotype_b,reaction\n";
+  } else if (format == DumpFormat::JSON) {
+    std::cout << "[";
+  }
+  for (size_t i_pair = 0; i_pair < isotype_pairs.size(); i_pair++) {
+    const std::vector<std::string> r_list =
+        split(reactions_of_pairs[i_pair], '\n');
+    if (r_list.empty()) {
+      continue;
+    }
+    const std::string& name_a = isotype_pairs[i_pair].first->name();
+    const std::string& name_b = isotype_pairs[i_pair].second->name();
+    switch (format) {
+      case DumpFormat::Table:
+        for (size_t i = 0; i < r_list.size(); i++) {
+          std::cout << (i > 0 ? ", " : "") << r_list[i];
         }
         std::cout << std::endl;
-      }
+        break;
+      case DumpFormat::CSV:
+        for (const auto& r : r_list) {
+          std::cout << quote_csv(name_a) << ',' << quote_csv(name_b) << ','
+                    << quote_csv(r) << '\n';
+        }
+        break;
+      case DumpFormat::JSON:
+        std::cout << (first_pair ? "\n" : ",\n") << "  {\"isotype_a\": "
+                  << quote_json(name_a)
+                  << ", \"isotype_b\": " << quote_json(name_b)
+                  << ", \"reactions\": [";
+        for (size_t i = 0; i < r_list.size(); i++) {
+          std::cout << (i > 0 ? ", " : "") << quote_json(r_list[i]);
+        }
+        std::cout << "]}";
+        break;
     }
+    first_pair = false;
+  }
+  if (format == DumpFormat::JSON) {
+    std::cout << "\n]\n";
   }
+  std::cout << std::flush;
 }
 
 /// Represent a final-state cross section.
@@ -1041,12 +1162,12 @@ static void deduplicate(std::vector<FinalStateCrossSection>& final_state_xs) {
 
 void ScatterActionsFinder::dump_cross_sections(
     const ParticleType& a, const ParticleType& b, double m_a, double m_b,
-    bool final_state, std::vector<double>& plab) const {
+    bool final_state, std::vector<double>& plab, DumpFormat format,
+    int n_workers) const {
   typedef std::vector<std::pair<double, double>> xs_saver;
   std::map<std::string, xs_saver> xs_dump;
   std::map<std::string, double> outgoing_total_mass;
 
-  ParticleData a_data(a), b_data(b);
   int n_momentum_points = 200;
   constexpr double momentum_step = 0.02;
   /*
@@ -1056,22 +1177,28 @@ void ScatterActionsFinder::dump_cross_sections(
   }
   */
   if (plab.size() > 0) {
-    n_momentum_points = plab.size();
     // Remove duplicates.
     std::sort(plab.begin(), plab.end());
     plab.erase(std::unique(plab.begin(), plab.end()), plab.end());
+    n_momentum_points = plab.size();
   }
+  std::vector<double> momenta(n_momentum_points);
   for (int i = 0; i < n_momentum_points; i++) {
-    double momentum;
     if (plab.size() > 0) {
-      momentum = pCM_from_s(s_from_plab(plab.at(i), m_a, m_b), m_a, m_b);
+      momenta[i] = pCM_from_s(s_from_plab(plab.at(i), m_a, m_b), m_a, m_b);
     } else {
-      momentum = momentum_step * (i + 1);
+      momenta[i] = momentum_step * (i + 1);
     }
-    a_data.set_4momentum(m_a, momentum, 0.0, 0.0);
-    b_data.set_4momentum(m_b, -momentum, 0.0, 0.0);
+  }
+
+  /* Every momentum point yields sqrt(s) in the first line, followed by one
+   * line per cross section with its value, the total pole mass of the final
+   * state and its name. The momentum points are evaluated independently. */
+  auto find_cross_sections = [&](size_t i) {
+    ParticleData a_data(a), b_data(b);
+    a_data.set_4momentum(m_a, momenta[i], 0.0, 0.0);
+    b_data.set_4momentum(m_b, -momenta[i], 0.0, 0.0);
     const double sqrts = (a_data.momentum() + b_data.momentum()).abs();
-    const ParticleList incoming = {a_data, b_data};
     ScatterActionPtr act = make_unique<ScatterAction>(
         a_data, b_data, 0., isotropic_, string_formation_time_);
     if (strings_switch_) {
@@ -1083,32 +1210,23 @@ void ScatterActionsFinder::dump_cross_sections(
                              nnbar_treatment_, scale_xs_, additional_el_xs_);
     decaytree::Node tree(a.name() + b.name(), act->cross_section(), {&a, &b},
                          {&a, &b}, {&a, &b}, {});
+    std::vector<FinalStateCrossSection> xs_list;
     const CollisionBranchList& processes = act->collision_channels();
     for (const auto& process : processes) {
       const double xs = process->weight();
       if (xs <= 0.0) {
         continue;
       }
+      std::stringstream process_description_stream;
+      process_description_stream << *process;
+      const std::string& description = process_description_stream.str();
       if (!final_state) {
-        std::stringstream process_description_stream;
-        process_description_stream << *process;
-        const std::string& description = process_description_stream.str();
         double m_tot = 0.0;
         for (const auto& ptype : process->particle_types()) {
           m_tot += ptype->mass();
         }
-        outgoing_total_mass[description] = m_tot;
-        if (!xs_dump[description].empty() &&
-            std::abs(xs_dump[description].back().first - sqrts) <
-                really_small) {
-          xs_dump[description].back().second += xs;
-        } else {
-          xs_dump[description].push_back(std::make_pair(sqrts, xs));
-        }
+        xs_list.emplace_back(description, xs, m_tot);
       } else {
-        std::stringstream process_description_stream;
-        process_description_stream << *process;
-        const std::string& description = process_description_stream.str();
         ParticleTypePtrList initial_particles = {&a, &b};
         ParticleTypePtrList final_particles = process->particle_types();
         auto& process_node =
@@ -1117,9 +1235,8 @@ void ScatterActionsFinder::dump_cross_sections(
         decaytree::add_decays(process_node, sqrts);
       }
     }
-    xs_dump["total"].push_back(std::make_pair(sqrts, act->cross_section()));
     // Total cross-section should be the first in the list -> negative mass
-    outgoing_total_mass["total"] = -1.0;
+    xs_list.emplace_back("total", act->cross_section(), -1.0);
     if (final_state) {
       // tree.print();
       auto final_state_xs = tree.final_state_cross_sections();
@@ -1132,8 +1249,38 @@ void ScatterActionsFinder::dump_cross_sections(
         if (p.name_ == "") {
           continue;
         }
-        outgoing_total_mass[p.name_] = p.mass_;
-        xs_dump[p.name_].push_back(std::make_pair(sqrts, p.cross_section_));
+        xs_list.push_back(p);
+      }
+    }
+    // 17 significant digits are enough to restore the exact values.
+    std::stringstream point;
+    point << std::setprecision(17) << sqrts << '\n';
+    for (const auto& p : xs_list) {
+      point << p.cross_section_ << ' ' << p.mass_ << ' ' << p.name_ << '\n';
+    }
+    return point.str();
+  };
+  const std::vector<std::string> points =
+      run_in_subprocesses(momenta.size(), n_workers, find_cross_sections);
+
+  // Collect the cross sections in the order of the momentum points
+  std::vector<double> sqrts_list;
+  for (const std::string& point : points) {
+    std::istringstream point_stream(point);
+    double sqrts;
+    point_stream >> sqrts;
+    sqrts_list.push_back(sqrts);
+    double xs, mass;
+    std::string name;
+    while (point_stream >> xs >> mass && point_stream.ignore() &&
+           std::getline(point_stream, name)) {
+      outgoing_total_mass[name] = mass;
+      xs_saver& energy_and_xs = xs_dump[name];
+      if (!energy_and_xs.empty() &&
+          std::abs(energy_and_xs.back().first - sqrts) < really_small) {
+        energy_and_xs.back().second += xs;
+      } else {
+        energy_and_xs.push_back(std::make_pair(sqrts, xs));
       }
     }
   }
@@ -1164,43 +1311,78 @@ void ScatterActionsFinder::dump_cross_sections(
               return outgoing_total_mass[str_a] < outgoing_total_mass[str_b];
             });
 
-  // Print header
-  std::cout << "# Dumping partial " << a.name() << b.name()
-            << " cross-sections in mb, energies in GeV" << std::endl;
-  std::cout << "   sqrt_s";
-  // Align everything to 16 unicode characters.
-  // This should be enough for the longest channel name (7 final-state
-  // particles).
-  for (const auto& channel : all_channels) {
-    std::cout << utf8::fill_left(channel, 16, ' ');
-  }
-  std::cout << std::endl;
-
-  // Print out all partial cross-sections in mb
-  for (int i = 0; i < n_momentum_points; i++) {
-    double momentum;
-    if (plab.size() > 0) {
-      momentum = pCM_from_s(s_from_plab(plab.at(i), m_a, m_b), m_a, m_b);
-    } else {
-      momentum = momentum_step * (i + 1);
+  // Partial cross section of the channel at the given energy in mb
+  auto get_xs = [&](const std::string& channel, double sqrts) {
+    const xs_saver& energy_and_xs = xs_dump[channel];
+    size_t j = 0;
+    for (; j < energy_and_xs.size() && energy_and_xs[j].first < sqrts; j++) {
     }
-    a_data.set_4momentum(m_a, momentum, 0.0, 0.0);
-    b_data.set_4momentum(m_b, -momentum, 0.0, 0.0);
-    const double sqrts = (a_data.momentum() + b_data.momentum()).abs();
-    std::printf("%9.6f", sqrts);
-    for (const auto& channel : all_channels) {
-      const xs_saver energy_and_xs = xs_dump[channel];
-      size_t j = 0;
-      for (; j < energy_and_xs.size() && energy_and_xs[j].first < sqrts; j++) {
+    double xs = 0.0;
+    if (j < energy_and_xs.size() &&
+        std::abs(energy_and_xs[j].first - sqrts) < really_small) {
+      xs = energy_and_xs[j].second;
+    }
+    return xs;
+  };
+
+  switch (format) {
+    case DumpFormat::Table:
+      // Print header
+      std::cout << "# Dumping partial " << a.name() << b.name()
+                << " cross-sections in mb, energies in GeV" << std::endl;
+      std::cout << "   sqrt_s";
+      // Align everything to 16 unicode characters.
+      // This should be enough for the longest channel name (7 final-state
+      // particles).
+      for (const auto& channel : all_channels) {
+        std::cout << utf8::fill_left(channel, 16, ' ');
       }
-      double xs = 0.0;
-      if (j < energy_and_xs.size() &&
-          std::abs(energy_and_xs[j].first - sqrts) < really_small) {
-        xs = energy_and_xs[j].second;
+      std::cout << std::endl;
+
+      // Print out all partial cross-sections in mb
+      for (const double sqrts : sqrts_list) {
+        std::printf("%9.6f", sqrts);
+        for (const auto& channel : all_channels) {
+          // Same alignment as in the header.
+          std::printf("%16.6f", get_xs(channel, sqrts));
+        }
+        std::printf("\n");
       }
-      std::printf("%16.6f", xs);  // Same alignment as in the header.
-    }
-    std::printf("\n");
+      break;
+    case DumpFormat::CSV:
+      std::cout << "sqrt_s";
+      for (const auto& channel : all_channels) {
+        std::cout << ',' << quote_csv(channel);
+      }
+      std::cout << std::endl;
+      for (const double sqrts : sqrts_list) {
+        std::printf("%.10g", sqrts);
+        for (const auto& channel : all_channels) {
+          std::printf(",%.10g", get_xs(channel, sqrts));
+        }
+        std::printf("\n");
+      }
+      break;
+    case DumpFormat::JSON:
+      std::cout << "{\n  \"particle_a\": " << quote_json(a.name())
+                << ",\n  \"particle_b\": " << quote_json(b.name())
+                << ",\n  \"final_state\": " << (final_state ? "true" : "false")
+                << ",\n  \"sqrt_s\": [" << std::flush;
+      for (size_t i = 0; i < sqrts_list.size(); i++) {
+        std::printf(i > 0 ? ", %.10g" : "%.10g", sqrts_list[i]);
+      }
+      std::printf("],\n  \"cross_sections\": {");
+      for (size_t k = 0; k < all_channels.size(); k++) {
+        std::printf("%s\n    %s: [", k > 0 ? "," : "",
+                    quote_json(all_channels[k]).c_str());
+        for (size_t i = 0; i < sqrts_list.size(); i++) {
+          std::printf(i > 0 ? ", %.10g" : "%.10g",
+                      get_xs(all_channels[k], sqrts_list[i]));
+        }
+        std::printf("]");
+      }
+      std::printf("\n  }\n}\n");
+      break;
   }
 }
 
@@ -119,6 +119,13 @@ void usage(const int rc, const std::string &progname) {
    *     the resonances masses are sampled from the spectral function.
    *     Typically, this results in errors of less than 1 mb in the worst case.
    *     Also, contributions from strings are not considered.
+   * <tr><td>`-F <format>` <td>`--dump-format <format>`
+   * <td>Output format of `-l`, `-s` and `-S`: `table` (default), `csv` or
+   *     `json`.
+   * <tr><td>`-j <n>` <td>`--jobs <n>`
+   * <td>Number of worker processes for `-l`, `-s` and `-S`. The particle
+   *     pairs (for `-l`) or the energies (for `-s` and `-S`) are distributed
+   *     over the workers. The output does not depend on their number.
    * <tr><td>`-f` <td>`--force`
    * <td>Forces overwriting files in the output directory. Normally, if you
    *     specifiy an output directory with `-o`, the directory must be empty.
@@ -161,6 +168,10 @@ void usage(const int rc, const std::string &progname) {
       "                          Masses are optional, by default pole masses"
       " are used.\n"
       "                          Note the required comma and no spaces.\n"
+      "  -F, --dump-format <fmt> output format of -l, -s and -S:\n"
+      "                          table (default), csv or json\n"
+      "  -j, --jobs <n>          number of worker processes for -l, -s and -S"
+      "\n"
       "  -f, --force             force overwriting files in the output "
       "directory"
       "\n"
@@ -391,6 +402,7 @@ void initialize_particles_and_decays(Configuration &configuration,
   initialize_particles_and_decays(configuration);
   logg[LMain].info("Tabulating cross section integrals...");
   IsoParticleType::tabulate_integrals(hash, tabulations_path);
+  ParticleType::tabulate_spectral_functions();
 }
 
 }  // unnamed namespace
@@ -424,6 +436,8 @@ int main(int argc, char *argv[]) {
       {"resonance", required_argument, 0, 'r'},
       {"cross-sections", required_argument, 0, 's'},
       {"cross-sections-fs", required_argument, 0, 'S'},
+      {"dump-format", required_argument, 0, 'F'},
+      {"jobs", required_argument, 0, 'j'},
       {"dump-iSS", no_argument, 0, 'x'},
       {"version", no_argument, 0, 'v'},
       {"no-cache", no_argument, 0, 'n'},
@@ -445,11 +459,13 @@ int main(int argc, char *argv[]) {
     bool final_state_cross_sections = false;
     bool particles_dump_iSS_format = false;
     bool cache_integrals = true;
+    DumpFormat dump_format = DumpFormat::Table;
+    int n_jobs = 1;
 
     // parse command-line arguments
     int opt;
     bool suppress_disclaimer = false;
-    while ((opt = getopt_long(argc, argv, "c:d:e:fhi:m:p:o:lr:s:S:xvnq",
+    while ((opt = getopt_long(argc, argv, "c:d:e:fF:hi:j:m:p:o:lr:s:S:xvnq",
                               longopts, nullptr)) != -1) {
       switch (opt) {
         case 'c':
@@ -496,6 +512,25 @@ int main(int argc, char *argv[]) {
           cs_string = optarg;
           suppress_disclaimer = true;
           break;
+        case 'F': {
+          const std::string format(optarg);
+          if (format == "table") {
+            dump_format = DumpFormat::Table;
+          } else if (format == "csv") {
+            dump_format = DumpFormat::CSV;
+          } else if (format == "json") {
+            dump_format = DumpFormat::JSON;
+          } else {
+            throw std::invalid_argument("Unknown dump format: " + format);
+          }
+          break;
+        }
+        case 'j':
+          n_jobs = std::stoi(optarg);
+          if (n_jobs < 1) {
+            throw std::invalid_argument("The number of jobs must be positive.");
+          }
+          break;
         case 'x':
           particles_dump_iSS_format = true;
           suppress_disclaimer = true;
@@ -608,7 +643,7 @@ int main(int argc, char *argv[]) {
       ignore_simulation_config_values(configuration);
       check_for_unused_config_values(configuration);
 
-      scat_finder.dump_reactions();
+      scat_finder.dump_reactions(dump_format, n_jobs);
       std::exit(EXIT_SUCCESS);
     }
     if (particles_dump_iSS_format) {
@@ -705,7 +740,7 @@ int main(int argc, char *argv[]) {
       check_for_unused_config_values(configuration);
 
       scat_finder.dump_cross_sections(a, b, ma, mb, final_state_cross_sections,
-                                      plab);
+                                      plab, dump_format, n_jobs);
       std::exit(EXIT_SUCCESS);
     }
     if (modus) {
@@ -12,10 +12,12 @@
 #include <cstdlib>
 #include <list>
 #include <map>
+#include <mutex>
 #include <utility>
 #include <vector>
 
 #include "smash/angles.h"
+#include "smash/batchsampling.h"
 #include "smash/chemicalpotential.h"
 #include "smash/configuration.h"
 #include "smash/constants.h"
@@ -97,6 +99,12 @@ static constexpr int LSphere = LogArea::Sphere::id;
  * \li \key Jet_Momentum (double, optional, default = 20.):
  * The initial momentum to give to the jet particle (in GeV)
  *
+ * \key Sampling_Threads (int, optional, default = 1): \n
+ * Number of threads used to sample the initial masses, momenta and positions.
+ * The particles are sampled in batches of one species, each with its own
+ * random number stream derived from the event seed, so the initial state does
+ * not depend on the number of threads.
+ *
  * \n
  * Examples: Configuring a Sphere Simulation
  * --------------
@@ -183,7 +191,12 @@ SphereModus::SphereModus(Configuration modus_config,
       jet_pdg_(insert_jet_ ? modus_config.take({"Sphere", "Jet", "Jet_PDG"})
                                  .convert_for(jet_pdg_)
                            : pdg::p),  // dummy default; never used
-      jet_mom_(modus_config.take({"Sphere", "Jet", "Jet_Momentum"}, 20.)) {}
+      jet_mom_(modus_config.take({"Sphere", "Jet", "Jet_Momentum"}, 20.)),
+      sampling_threads_(modus_config.take({"Sphere", "Sampling_Threads"}, 1)) {
+  if (sampling_threads_ < 1) {
+    throw std::invalid_argument("Sphere: Sampling_Threads has to be positive.");
+  }
+}
 
 /* console output on startup of sphere specific parameters */
 std::ostream &operator<<(std::ostream &out, const SphereModus &m) {
@@ -266,58 +279,106 @@ double SphereModus::initial_conditions(Particles *particles,
   if (this->init_distr_ == SphereInitialCondition::ThermalMomentaQuantum) {
     quantum_sampling = make_unique<QuantumSampling>(init_multipl_, V, T);
   }
-  /* loop over particle data to fill in momentum and position information */
-  for (ParticleData &data : *particles) {
-    Angles phitheta;
-    /* thermal momentum according Maxwell-Boltzmann distribution */
-    double momentum_radial = 0.0, mass = data.pole_mass();
+  /* The envelopes of the thermal mass distributions are found once per
+   * species. This is done before sampling in parallel, because it also
+   * initializes the lazily computed properties of the resonances. */
+  const bool sample_masses =
+      init_distr_ == SphereInitialCondition::ThermalMomentaBoltzmann &&
+      account_for_resonance_widths_;
+  std::map<PdgCode, HadronGasEos::ThermalMassEnvelope> mass_envelopes;
+  if (sample_masses) {
+    for (const ParticleData &data : *particles) {
+      if (mass_envelopes.count(data.pdgcode()) == 0) {
+        mass_envelopes.emplace(
+            data.pdgcode(),
+            HadronGasEos::thermal_mass_envelope(data.type(), 1.0 / T));
+      }
+    }
+  }
+  /* Envelopes whose maximum increased while sampling; they are reported
+   * after sampling, because the batches may be sampled on other threads. */
+  std::mutex increased_envelopes_mutex;
+  std::vector<std::pair<HadronGasEos::ThermalMassEnvelope,
+                        HadronGasEos::ThermalMassEnvelope>>
+      increased_envelopes;
+  /* fill in momentum and position information, one species at a time */
+  const auto sample_batch = [&](const ParticleBatch &batch,
+                                random::Engine &rng) {
+    const ParticleType &type = batch.type();
+    const double pole_mass = type.mass();
+    std::vector<double> masses(batch.size(), pole_mass);
+    std::vector<double> momenta(batch.size());
     /* assign momentum_radial according to requested distribution */
     switch (init_distr_) {
       case (SphereInitialCondition::IC_ES):
-        momentum_radial = sample_momenta_IC_ES(T);
+        for (double &momentum_radial : momenta) {
+          momentum_radial = sample_momenta_IC_ES(T, rng);
+        }
         break;
       case (SphereInitialCondition::IC_1M):
-        momentum_radial = sample_momenta_1M_IC(T, mass);
+        for (double &momentum_radial : momenta) {
+          momentum_radial = sample_momenta_1M_IC(T, pole_mass, rng);
+        }
         break;
       case (SphereInitialCondition::IC_2M):
-        momentum_radial = sample_momenta_2M_IC(T, mass);
+        for (double &momentum_radial : momenta) {
+          momentum_radial = sample_momenta_2M_IC(T, pole_mass, rng);
+        }
         break;
       case (SphereInitialCondition::IC_Massive):
-        momentum_radial = sample_momenta_non_eq_mass(T, mass);
+        for (double &momentum_radial : momenta) {
+          momentum_radial = sample_momenta_non_eq_mass(T, pole_mass, rng);
+        }
         break;
       case (SphereInitialCondition::ThermalMomentaBoltzmann):
       default:
-        mass = (!account_for_resonance_widths_)
-                   ? data.type().mass()
-                   : HadronGasEos::sample_mass_thermal(data.type(), 1.0 / T);
-        momentum_radial = sample_momenta_from_thermal(T, mass);
+        /* thermal momentum according Maxwell-Boltzmann distribution */
+        if (sample_masses) {
+          const auto &initial = mass_envelopes.at(type.pdgcode());
+          auto envelope = initial;
+          for (double &mass : masses) {
+            mass = HadronGasEos::sample_mass_thermal(envelope, rng);
+          }
+          if (envelope.max_ratio > initial.max_ratio) {
+            std::lock_guard<std::mutex> guard(increased_envelopes_mutex);
+            increased_envelopes.emplace_back(initial, envelope);
+          }
+        }
+        for (std::size_t i = 0; i < batch.size(); i++) {
+          momenta[i] = sample_momenta_from_thermal(T, masses[i], rng);
+        }
         break;
       case (SphereInitialCondition::ThermalMomentaQuantum):
         /*
-         * **********************************************************************
+         * ********************************************************************
          * Sampling the thermal momentum according Bose/Fermi/Boltzmann
          * distribution.
          * We take the pole mass as the mass.
-         * **********************************************************************
+         * ********************************************************************
          */
-        mass = data.type().mass();
-        momentum_radial = quantum_sampling->sample(data.pdgcode());
+        quantum_sampling->sample(type.pdgcode(), momenta, rng);
         break;
     }
-    phitheta.distribute_isotropically();
-    logg[LSphere].debug(data.type().name(), "(id ", data.id(),
-                        ") radial momentum ", momentum_radial, ", direction",
-                        phitheta);
-    data.set_4momentum(mass, phitheta.threevec() * momentum_radial);
+    Angles phitheta, pos_phitheta;
+    for (std::size_t i = 0; i < batch.size(); i++) {
+      ParticleData &data = batch[i];
+      phitheta.distribute_isotropically(rng);
+      data.set_4momentum(masses[i], phitheta.threevec() * momenta[i]);
+      /* uniform sampling in a sphere with radius r */
+      const double position_radial =
+          std::cbrt(random::canonical(rng)) * radius_;
+      pos_phitheta.distribute_isotropically(rng);
+      data.set_4position(
+          FourVector(start_time_, pos_phitheta.threevec() * position_radial));
+      data.set_formation_time(start_time_);
+    }
+  };
+  sample_in_batches(particles, sampling_threads_, sample_batch);
+  for (const auto &envelopes : increased_envelopes) {
+    HadronGasEos::warn_if_maximum_increased(envelopes.first, envelopes.second);
+  }
+  for (const ParticleData &data : *particles) {
     momentum_total += data.momentum();
-    /* uniform sampling in a sphere with radius r */
-    double position_radial;
-    position_radial = std::cbrt(random::canonical()) * radius_;
-    Angles pos_phitheta;
-    pos_phitheta.distribute_isotropically();
-    data.set_4position(
-        FourVector(start_time_, pos_phitheta.threevec() * position_radial));
-    data.set_formation_time(start_time_);
   }
   /* Make total 3-momentum 0 */
   for (ParticleData &data : *particles) {
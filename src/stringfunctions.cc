@@ -9,6 +9,7 @@
 
 #include "smash/stringfunctions.h"
 
+#include <cstdio>
 #include <sstream>
 
 namespace smash {
@@ -123,4 +124,50 @@ std::vector<std::string> split(const std::string &s, char delim) {
   return elems;
 }
 
+std::string quote_csv(const std::string &s) {
+  if (s.find_first_of(",\"\n\r") == std::string::npos) {
+    return s;
+  }
+  std::string quoted = "\"";
+  for (const char c : s) {
+    if (c == '"') {
+      quoted += '"';
+    }
+    quoted += c;
+  }
+  quoted += '"';
+  return quoted;
+}
+
+std::string quote_json(const std::string &s) {
+  std::string quoted = "\"";
+  for (const char c : s) {
+    switch (c) {
+      case '"':
+        quoted += "\\\"";
+        break;
+      case '\\':
+        quoted += "\\\\";
+        break;
+      case '\n':
+        quoted += "\\n";
+        break;
+      case '\t':
+        quoted += "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char escaped[7];
+          std::snprintf(escaped, sizeof(escaped), "\\u%04x",
+                        static_cast<unsigned int>(c));
+          quoted += escaped;
+        } else {
+          quoted += c;
+        }
+    }
+  }
+  quoted += '"';
+  return quoted;
+}
+
 }  // namespace smash
@@ -7,6 +7,7 @@
  *
  */
 
+#include <algorithm>
 #include <array>
 
 #include "smash/angles.h"
@@ -77,6 +78,9 @@ StringProcess::StringProcess(
   event_intermediate_.init("intermediate partons",
                            &pythia_hadron_->particleData);
 
+  cache_pythia_properties();
+  build_quantum_number_index();
+
   for (int imu = 0; imu < 3; imu++) {
     evecBasisAB_[imu] = ThreeVector(0., 0., 0.);
   }
@@ -84,6 +88,77 @@ StringProcess::StringProcess(
   final_state_.clear();
 }
 
+uint64_t StringProcess::quantum_number_key(int baryon, int iso3, int strange,
+                                           int charm, int bottom) {
+  // Each quantum number is shifted into [0, 256) and given 8 bits.
+  uint64_t key = 0;
+  for (int qnumber : {baryon, iso3, strange, charm, bottom}) {
+    assert(qnumber > -128 && qnumber < 128);
+    key = (key << 8) | static_cast<uint64_t>(qnumber + 128);
+  }
+  return key;
+}
+
+void StringProcess::cache_pythia_properties() {
+  Pythia8::ParticleData &particle_data = pythia_hadron_->particleData;
+  for (int pdgid = 1; pdgid < 6000; pdgid++) {
+    const int index = constituent_index(pdgid);
+    if (index < 0) {
+      continue;
+    }
+    ConstituentProperties &constituent = constituents_[index];
+    constituent.valid = particle_data.isParticle(pdgid) &&
+                        (particle_data.isQuark(pdgid) ||
+                         particle_data.isDiquark(pdgid));
+    if (!constituent.valid) {
+      continue;
+    }
+    constituent.is_diquark = particle_data.isDiquark(pdgid);
+    constituent.baryon_number_type = particle_data.baryonNumberType(pdgid);
+    constituent.mass = particle_data.m0(pdgid);
+    for (int iflav = 0; iflav < 5; iflav++) {
+      constituent.n_quarks[iflav] =
+          particle_data.nQuarksInCode(pdgid, iflav + 1);
+    }
+  }
+
+  pythia_sigma_pt_ = pythia_hadron_->parm("StringPT:sigma");
+  pythia_stop_mass_ = pythia_hadron_->parm("StringFragmentation:stopMass");
+  pythia_stop_smear_ = pythia_hadron_->parm("StringFragmentation:stopSmear");
+  pythia_enhanced_fraction_ =
+      pythia_hadron_->parm("StringPT:enhancedFraction");
+  pythia_enhanced_width_ = pythia_hadron_->parm("StringPT:enhancedWidth");
+}
+
+void StringProcess::build_quantum_number_index() {
+  resonances_by_quantum_numbers_.clear();
+  hadrons_by_quantum_numbers_.clear();
+  for (const ParticleType &ptype : ParticleType::list_all()) {
+    if (!ptype.is_hadron()) {
+      continue;
+    }
+    const PdgCode pdg = ptype.pdgcode();
+    const uint64_t key = quantum_number_key(
+        pdg.baryon_number(), pdg.isospin3(), pdg.strangeness(),
+        pdg.charmness(), pdg.bottomness());
+    const int pdgid = pdg.get_decimal();
+    if (!ptype.is_stable()) {
+      resonances_by_quantum_numbers_[key].push_back(
+          {pdgid, ptype.mass(), ptype.min_mass_spectral()});
+    }
+    if (pythia_hadron_->particleData.isParticle(pdgid)) {
+      HadronCandidates &hadrons = hadrons_by_quantum_numbers_[key];
+      if (hadrons.weight_summed.empty()) {
+        hadrons.weight_summed.push_back(0.);
+      }
+      const double weight =
+          static_cast<double>(pdg.spin_degeneracy()) / ptype.mass();
+      hadrons.pdgids.push_back(pdgid);
+      hadrons.weight_summed.push_back(hadrons.weight_summed.back() + weight);
+    }
+  }
+}
+
 void StringProcess::common_setup_pythia(Pythia8::Pythia *pythia_in,
                                         double strange_supp,
                                         double diquark_supp,
@@ -251,8 +326,7 @@ bool StringProcess::next_SDiff(bool is_AB_to_AX) {
   make_string_ends(is_AB_to_AX ? PDGcodes_[1] : PDGcodes_[0], idqX1, idqX2,
                    prob_proton_to_d_uu_);
   // string mass must be larger than threshold set by PYTHIA.
-  mstrMin = pythia_hadron_->particleData.m0(idqX1) +
-            pythia_hadron_->particleData.m0(idqX2);
+  mstrMin = constituent_mass(idqX1) + constituent_mass(idqX2);
   // this threshold cannot be larger than maximum of allowed string mass.
   if (mstrMin > mstrMax) {
     return false;
@@ -325,8 +399,8 @@ bool StringProcess::set_mass_and_direction_2strings(
 
     m_str[i] = pstr_com[i].sqr();
     m_str[i] = (m_str[i] > 0.) ? std::sqrt(m_str[i]) : 0.;
-    const double threshold = pythia_hadron_->particleData.m0(quarks[i][0]) +
-                             pythia_hadron_->particleData.m0(quarks[i][1]);
+    const double threshold =
+        constituent_mass(quarks[i][0]) + constituent_mass(quarks[i][1]);
     // string mass must be larger than threshold set by PYTHIA.
     if (m_str[i] > threshold) {
       found_mass[i] = true;
@@ -902,14 +976,12 @@ void StringProcess::find_total_number_constituent(
     if (pdgid > 0) {
       // quarks
       for (int iflav = 0; iflav < 5; iflav++) {
-        nquark_total[iflav] +=
-            pythia_hadron_->particleData.nQuarksInCode(pdgid, iflav + 1);
+        nquark_total[iflav] += n_quarks_in_code(pdgid, iflav + 1);
       }
     } else {
       // antiquarks
       for (int iflav = 0; iflav < 5; iflav++) {
-        nantiq_total[iflav] += pythia_hadron_->particleData.nQuarksInCode(
-            std::abs(pdgid), iflav + 1);
+        nantiq_total[iflav] += n_quarks_in_code(std::abs(pdgid), iflav + 1);
       }
     }
   }
@@ -1000,7 +1072,7 @@ bool StringProcess::splitting_gluon_qqbar(
         // four momenta of quark and antiquark
         std::array<Pythia8::Vec4, 2> pquark;
         // transverse momentum scale of string fragmentation
-        const double sigma_qt_frag = pythia_hadron_->parm("StringPT:sigma");
+        const double sigma_qt_frag = pythia_sigma_pt_;
         // sample relative transverse momentum between quark and antiquark
         const double qx = random::normal(0., sigma_qt_frag * M_SQRT1_2);
         const double qy = random::normal(0., sigma_qt_frag * M_SQRT1_2);
@@ -1598,9 +1670,8 @@ bool StringProcess::next_BBbarAnn() {
   // Make sure it satisfies kinematical threshold constraint
   bool kin_threshold_satisfied = true;
   for (int i = 0; i < 2; i++) {
-    const double mstr_min =
-        pythia_hadron_->particleData.m0(remaining_quarks[i]) +
-        pythia_hadron_->particleData.m0(remaining_antiquarks[i]);
+    const double mstr_min = constituent_mass(remaining_quarks[i]) +
+                            constituent_mass(remaining_antiquarks[i]);
     if (mstr_min > mstr[i]) {
       kin_threshold_satisfied = false;
     }
@@ -1782,9 +1853,9 @@ int StringProcess::fragment_string(int idq1, int idq2, double mString,
 
   for (int i = 0; i < 2; i++) {
     // evaluate total baryon number of the string times 3
-    bstring += pythia_hadron_->particleData.baryonNumberType(idqIn[i]);
+    bstring += baryon_number_type(idqIn[i]);
 
-    m_const[i] = pythia_hadron_->particleData.m0(idqIn[i]);
+    m_const[i] = constituent_mass(idqIn[i]);
   }
   logg[LPythia].debug("baryon number of string times 3 : ", bstring);
 
@@ -1865,6 +1936,11 @@ int StringProcess::fragment_string(int idq1, int idq2, double mString,
 
     std::array<double, 2> m_trans;
 
+    /* PDG id and four-momenta of the hadrons fragmented in one step,
+     * which are reused in all attempts. */
+    std::vector<int> pdgid_frag;
+    std::vector<FourVector> momentum_frag;
+
     // How many times we try to fragment leading baryon.
     const int niter_max = 10000;
     bool found_leading_baryon = false;
@@ -1873,8 +1949,6 @@ int StringProcess::fragment_string(int idq1, int idq2, double mString,
       pdgid_frag_prior.clear();
       momentum_frag_prior.clear();
       int n_frag = 0;
-      std::vector<int> pdgid_frag;
-      std::vector<FourVector> momentum_frag;
       // The original string is aligned in the logitudinal direction.
       ppos_string_new = mString * M_SQRT1_2;
       pneg_string_new = mString * M_SQRT1_2;
@@ -1928,7 +2002,7 @@ int StringProcess::fragment_string(int idq1, int idq2, double mString,
           idqIn[0] = bstring > 0 ? flav_string_neg.id : flav_string_pos.id;
           idqIn[1] = bstring > 0 ? flav_string_pos.id : flav_string_neg.id;
           for (int i = 0; i < 2; i++) {
-            m_const[i] = pythia_hadron_->particleData.m0(idqIn[i]);
+            m_const[i] = constituent_mass(idqIn[i]);
           }
           QTrn_string_pos = std::sqrt(QTrx_string_pos * QTrx_string_pos +
                                       QTry_string_pos * QTry_string_pos);
@@ -2268,18 +2342,15 @@ int StringProcess::fragment_off_hadron(
                       " ) with mass ", mass_string, " GeV.");
 
   // Take relevant parameters from PYTHIA.
-  const double sigma_qt_frag = pythia_hadron_->parm("StringPT:sigma");
-  const double stop_string_mass =
-      pythia_hadron_->parm("StringFragmentation:stopMass");
-  const double stop_string_smear =
-      pythia_hadron_->parm("StringFragmentation:stopSmear");
+  const double sigma_qt_frag = pythia_sigma_pt_;
+  const double stop_string_mass = pythia_stop_mass_;
+  const double stop_string_smear = pythia_stop_smear_;
 
   // Enhance the width of transverse momentum with certain probability
-  const double prob_enhance_qt =
-      pythia_hadron_->parm("StringPT:enhancedFraction");
+  const double prob_enhance_qt = pythia_enhanced_fraction_;
   double fac_enhance_qt;
   if (random::uniform(0., 1.) < prob_enhance_qt) {
-    fac_enhance_qt = pythia_hadron_->parm("StringPT:enhancedWidth");
+    fac_enhance_qt = pythia_enhanced_width_;
   } else {
     fac_enhance_qt = 1.;
   }
@@ -2360,9 +2431,9 @@ int StringProcess::fragment_off_hadron(
    * This formula is taken from StringFragmentation::energyUsedUp
    * in StringFragmentation.cc of PYTHIA 8. */
   const double mass_min_to_continue =
-      (stop_string_mass + pythia_hadron_->particleData.m0(flav_new.id) +
-       pythia_hadron_->particleData.m0(flav_string_pos.id) +
-       pythia_hadron_->particleData.m0(flav_string_neg.id)) *
+      (stop_string_mass + constituent_mass(flav_new.id) +
+       constituent_mass(flav_string_pos.id) +
+       constituent_mass(flav_string_neg.id)) *
       (1. + (2. * random::uniform(0., 1.) - 1.) * stop_string_smear);
   /* If the string mass is lower than that threshold,
    * the string breaks into the last two hadrons. */
@@ -2379,12 +2450,10 @@ int StringProcess::fragment_off_hadron(
 
   /* Whether the string end, at which the (first) hadron is fragmented,
    * had a diquark or antidiquark */
-  bool from_diquark_end =
-      from_forward ? pythia_hadron_->particleData.isDiquark(flav_string_pos.id)
-                   : pythia_hadron_->particleData.isDiquark(flav_string_neg.id);
+  bool from_diquark_end = from_forward ? is_diquark(flav_string_pos.id)
+                                       : is_diquark(flav_string_neg.id);
   // Whether the forward end of the string has a diquark
-  bool has_diquark_pos =
-      pythia_hadron_->particleData.isDiquark(flav_string_pos.id);
+  bool has_diquark_pos = is_diquark(flav_string_pos.id);
 
   int n_frag = 0;
   if (string_into_final_two) {
@@ -2400,12 +2469,12 @@ int StringProcess::fragment_off_hadron(
     flav_new2.anti(flav_new);
     /* Getting a hadron from diquark and antidiquark does not always work.
      * So, if this is the case, start over. */
-    if (pythia_hadron_->particleData.isDiquark(flav_string_neg.id) &&
-        pythia_hadron_->particleData.isDiquark(flav_new2.id) && from_forward) {
+    if (is_diquark(flav_string_neg.id) && is_diquark(flav_new2.id) &&
+        from_forward) {
       return 0;
     }
-    if (pythia_hadron_->particleData.isDiquark(flav_string_pos.id) &&
-        pythia_hadron_->particleData.isDiquark(flav_new2.id) && !from_forward) {
+    if (is_diquark(flav_string_pos.id) && is_diquark(flav_new2.id) &&
+        !from_forward) {
       return 0;
     }
     for (int i_try = 0; i_try < n_try; i_try++) {
@@ -2565,8 +2634,7 @@ int StringProcess::fragment_off_hadron(
 
 int StringProcess::get_hadrontype_from_quark(int idq1, int idq2) {
   const int baryon_number =
-      pythia_hadron_->particleData.baryonNumberType(idq1) +
-      pythia_hadron_->particleData.baryonNumberType(idq2);
+      baryon_number_type(idq1) + baryon_number_type(idq2);
 
   int pdgid_hadron = 0;
   /* PDG id of the leading baryon from valence quark constituent.
@@ -2589,10 +2657,8 @@ int StringProcess::get_hadrontype_from_quark(int idq1, int idq2) {
   /* Evaluate total net quark number of baryon (antibaryon)
    * from the valence quark constituents. */
   for (int iq = 0; iq < 5; iq++) {
-    int nq1 =
-        pythia_hadron_->particleData.nQuarksInCode(std::abs(idq1), iq + 1);
-    int nq2 =
-        pythia_hadron_->particleData.nQuarksInCode(std::abs(idq2), iq + 1);
+    int nq1 = n_quarks_in_code(std::abs(idq1), iq + 1);
+    int nq2 = n_quarks_in_code(std::abs(idq2), iq + 1);
     nq1 = idq1 > 0 ? nq1 : -nq1;
     nq2 = idq2 > 0 ? nq2 : -nq2;
     frag_net_q[iq] = nq1 + nq2;
@@ -2606,49 +2672,36 @@ int StringProcess::get_hadrontype_from_quark(int idq1, int idq2) {
                       ", charmness = ", frag_charm,
                       ", bottomness = ", frag_bottom);
 
-  std::vector<int> pdgid_possible;
-  std::vector<double> weight_possible;
-  std::vector<double> weight_summed;
-  /* loop over hadronic species
-   * Any hadron with the same valence quark contents is allowed and
+  /* Any hadron with the same valence quark contents is allowed and
    * the probability goes like spin degeneracy over mass. */
-  for (auto &ptype : ParticleType::list_all()) {
-    if (!ptype.is_hadron()) {
-      continue;
-    }
-    const int pdgid = ptype.pdgcode().get_decimal();
-    if ((pythia_hadron_->particleData.isParticle(pdgid)) &&
-        (baryon_number == 3 * ptype.pdgcode().baryon_number()) &&
-        (frag_iso3 == ptype.pdgcode().isospin3()) &&
-        (frag_strange == ptype.pdgcode().strangeness()) &&
-        (frag_charm == ptype.pdgcode().charmness()) &&
-        (frag_bottom == ptype.pdgcode().bottomness())) {
-      const int spin_degeneracy = ptype.pdgcode().spin_degeneracy();
-      const double mass_pole = ptype.mass();
-      const double weight = static_cast<double>(spin_degeneracy) / mass_pole;
-      pdgid_possible.push_back(pdgid);
-      weight_possible.push_back(weight);
-
-      logg[LPythia].debug("  PDG id ", pdgid, " is possible with weight ",
-                          weight);
+  const HadronCandidates *hadrons = nullptr;
+  if (baryon_number % 3 == 0) {
+    const auto found = hadrons_by_quantum_numbers_.find(
+        quantum_number_key(baryon_number / 3, frag_iso3, frag_strange,
+                           frag_charm, frag_bottom));
+    if (found != hadrons_by_quantum_numbers_.end()) {
+      hadrons = &found->second;
     }
   }
-  const int n_possible = pdgid_possible.size();
-  weight_summed.push_back(0.);
-  for (int i = 0; i < n_possible; i++) {
-    weight_summed.push_back(weight_summed[i] + weight_possible[i]);
-  }
 
   /* Sample baryon (antibaryon) specie,
    * which is fragmented from the leading diquark (anti-diquark). */
-  const double uspc = random::uniform(0., weight_summed[n_possible]);
-  for (int i = 0; i < n_possible; i++) {
-    if ((uspc >= weight_summed[i]) && (uspc < weight_summed[i + 1])) {
-      return pdgid_possible[i];
-    }
+  const double weight_total = hadrons ? hadrons->weight_summed.back() : 0.;
+  const double uspc = random::uniform(0., weight_total);
+  if (!hadrons) {
+    return 0;
   }
-
-  return 0;
+  // Find i with weight_summed[i] <= uspc < weight_summed[i + 1].
+  const auto upper = std::upper_bound(hadrons->weight_summed.begin(),
+                                      hadrons->weight_summed.end(), uspc);
+  if (upper == hadrons->weight_summed.begin() ||
+      upper == hadrons->weight_summed.end()) {
+    return 0;
+  }
+  const int pdgid = hadrons->pdgids[upper - hadrons->weight_summed.begin() - 1];
+  logg[LPythia].debug("  PDG id ", pdgid, " is chosen among ",
+                      hadrons->pdgids.size(), " possible hadrons");
+  return pdgid;
 }
 
 int StringProcess::get_resonance_from_quark(int idq1, int idq2, double mass) {
@@ -2662,12 +2715,10 @@ int StringProcess::get_resonance_from_quark(int idq1, int idq2, double mass) {
 
   // idq1 is supposed to be a quark or anti-diquark.
   bool end1_is_quark = idq1 > 0 && pythia_hadron_->particleData.isQuark(idq1);
-  bool end1_is_antidiq =
-      idq1 < 0 && pythia_hadron_->particleData.isDiquark(idq1);
+  bool end1_is_antidiq = idq1 < 0 && is_diquark(idq1);
   // idq2 is supposed to be a anti-quark or diquark.
   bool end2_is_antiq = idq2 < 0 && pythia_hadron_->particleData.isQuark(idq2);
-  bool end2_is_diquark =
-      idq2 > 0 && pythia_hadron_->particleData.isDiquark(idq2);
+  bool end2_is_diquark = idq2 > 0 && is_diquark(idq2);
 
   int baryon;
   if (end1_is_quark) {
@@ -2698,16 +2749,14 @@ int StringProcess::get_resonance_from_quark(int idq1, int idq2, double mass) {
   for (int iflav = 0; iflav < 5; iflav++) {
     net_qnumber[iflav] = 0;
 
-    int qnumber1 =
-        pythia_hadron_->particleData.nQuarksInCode(std::abs(idq1), iflav + 1);
+    int qnumber1 = n_quarks_in_code(std::abs(idq1), iflav + 1);
     if (idq1 < 0) {
       // anti-diquark gets an extra minus sign.
       qnumber1 = -qnumber1;
     }
     net_qnumber[iflav] += qnumber1;
 
-    int qnumber2 =
-        pythia_hadron_->particleData.nQuarksInCode(std::abs(idq2), iflav + 1);
+    int qnumber2 = n_quarks_in_code(std::abs(idq2), iflav + 1);
     if (idq2 < 0) {
       // anti-quark gets an extra minus sign.
       qnumber2 = -qnumber2;
@@ -2715,66 +2764,38 @@ int StringProcess::get_resonance_from_quark(int idq1, int idq2, double mass) {
     net_qnumber[iflav] += qnumber2;
   }
 
-  // List of PDG ids of resonances with the same quantum number.
-  std::vector<int> pdgid_possible;
-  // Corresponding mass differences.
-  std::vector<double> mass_diff;
-  for (auto &ptype : ParticleType::list_all()) {
-    if (!ptype.is_hadron() || ptype.is_stable() ||
-        ptype.pdgcode().baryon_number() != baryon) {
-      // Only resonances with the same baryon number are considered.
-      continue;
-    }
-    const int pdgid = ptype.pdgcode().get_decimal();
-    const double mass_min = ptype.min_mass_spectral();
-    if (mass < mass_min) {
-      // A resoance with mass lower than its minimum threshold is not allowed.
-      continue;
-    }
+  const auto found = resonances_by_quantum_numbers_.find(quantum_number_key(
+      baryon, net_qnumber[1] - net_qnumber[0], -net_qnumber[2], net_qnumber[3],
+      -net_qnumber[4]));
+  if (found == resonances_by_quantum_numbers_.end()) {
+    return 0;
+  }
 
-    if (ptype.pdgcode().isospin3() != net_qnumber[1] - net_qnumber[0]) {
-      // check isospin3.
+  /* Find a resonance whose pole mass is closest to the input mass.
+   * A resonance with mass lower than its minimum threshold is not allowed. */
+  const ResonanceCandidate *closest = nullptr;
+  double mass_diff_min = 0.;
+  for (const ResonanceCandidate &resonance : found->second) {
+    if (mass < resonance.mass_min) {
       continue;
     }
-    if (ptype.pdgcode().strangeness() != -net_qnumber[2]) {
-      // check strangeness.
-      continue;
+    const double mass_diff = mass - resonance.mass_pole;
+    if (!closest) {
+      closest = &resonance;
+      mass_diff_min = std::fabs(mass_diff);
+    } else if (std::fabs(mass_diff) < mass_diff_min) {
+      closest = &resonance;
+      mass_diff_min = mass_diff;
     }
-    if (ptype.pdgcode().charmness() != net_qnumber[3]) {
-      // check charmness.
-      continue;
-    }
-    if (ptype.pdgcode().bottomness() != -net_qnumber[4]) {
-      // check bottomness.
-      continue;
-    }
-
-    const double mass_pole = ptype.mass();
-    // Add the PDG id and mass difference to the vector array.
-    pdgid_possible.push_back(pdgid);
-    mass_diff.push_back(mass - mass_pole);
   }
-
-  const int n_res = pdgid_possible.size();
-  if (n_res == 0) {
+  if (!closest) {
     // If there is no possible resonance found, return 0 (failure).
     return 0;
   }
-
-  int ires_closest = 0;
-  double mass_diff_min = std::fabs(mass_diff[0]);
-  /* Find a resonance whose pole mass is closest to
-   * the input mass. */
-  for (int ires = 1; ires < n_res; ires++) {
-    if (std::fabs(mass_diff[ires]) < mass_diff_min) {
-      ires_closest = ires;
-      mass_diff_min = mass_diff[ires];
-    }
-  }
   logg[LPythia].debug("Quark constituents ", idq1, " and ", idq2, " with mass ",
                       mass, " (GeV) turned into a resonance ",
-                      pdgid_possible[ires_closest]);
-  return pdgid_possible[ires_closest];
+                      closest->pdgid);
+  return closest->pdgid;
 }
 
 bool StringProcess::make_lightcone_final_two(
@@ -2843,35 +2864,79 @@ bool StringProcess::make_lightcone_final_two(
 }
 
 double StringProcess::sample_zLund(double a, double b, double mTrn) {
-  // the lightcone momentum fraction x
-  double xfrac = 0.;
-  bool xfrac_accepted = false;
-  /* First sample the inverse 1/x of the lightcone momentum fraction.
-   * Then, obtain x itself.
-   * The probability distribution function for the inverse of x is
-   * PDF(u = 1/x) = (1/u) * (1 - 1/u)^a * exp(-b * mTrn^2 * u)
-   * with 1 < u < infinity.
-   * The rejection method can be used with an envelop function
-   * ENV(u) = exp(-b * mTrn^2 * u). */
-  while (!xfrac_accepted) {
-    const double fac_env = b * mTrn * mTrn;
-    const double u_aux = random::uniform(0., 1.);
-    /* Sample u = 1/x according to the envelop function
-     * ENV(u) = exp(-b * mTrn^2 * u). */
-    const double xfrac_inv = 1. - std::log(u_aux) / fac_env;
-    assert(xfrac_inv >= 1.);
-    /* Evaluate the ratio of the real probability distribution function to
-     * the envelop function. */
-    const double xf_ratio = std::pow(1. - 1. / xfrac_inv, a) / xfrac_inv;
-    // Determine whether the sampled value will be accepted.
-    if (random::uniform(0., 1.) <= xf_ratio) {
-      /* If the sampled value of 1/x is accepted,
-       * obtain the value of x. */
-      xfrac = 1. / xfrac_inv;
-      xfrac_accepted = true;
-    }
-  }
-  return xfrac;
+  /* The fragmentation function
+   * f(z) = (1/z) * (1 - z)^a * exp(-c / z) with c = b * mTrn^2
+   * is sampled in the same way as in StringZ::zLund of PYTHIA 8.
+   * It is bounded by f(z_max), and the rejection method is used with an
+   * envelope that is flat in the middle and adapted to the peak, if it lies
+   * close to 0 or 1, so that the acceptance stays high even for large a or
+   * small c. */
+  const double c = b * mTrn * mTrn;
+  assert(a >= 0. && c > 0.);
+  /* Position of the maximum, i.e. the root of
+   * (1 - a) z^2 - (1 + c) z + c = 0 in [0, 1], written such that it has
+   * no cancellation for any a. */
+  const double z_max =
+      2. * c / (1. + c + std::sqrt((1. - c) * (1. - c) + 4. * a * c));
+  const bool peaked_near_zero = z_max < 0.1;
+  const bool peaked_near_unity = z_max > 0.85 && c > 1.;
+
+  // integrals of the envelope below and above z_div, and the total
+  double z_div = 0.5;
+  double f_int_low = 1.;
+  double f_int = 2.;
+  if (peaked_near_zero) {
+    // f(z) / f(z_max) < 1 below z_div and < z_div / z above
+    z_div = 2.75 * z_max;
+    f_int_low = z_div;
+    f_int = z_div - z_div * std::log(z_div);
+  } else if (peaked_near_unity) {
+    /* f(z) / f(z_max) < exp(c * (z - z_div)) below z_div and < 1 above, where
+     * the envelope below z_div is extended to -infinity. */
+    const double rcb = std::sqrt(4. + 1. / (c * c));
+    z_div = rcb - 1. / z_max - std::log(z_max * 0.5 * (rcb + 1. / c)) / c;
+    if (a > 0.) {
+      z_div += a / c * std::log(1. - z_max);
+    }
+    z_div = std::min(z_max, std::max(0., z_div));
+    f_int_low = 1. / c;
+    f_int = f_int_low + 1. - z_div;
+  }
+
+  while (true) {
+    double z = random::canonical();
+    // value of the envelope at z
+    double f_env = 1.;
+    if (peaked_near_zero) {
+      if (f_int * random::canonical() < f_int_low) {
+        z = z_div * z;
+      } else {
+        z = std::pow(z_div, z);
+        f_env = z_div / z;
+      }
+    } else if (peaked_near_unity) {
+      if (f_int * random::canonical() < f_int_low) {
+        if (z <= 0.) {
+          continue;
+        }
+        z = z_div + std::log(z) / c;
+        f_env = std::exp(c * (z - z_div));
+      } else {
+        z = z_div + (1. - z_div) * z;
+      }
+    }
+    if (z <= 0. || z >= 1.) {
+      continue;
+    }
+    // f(z) / f(z_max)
+    double f_exponent = c * (1. / z_max - 1. / z) + std::log(z_max / z);
+    if (a > 0.) {
+      f_exponent += a * std::log((1. - z) / (1. - z_max));
+    }
+    if (random::canonical() * f_env <= std::exp(f_exponent)) {
+      return z;
+    }
+  }
 }
 
 bool StringProcess::remake_kinematics_fragments(
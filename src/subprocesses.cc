@@ -0,0 +1,132 @@
+/*
+ *
+ *    Copyright (c) 2020
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/subprocesses.h"
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+#include "smash/file.h"
+
+namespace smash {
+
+namespace {
+/**
+ * Evaluate the tasks of one worker and write the results to a file.
+ *
+ * Every result is stored as its size, followed by its characters.
+ *
+ * \param[in] file Output file.
+ * \param[in] first Number of the first task.
+ * \param[in] stride Distance between the numbers of consecutive tasks.
+ * \param[in] n_tasks Total number of tasks.
+ * \param[in] task Function evaluating a task.
+ * \return Whether all tasks were evaluated and written.
+ */
+bool write_worker_results(std::FILE *file, size_t first, size_t stride,
+                          size_t n_tasks,
+                          const std::function<std::string(size_t)> &task) {
+  for (size_t i = first; i < n_tasks; i += stride) {
+    const std::string result = task(i);
+    const uint64_t size = result.size();
+    if (std::fwrite(&size, sizeof(size), 1, file) != 1 ||
+        std::fwrite(result.data(), 1, size, file) != size) {
+      return false;
+    }
+  }
+  return std::fflush(file) == 0;
+}
+}  // unnamed namespace
+
+std::vector<std::string> run_in_subprocesses(
+    size_t n_tasks, int n_workers,
+    const std::function<std::string(size_t)> &task) {
+  std::vector<std::string> results(n_tasks);
+  const size_t n = std::min(static_cast<size_t>(std::max(n_workers, 1)),
+                            n_tasks);
+  if (n <= 1) {
+    for (size_t i = 0; i < n_tasks; i++) {
+      results[i] = task(i);
+    }
+    return results;
+  }
+
+  // Buffered output would otherwise be written by every worker.
+  std::cout.flush();
+  std::cerr.flush();
+  std::fflush(nullptr);
+
+  std::vector<FilePtr> files;
+  std::vector<pid_t> workers;
+  bool failed = false;
+  for (size_t k = 0; k < n; k++) {
+    FilePtr file(std::tmpfile());
+    if (!file) {
+      failed = true;
+      break;
+    }
+    const pid_t pid = fork();
+    if (pid < 0) {
+      failed = true;
+      break;
+    }
+    if (pid == 0) {
+      bool success = false;
+      try {
+        success = write_worker_results(file.get(), k, n, n_tasks, task);
+      } catch (const std::exception &e) {
+        std::cerr << "Worker " << k << " failed: " << e.what() << std::endl;
+      }
+      std::cout.flush();
+      std::fflush(nullptr);
+      // Leave without running any destructors or exit handlers of the parent.
+      _exit(success ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+    workers.push_back(pid);
+    files.emplace_back(std::move(file));
+  }
+
+  for (const pid_t pid : workers) {
+    int status;
+    if (waitpid(pid, &status, 0) != pid || !WIFEXITED(status) ||
+        WEXITSTATUS(status) != EXIT_SUCCESS) {
+      failed = true;
+    }
+  }
+  if (failed) {
+    throw std::runtime_error("A worker process failed.");
+  }
+
+  for (size_t k = 0; k < n; k++) {
+    std::FILE *file = files[k].get();
+    std::rewind(file);
+    for (size_t i = k; i < n_tasks; i += n) {
+      uint64_t size;
+      if (std::fread(&size, sizeof(size), 1, file) != 1) {
+        throw std::runtime_error("Could not read the results of a worker.");
+      }
+      results[i].resize(size);
+      if (size > 0 && std::fread(&results[i][0], 1, size, file) != size) {
+        throw std::runtime_error("Could not read the results of a worker.");
+      }
+    }
+  }
+  return results;
+}
+
+}  // namespace smash
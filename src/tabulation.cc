@@ -7,6 +7,8 @@
 
 #include "smash/tabulation.h"
 
+#include <algorithm>
+
 namespace smash {
 
 Tabulation::Tabulation(double x_min, double range, size_t num,
@@ -53,6 +55,21 @@ double Tabulation::get_value_linear(double x, Extrapolation extrapol) const {
   return values_[n] + (values_[n + 1] - values_[n]) * r;
 }
 
+Tabulation Tabulation::running_maximum() const {
+  Tabulation t;
+  t.x_min_ = x_min_;
+  t.x_max_ = x_max_;
+  t.inv_dx_ = inv_dx_;
+  t.values_.resize(values_.size());
+  double max = 0.;
+  for (size_t i = 0; i < values_.size(); i++) {
+    const size_t next = std::min(i + 1, values_.size() - 1);
+    max = std::max({max, values_[i], values_[next]});
+    t.values_[i] = max;
+  }
+  return t;
+}
+
 /**
  * Write binary representation to stream.
  *
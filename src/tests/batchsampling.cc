@@ -0,0 +1,89 @@
+/*
+ *
+ *    Copyright (c) 2020 -
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include <vir/test.h>  // This include has to be first
+
+#include <atomic>
+#include <vector>
+
+#include "setup.h"
+
+#include "../include/smash/batchsampling.h"
+#include "../include/smash/random.h"
+
+using namespace smash;
+
+TEST(init_particle_types) {
+  ParticleType::create_type_list(
+      "# NAME MASS[GEV] WIDTH[GEV] PARITY PDG\n"
+      "π0 0.1350 -1.0 - 111\n"
+      "π+ 0.1396 -1.0 - 211\n"
+      "N+ 0.938 -1.0 + 2212\n");
+}
+
+/**
+ * Sample a momentum for every particle in batches and return the momenta.
+ * Count the batches and check that each is not empty, does not exceed the
+ * maximal size and contains only one species.
+ */
+static std::vector<double> sample_momenta(Particles *particles, int n_threads,
+                                          int *n_batches,
+                                          random::Engine::result_type *next) {
+  random::set_seed(7);
+  std::atomic<int> batches(0);
+  std::atomic<bool> valid(true);
+  sample_in_batches(particles, n_threads, [&](const ParticleBatch &batch,
+                                               random::Engine &rng) {
+    ++batches;
+    if (batch.size() == 0 || batch.size() > max_particle_batch_size) {
+      valid = false;
+    }
+    for (std::size_t i = 0; i < batch.size(); i++) {
+      if (batch[i].type() != batch.type()) {
+        valid = false;
+      }
+      batch[i].set_4momentum(batch.type().mass(), random::canonical(rng), 0.,
+                             0.);
+    }
+  });
+  VERIFY(valid);
+  *n_batches = batches;
+  *next = random::advance();
+  std::vector<double> momenta;
+  for (const ParticleData &data : *particles) {
+    momenta.push_back(data.momentum().x1());
+  }
+  return momenta;
+}
+
+TEST(sample_independent_of_threads) {
+  Particles particles;
+  particles.create(10000, 0x111);
+  particles.create(3, 0x211);
+  particles.create(5000, 0x2212);
+
+  int n_batches_serial = 0, n_batches_parallel = 0;
+  random::Engine::result_type next_serial = 0, next_parallel = 0;
+  const auto serial =
+      sample_momenta(&particles, 1, &n_batches_serial, &next_serial);
+  const auto parallel =
+      sample_momenta(&particles, 4, &n_batches_parallel, &next_parallel);
+  // 10000 = 4096 + 4096 + 1808 pi0, 3 pi+ and 5000 = 4096 + 904 protons
+  COMPARE(n_batches_serial, 6);
+  COMPARE(n_batches_parallel, 6);
+  // the engine of the calling thread ends up in the same state
+  COMPARE(next_serial, next_parallel);
+  COMPARE(serial.size(), parallel.size());
+  for (std::size_t i = 0; i < serial.size(); i++) {
+    COMPARE(serial[i], parallel[i]) << i;
+  }
+
+  // different batches use different random number streams
+  VERIFY(serial[0] != serial[max_particle_batch_size]);
+}
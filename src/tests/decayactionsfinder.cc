@@ -0,0 +1,95 @@
+/*
+ *
+ *    Copyright (c) 2020
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include <vir/test.h>  // This include has to be first
+
+#include "setup.h"
+
+#include <cmath>
+#include <set>
+
+#include "../include/smash/constants.h"
+#include "../include/smash/decayactionsfinder.h"
+#include "../include/smash/decaymodes.h"
+
+using namespace smash;
+
+TEST(init_particle_types) {
+  ParticleType::create_type_list(
+      "# NAME MASS[GEV] WIDTH[GEV] PARITY PDG\n"
+      "Λ 3.000 0.3 + 50661\n"
+      "η1⁰ 0.400 -1.0 + 10661\n"
+      "η2⁰ 0.600 -1.0 + 20661\n");
+}
+
+TEST(init_decay_channels) {
+  const std::string decays_input(
+      "Λ\n \n"
+      " 1.0 \t0\tη1 η1\n \n"
+      " 1.0 \t0\tη2⁰ η1⁰\n");
+  DecayModes::load_decaymodes(decays_input);
+  ParticleType::check_consistency();
+}
+
+/*
+ * Let resonances at rest decay over several timesteps and compare the number
+ * of surviving resonances to the exponential decay law, with and without
+ * keeping the decay times in a schedule.
+ */
+TEST(decay_law) {
+  const ParticleType &type = ParticleType::find(0x50661);
+  constexpr int n_particles = 10000;
+  constexpr int n_steps = 20;
+  constexpr double dt = 0.1;
+  // width at the pole mass, in 1/fm
+  const double rate = type.width_at_pole() / hbarc;
+
+  DecaySchedule schedule;
+  for (DecaySchedule *decay_schedule : {&schedule, nullptr}) {
+    DecayActionsFinder finder(1., decay_schedule);
+    ParticleList alive;
+    for (int i = 0; i < n_particles; i++) {
+      ParticleData p{type};
+      p.set_id(i);
+      p.set_4momentum(type.mass(), 0., 0., 0.);
+      alive.push_back(p);
+    }
+    for (int step = 0; step < n_steps; step++) {
+      const double t = step * dt;
+      for (auto &p : alive) {
+        p.set_4position(FourVector(t, 0., 0., 0.));
+      }
+      std::set<int> decayed;
+      for (const auto &action :
+           finder.find_actions_in_cell(alive, dt, 0., {})) {
+        VERIFY(action->time_of_execution() >= t);
+        VERIFY(action->time_of_execution() < t + dt);
+        decayed.insert(action->incoming_particles()[0].id());
+      }
+      ParticleList survivors;
+      for (const auto &p : alive) {
+        if (decayed.count(p.id()) == 0) {
+          survivors.push_back(p);
+        }
+      }
+      alive.swap(survivors);
+
+      const double survival = std::exp(-rate * (t + dt));
+      const double sigma =
+          std::sqrt(n_particles * survival * (1. - survival)) + 1.;
+      COMPARE_ABSOLUTE_ERROR(static_cast<double>(alive.size()),
+                             n_particles * survival, 5 * sigma)
+          << "at t = " << t + dt;
+      if (decay_schedule) {
+        // every surviving resonance keeps its decay time
+        COMPARE(schedule.entries.size(), alive.size());
+      }
+    }
+  }
+}
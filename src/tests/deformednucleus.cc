@@ -11,6 +11,7 @@
 
 #include "setup.h"
 
+#include "../include/smash/angles.h"
 #include "../include/smash/constants.h"
 #include "../include/smash/deformednucleus.h"
 #include "../include/smash/fourvector.h"
@@ -18,7 +19,10 @@
 #include "../include/smash/particledata.h"
 #include "../include/smash/pdgcode.h"
 #include "../include/smash/pow.h"
+#include "../include/smash/random.h"
 
+#include <algorithm>
+#include <cmath>
 #include <map>
 #include <vector>
 
@@ -258,3 +262,78 @@ TEST(nucleon_density_norm) {
                            allowed_errors[index]);
   }
 }
+
+/*
+ * Rejection sampling of the deformed Woods-Saxon distribution from uniform
+ * points in a bounding sphere, as reference for distribute_nucleon.
+ */
+static ThreeVector sample_bounding_sphere(const DeformedNucleus &nucl) {
+  const double R = nucl.get_nuclear_radius();
+  const double d = nucl.get_diffusiveness();
+  const double radius_max = R / d + R * d;
+  double a_radius;
+  Angles a_direction;
+  do {
+    a_direction.distribute_isotropically();
+    a_radius = radius_max * std::cbrt(random::canonical());
+  } while (random::canonical() >
+           nucl.nucleon_density(a_radius, a_direction.costheta()) /
+               nucl.get_saturation_density());
+  return a_direction.threevec() * a_radius;
+}
+
+TEST(distribute_nucleon_distribution) {
+  random::set_seed(42);
+  const std::map<PdgCode, int> uranium = {{pdg::p, 92}, {pdg::n, 238 - 92}};
+  DeformedNucleus dnucleus(uranium, 1);
+  dnucleus.set_saturation_density(0.166);
+  dnucleus.set_nuclear_radius(6.86);
+  dnucleus.set_diffusiveness(0.556);
+  // strong deformation to make differences visible
+  dnucleus.set_beta_2(0.5);
+  dnucleus.set_beta_4(0.3);
+
+  constexpr int n_samples = 200000;
+  constexpr int n_r_bins = 20, n_cos_bins = 10;
+  constexpr double r_range = 12.;
+  std::vector<int> r_new(n_r_bins), r_ref(n_r_bins);
+  std::vector<int> cos_new(n_cos_bins), cos_ref(n_cos_bins);
+  auto fill = [&](const ThreeVector &pos, std::vector<int> &r_hist,
+                  std::vector<int> &cos_hist) {
+    const double r = pos.abs();
+    const int r_bin = static_cast<int>(r / r_range * n_r_bins);
+    if (r_bin < n_r_bins) {
+      r_hist[r_bin]++;
+    }
+    const int cos_bin =
+        std::min(static_cast<int>((pos.x3() / r + 1) / 2 * n_cos_bins),
+                 n_cos_bins - 1);
+    cos_hist[cos_bin]++;
+  };
+  for (int i = 0; i < n_samples; i++) {
+    fill(dnucleus.distribute_nucleon(), r_new, cos_new);
+    fill(sample_bounding_sphere(dnucleus), r_ref, cos_ref);
+  }
+
+  // Both histograms are statistically independent, so allow for 5 standard
+  // deviations of their difference.
+  auto compare = [](const std::vector<int> &a, const std::vector<int> &b) {
+    for (size_t i = 0; i < a.size(); i++) {
+      const double sigma = std::sqrt(a[i] + b[i] + 1.);
+      VERIFY(std::abs(a[i] - b[i]) < 5 * sigma) << " in bin " << i;
+    }
+  };
+  compare(r_new, r_ref);
+  compare(cos_new, cos_ref);
+
+  // the tables must be rebuilt after changing the nucleus parameters
+  dnucleus.set_beta_2(0.);
+  dnucleus.set_beta_4(0.);
+  std::fill(cos_new.begin(), cos_new.end(), 0);
+  std::fill(cos_ref.begin(), cos_ref.end(), 0);
+  for (int i = 0; i < n_samples; i++) {
+    fill(dnucleus.distribute_nucleon(), r_new, cos_new);
+    fill(sample_bounding_sphere(dnucleus), r_ref, cos_ref);
+  }
+  compare(cos_new, cos_ref);
+}
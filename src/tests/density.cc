@@ -12,6 +12,7 @@
 #include "setup.h"
 
 #include <map>
+#include <vector>
 
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/fstream.hpp>
@@ -326,6 +327,151 @@ TEST(current_curl_in_rotating_box) {
   COMPARE_ABSOLUTE_ERROR(rot_j_T_over_z, 0., 0.01);
 }
 
+// compare separable smearing on the lattice with the covariant one
+TEST(separable_smearing) {
+  /* Protons, antiprotons and pions with small velocities, for which the
+   * Lorentz contraction neglected by the separable smearing is small. */
+  Particles P;
+  for (int i = 0; i < 40; i++) {
+    ParticleData part = create_proton();
+    if (i >= 32) {
+      part = ParticleData{ParticleType::find(0x211)};
+    } else if (i >= 24) {
+      part = create_antiproton();
+    }
+    const double mass = part.type().mass();
+    part.set_4momentum(mass, mass * random::uniform(-0.1, 0.1),
+                       mass * random::uniform(-0.1, 0.1),
+                       mass * random::uniform(-0.1, 0.1));
+    part.set_4position(FourVector(0., random::uniform(-2., 2.),
+                                  random::uniform(-2., 2.),
+                                  random::uniform(-2., 2.)));
+    P.insert(part);
+  }
+  ExperimentParameters par = smash::Test::default_parameters();
+  const DensityParameters covariant_par(par);
+  par.smearing_mode = SmearingMode::Separable;
+  const DensityParameters separable_par(par);
+
+  const std::array<double, 3> l = {6., 6., 6.};
+  const std::array<int, 3> n = {20, 20, 20};
+  const std::array<double, 3> origin = {-3., -3., -3.};
+  for (const bool periodicity : {false, true}) {
+    for (const DensityType dtype : {DensityType::Baryon, DensityType::Hadron}) {
+      DensityLattice covariant(l, n, origin, periodicity,
+                               LatticeUpdate::EveryTimestep);
+      DensityLattice separable(l, n, origin, periodicity,
+                               LatticeUpdate::EveryTimestep);
+      update_lattice(&covariant, LatticeUpdate::EveryTimestep, dtype,
+                     covariant_par, P, true);
+      update_lattice(&separable, LatticeUpdate::EveryTimestep, dtype,
+                     separable_par, P, true);
+      double max_rho = 0., max_grad = 0., max_dj_dt = 0.;
+      for (auto &node : covariant) {
+        max_rho = std::max(max_rho, std::abs(node.density()));
+        for (int k = 0; k < 3; k++) {
+          max_grad = std::max(max_grad, std::abs(node.grad_rho()[k]));
+          max_dj_dt = std::max(max_dj_dt, std::abs(node.dj_dt()[k]));
+        }
+      }
+      VERIFY(max_rho > 0.1);
+      /* The deviations are due to the cloud-in-cell assignment and the
+       * neglected Lorentz contraction. */
+      for (std::size_t i = 0; i < covariant.size(); i++) {
+        COMPARE_ABSOLUTE_ERROR(separable[i].density(),
+                               covariant[i].density(), 0.02 * max_rho)
+            << i;
+        for (int k = 0; k < 3; k++) {
+          COMPARE_ABSOLUTE_ERROR(separable[i].grad_rho()[k],
+                                 covariant[i].grad_rho()[k], 0.02 * max_grad)
+              << i;
+          COMPARE_ABSOLUTE_ERROR(separable[i].dj_dt()[k],
+                                 covariant[i].dj_dt()[k], 0.05 * max_dj_dt)
+              << i;
+        }
+      }
+    }
+  }
+}
+
+// cells of 2.5 fm are too large for a smearing width of 1 fm
+TEST_CATCH(separable_smearing_too_coarse, std::invalid_argument) {
+  ExperimentParameters par = smash::Test::default_parameters();
+  par.smearing_mode = SmearingMode::Separable;
+  DensityLattice lat({10., 10., 10.}, {4, 4, 4}, {0., 0., 0.}, false,
+                     LatticeUpdate::EveryTimestep);
+  update_lattice(&lat, LatticeUpdate::EveryTimestep, DensityType::Baryon, par,
+                 Particles());
+}
+
+TEST(probe_thermodynamics) {
+  const ExperimentParameters exp_par = smash::Test::default_parameters();
+  const DensityParameters par(exp_par);
+  const std::vector<PdgCode> pdgs = {0x2212, -0x2212, 0x2112,
+                                     0x211,  -0x211,  0x111};
+  ParticleList P;
+  for (int i = 0; i < 300; i++) {
+    ParticleData part{ParticleType::find(pdgs[i % pdgs.size()]), i};
+    part.set_4momentum(part.type().mass(), random::uniform(-1., 1.),
+                       random::uniform(-1., 1.), random::uniform(-1., 1.));
+    part.set_4position(FourVector(0., random::uniform(-2., 2.),
+                                  random::uniform(-2., 2.),
+                                  random::uniform(-2., 2.)));
+    P.push_back(part);
+  }
+  const std::vector<ThreeVector> points = {
+      {0., 0., 0.}, {0.5, -0.3, 1.2}, {1.9, 1.9, -1.9}, {10., 0., 0.}};
+  const DensityType dtype = DensityType::Baryon;
+  for (const bool smearing : {true, false}) {
+    const auto probes =
+        probe_thermodynamics(points, P, par, dtype, smearing, true, true, true);
+    COMPARE(probes.size(), points.size());
+    for (std::size_t i = 0; i < points.size(); i++) {
+      const ThreeVector &r = points[i];
+      // separate evaluations of all quantities
+      const double rho =
+          std::get<0>(current_eckart(r, P, par, dtype, false, smearing));
+      const FourVector jQ = std::get<1>(
+          current_eckart(r, P, par, DensityType::Charge, false, smearing));
+      const FourVector jB = std::get<1>(
+          current_eckart(r, P, par, DensityType::Baryon, false, smearing));
+      EnergyMomentumTensor Tmn;
+      for (const auto &p : P) {
+        const double factor = density_factor(p.type(), dtype);
+        if (std::abs(factor) < really_small) {
+          continue;
+        }
+        const double sf = unnormalized_smearing_factor(
+                              p.position().threevec() - r, p.momentum(),
+                              1.0 / p.momentum().abs(), par)
+                              .first;
+        if (!smearing) {
+          Tmn.add_particle(p, factor);
+        } else if (sf >= really_small) {
+          Tmn.add_particle(p, factor * sf * par.norm_factor_sf());
+        }
+      }
+
+      COMPARE_ABSOLUTE_ERROR(probes[i].rho_eckart, rho, 1e-12);
+      for (int mu = 0; mu < 4; mu++) {
+        COMPARE_ABSOLUTE_ERROR(probes[i].jQ[mu], jQ[mu], 1e-12);
+        COMPARE_ABSOLUTE_ERROR(probes[i].jB[mu], jB[mu], 1e-12);
+        COMPARE(probes[i].jS[mu], 0.);
+      }
+      for (int k = 0; k < 10; k++) {
+        COMPARE_ABSOLUTE_ERROR(probes[i].Tmn[k], Tmn[k], 1e-12);
+      }
+    }
+  }
+  // quantities which are not requested are zero
+  const auto probes =
+      probe_thermodynamics(points, P, par, dtype, true, true, false, false);
+  for (int k = 0; k < 10; k++) {
+    COMPARE(probes[0].Tmn[k], 0.);
+  }
+  COMPARE(probes[0].jQ, FourVector());
+}
+
 /*
    This test does not compare anything. It only prints density map versus
    time to vtk files, so that one can open it with paraview and make sure
@@ -10,8 +10,18 @@
 #include <vir/test.h>  // This include has to be first
 
 #include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
+#include "../include/smash/boxmodus.h"
 #include "../include/smash/collidermodus.h"
+#include "../include/smash/density.h"
+#include "../include/smash/listmodus.h"
 #include "setup.h"
 
 using namespace smash;
@@ -87,3 +97,279 @@ TEST(access_particles) {
   ParticleList part_list = part->copy_to_vector();
   VERIFY(part_list.size() == 1);
 }
+
+/**
+ * Creates the configuration of an afterburner with the list modus. The list
+ * files are only given if \p file_directory is not empty.
+ */
+static Configuration list_configuration(const std::string &file_directory) {
+  std::string yaml =
+      "General:\n"
+      "  Modus: List\n"
+      "  End_Time: 10.0\n"
+      "  Nevents: 1\n"
+      "  Randomseed: 1\n"
+      "Collision_Term:\n"
+      "  Strings: False\n"
+      "Modi: \n"
+      "  List:\n";
+  if (file_directory.empty()) {
+    yaml += "    Shift_Id: 0\n";
+  } else {
+    yaml += "    File_Directory: \"" + file_directory +
+            "\"\n"
+            "    File_Prefix: \"event\"\n"
+            "    Shift_Id: 0\n";
+  }
+  return Configuration(yaml.c_str());
+}
+
+TEST(run_event_from_memory) {
+  const bf::path testoutputpath = bf::absolute(SMASH_TEST_OUTPUT_PATH);
+  bf::create_directories(testoutputpath);
+
+  // pions and protons close to each other, so that they interact
+  ParticleList initial;
+  for (int i = 0; i < 8; i++) {
+    ParticleData data{ParticleType::find(i % 2 == 0 ? 0x211 : 0x2212)};
+    const double sign = i % 2 == 0 ? 1. : -1.;
+    data.set_4position(FourVector(0., 0.1 * i, -0.05 * i, 0.2 * sign));
+    data.set_4momentum(data.pole_mass(), 0.1 * i, 0.02 * i, -0.8 * sign);
+    initial.push_back(data);
+  }
+
+  // write the particles in the format of the list modus
+  {
+    bf::ofstream file(testoutputpath / "event0");
+    file << std::setprecision(17);
+    file << "#!OSCAR2013 particle_lists t x y z mass p0 px py pz pdg ID "
+            "charge\n";
+    for (const ParticleData &data : initial) {
+      const FourVector r = data.position();
+      const FourVector p = data.momentum();
+      file << r.x0() << " " << r.x1() << " " << r.x2() << " " << r.x3() << " "
+           << data.effective_mass() << " " << p.x0() << " " << p.x1() << " "
+           << p.x2() << " " << p.x3() << " " << data.pdgcode().string() << " "
+           << data.id() << " " << data.pdgcode().charge() << "\n";
+    }
+    file << "# event 0 end\n";
+  }
+
+  Experiment<ListModus> from_file(list_configuration(testoutputpath.native()),
+                                  testoutputpath);
+  from_file.run_event(0);
+
+  Experiment<ListModus> from_memory(list_configuration(""), testoutputpath);
+  from_memory.modus()->set_next_event(initial);
+  from_memory.run_event(0);
+
+  const ParticleList expected = from_file.particles()->copy_to_vector();
+  const ParticleList actual = from_memory.particles()->copy_to_vector();
+  COMPARE(actual.size(), expected.size());
+  for (std::size_t i = 0; i < actual.size(); i++) {
+    COMPARE(actual[i].pdgcode(), expected[i].pdgcode()) << i;
+    COMPARE(actual[i].momentum(), expected[i].momentum()) << i;
+    COMPARE(actual[i].position(), expected[i].position()) << i;
+  }
+}
+
+/**
+ * Creates the configuration of a small box of pions that scatter elastically,
+ * with the collision output and the densities at the interactions. The walls
+ * are crossed inline if \p inline_wall_crossing is set.
+ */
+static Configuration box_configuration(bool inline_wall_crossing) {
+  std::string yaml =
+      "General:\n"
+      "  Modus: Box\n"
+      "  Delta_Time: 0.5\n"
+      "  End_Time: 10.0\n"
+      "  Nevents: 1\n"
+      "  Randomseed: 1\n"
+      "Collision_Term:\n"
+      "  Strings: False\n"
+      "  Two_to_One: False\n"
+      "  Included_2to2: [\"Elastic\"]\n"
+      "  Elastic_Cross_Section: 30.0\n"
+      "Output:\n"
+      "  Density_Type: \"hadron\"\n"
+      "  Collisions:\n"
+      "    Format: [\"Oscar2013\"]\n"
+      "Modi: \n"
+      "  Box:\n"
+      "    Initial_Condition: \"peaked momenta\"\n"
+      "    Length: 6.0\n"
+      "    Temperature: 0.2\n"
+      "    Start_Time: 0.0\n"
+      "    Init_Multiplicities:\n"
+      "      211: 40\n"
+      "      -211: 40\n";
+  yaml += std::string("    Inline_Wall_Crossing: ") +
+          (inline_wall_crossing ? "True" : "False") + "\n";
+  return Configuration(yaml.c_str());
+}
+
+TEST(inline_wall_crossing_keeps_collision_history) {
+  const bf::path testoutputpath = bf::absolute(SMASH_TEST_OUTPUT_PATH);
+  const bf::path actions_path = testoutputpath / "wall_crossing_actions";
+  const bf::path inline_path = testoutputpath / "inline_wall_crossing";
+  bf::create_directories(actions_path);
+  bf::create_directories(inline_path);
+  {
+    Experiment<BoxModus> with_actions(box_configuration(false), actions_path);
+    with_actions.run_event(0);
+    Experiment<BoxModus> with_inline(box_configuration(true), inline_path);
+    with_inline.run_event(0);
+  }
+
+  /* The collision histories have to agree in the processes, their times and
+   * the particles, up to the rounding in the output. */
+  bf::ifstream expected_file(actions_path / "full_event_history.oscar");
+  bf::ifstream actual_file(inline_path / "full_event_history.oscar");
+  VERIFY(expected_file.good());
+  VERIFY(actual_file.good());
+  std::string expected_line, actual_line;
+  int line = 0;
+  int n_collisions = 0;
+  int n_wall_crossings = 0;
+  while (std::getline(expected_file, expected_line)) {
+    line++;
+    VERIFY(std::getline(actual_file, actual_line)) << line;
+    std::istringstream expected_tokens(expected_line);
+    std::istringstream actual_tokens(actual_line);
+    std::string expected, actual;
+    while (expected_tokens >> expected) {
+      VERIFY(actual_tokens >> actual) << line;
+      std::size_t n_expected = 0, n_actual = 0;
+      try {
+        const double expected_value = std::stod(expected, &n_expected);
+        const double actual_value = std::stod(actual, &n_actual);
+        if (n_expected == expected.size() && n_actual == actual.size()) {
+          COMPARE_ABSOLUTE_ERROR(actual_value, expected_value, 1e-4) << line;
+          continue;
+        }
+      } catch (std::invalid_argument &) {
+      }
+      COMPARE(actual, expected) << line;
+    }
+    VERIFY(!(actual_tokens >> actual)) << line;
+    if (expected_line.compare(0, 24, "# interaction in 2 out 2") == 0) {
+      n_collisions++;
+    } else if (expected_line.compare(0, 24, "# interaction in 1 out 1") == 0) {
+      n_wall_crossings++;
+    }
+  }
+  VERIFY(!std::getline(actual_file, actual_line));
+  // the box has to contain both collisions and wall crossings
+  VERIFY(n_collisions > 0);
+  VERIFY(n_wall_crossings > 0);
+}
+
+/**
+ * Creates the configuration of a small box of resonances that only decay,
+ * with the collision output and the densities at the interactions. The
+ * resonances left at the end are decayed if \p force_decays is set.
+ */
+static Configuration decaying_box_configuration(bool force_decays) {
+  const std::string yaml =
+      "General:\n"
+      "  Modus: Box\n"
+      "  Delta_Time: 0.1\n"
+      "  End_Time: 1.0\n"
+      "  Nevents: 1\n"
+      "  Randomseed: 1\n"
+      "Collision_Term:\n"
+      "  Strings: False\n"
+      "  No_Collisions: True\n"
+      "  Force_Decays_At_End: " +
+      std::string(force_decays ? "True" : "False") +
+      "\n"
+      "Output:\n"
+      "  Density_Type: \"hadron\"\n"
+      "  Collisions:\n"
+      "    Format: [\"Oscar2013\"]\n"
+      "Modi: \n"
+      "  Box:\n"
+      "    Initial_Condition: \"peaked momenta\"\n"
+      "    Length: 4.0\n"
+      "    Temperature: 0.2\n"
+      "    Start_Time: 0.0\n"
+      "    Init_Multiplicities:\n"
+      "      113: 30\n"
+      "      223: 10\n"
+      "      2224: 30\n";
+  return Configuration(yaml.c_str());
+}
+
+TEST(final_decay_densities) {
+  const bf::path testoutputpath = bf::absolute(SMASH_TEST_OUTPUT_PATH);
+  const bf::path decays_path = testoutputpath / "final_decays";
+  bf::create_directories(decays_path);
+
+  // the particles before the final decays
+  ParticleList before_decays;
+  {
+    Experiment<BoxModus> without_decays(decaying_box_configuration(false),
+                                        decays_path);
+    without_decays.run_event(0);
+    before_decays = without_decays.particles()->copy_to_vector();
+  }
+  {
+    Experiment<BoxModus> with_decays(decaying_box_configuration(true),
+                                     decays_path);
+    with_decays.run_event(0);
+  }
+
+  /* The densities at all final decays, including the ones of the decay
+   * products, are the ones of the particles before the final decays. */
+  const DensityParameters par(Test::default_parameters());
+  bf::ifstream file(decays_path / "full_event_history.oscar");
+  VERIFY(file.good());
+  bool final_decays = false;
+  int n_final_decays = 0;
+  std::string line;
+  while (std::getline(file, line)) {
+    std::istringstream tokens(line);
+    std::string hash, interaction, label;
+    std::size_t n_in, n_out;
+    double rho, weight, partial;
+    int type;
+    if (!(tokens >> hash >> interaction) || interaction != "interaction") {
+      continue;
+    }
+    VERIFY(tokens >> label >> n_in >> label >> n_out >> label >> rho >>
+           label >> weight >> label >> partial >> label >> type);
+    std::vector<std::string> particles(n_in + n_out);
+    for (std::string &particle : particles) {
+      VERIFY(std::getline(file, particle));
+    }
+    if (type != static_cast<int>(ProcessType::Decay)) {
+      continue;
+    }
+    // t x y z mass p0 px py pz pdg ID charge
+    std::istringstream decaying(particles.front());
+    double t, x, y, z, mass, p0, px, py, pz;
+    std::string pdg;
+    int id;
+    VERIFY(decaying >> t >> x >> y >> z >> mass >> p0 >> px >> py >> pz >>
+           pdg >> id);
+    /* The final decays are written last and start with the first decay of a
+     * particle that was left at the end. */
+    final_decays = final_decays ||
+                   std::any_of(before_decays.begin(), before_decays.end(),
+                               [id](const ParticleData &data) {
+                                 return data.id() == id;
+                               });
+    if (!final_decays) {
+      continue;
+    }
+    const double expected =
+        probe_thermodynamics({ThreeVector(x, y, z)}, before_decays, par,
+                             DensityType::Hadron, true, true, false, false)
+            .front()
+            .rho_eckart;
+    COMPARE_ABSOLUTE_ERROR(rho, expected, 1e-5) << line;
+    n_final_decays++;
+  }
+  VERIFY(n_final_decays > 0);
+}
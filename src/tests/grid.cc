@@ -13,7 +13,9 @@
 
 #include "../include/smash/grid.h"
 #include "../include/smash/logging.h"
+#include "../include/smash/random.h"
 
+#include <algorithm>
 #include <set>
 #include <unordered_set>
 
@@ -463,3 +465,67 @@ TEST(max_positions_normal_grid) {
   // still generates an out-of-bounds cell index.
   Grid<GridOptions::Normal> grid2(list, testparticles, 1.0);
 }
+
+TEST(update_grid) {
+  using Test::Position;
+  constexpr double min_cell_length = 1.;
+  constexpr double skin = 1.;
+  constexpr int n_particles = 1000;
+  Particles list;
+  for (int i = 0; i < n_particles; ++i) {
+    list.insert(Test::smashon(Position{0, random::uniform(0., 10.),
+                                       random::uniform(0., 10.),
+                                       random::uniform(0., 10.)}));
+  }
+  Grid<GridOptions::Normal> grid(list, min_cell_length, timestep,
+                                 CellSizeStrategy::Optimal, skin);
+
+  // Move the particles by less than the skin.
+  for (auto &p : list) {
+    p.set_4position(p.position() + Position{0, random::uniform(-0.5, 0.5),
+                                            random::uniform(-0.5, 0.5),
+                                            random::uniform(-0.5, 0.5)});
+  }
+  VERIFY(grid.update(list, min_cell_length, timestep));
+
+  // Every particle is in exactly one cell, with its current position, and all
+  // pairs closer than the minimal cell length are found.
+  std::set<int> ids;
+  std::set<std::pair<int, int>> pairs;
+  auto add_pairs = [&](const ParticleList &a, const ParticleList &b) {
+    for (const auto &p1 : a) {
+      for (const auto &p2 : b) {
+        if (p1.id() != p2.id()) {
+          pairs.emplace(std::min(p1.id(), p2.id()), std::max(p1.id(), p2.id()));
+        }
+      }
+    }
+  };
+  grid.iterate_cells(
+      [&](const ParticleList &search) {
+        for (const auto &p : search) {
+          VERIFY(ids.insert(p.id()).second);
+          COMPARE(p.position(), list.lookup(p).position());
+        }
+        add_pairs(search, search);
+      },
+      add_pairs);
+  COMPARE(ids.size(), std::size_t(n_particles));
+  for (const auto &p1 : list) {
+    for (const auto &p2 : list) {
+      if (p1.id() < p2.id() &&
+          (p1.position().threevec() - p2.position().threevec()).abs() <
+              min_cell_length) {
+        VERIFY(pairs.count({p1.id(), p2.id()})) << p1 << '\n' << p2;
+      }
+    }
+  }
+
+  // A larger minimal cell length requires a new grid.
+  VERIFY(!grid.update(list, 2 * min_cell_length, timestep));
+
+  // A particle which left the grid requires a new grid.
+  ParticleData &p = *list.begin();
+  p.set_4position(Position{0, -2 * skin, 0, 0});
+  VERIFY(!grid.update(list, min_cell_length, timestep));
+}
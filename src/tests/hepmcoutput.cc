@@ -0,0 +1,130 @@
+/*
+ *
+ *    Copyright (c) 2020 -
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include <vir/test.h>  // This include has to be first
+
+#include "setup.h"
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "../include/smash/hepmcoutput.h"
+#include "../include/smash/particles.h"
+
+using namespace smash;
+
+static const bf::path testoutputpath = bf::absolute(SMASH_TEST_OUTPUT_PATH);
+
+TEST(directory_is_created) {
+  bf::create_directories(testoutputpath);
+  VERIFY(bf::exists(testoutputpath));
+}
+
+TEST(init_particle_types) { Test::create_actual_particletypes(); }
+
+/// Initial and final particles of one event
+struct TestEvent {
+  /// Initial particles
+  ParticleList initial;
+  /// Final particles
+  ParticleList final;
+};
+
+/**
+ * Create the particles of an event with \p n_initial initial and \p n_final
+ * final particles. The first \p n_protons initial particles are protons, the
+ * others neutrons, and the final particles are pions.
+ */
+static TestEvent create_event(int n_initial, int n_protons, int n_final) {
+  TestEvent event;
+  for (int i = 0; i < n_initial; i++) {
+    ParticleData p{ParticleType::find(i < n_protons ? 0x2212 : 0x2112)};
+    p.set_4momentum(p.pole_mass(), 0.1 * i, -0.2, 1.5 * (i % 2 ? 1 : -1));
+    event.initial.push_back(p);
+  }
+  for (int i = 0; i < n_final; i++) {
+    ParticleData p{ParticleType::find(i % 2 ? 0x211 : -0x211)};
+    p.set_4momentum(p.pole_mass(), 0.3, 0.01 * i, -0.4 + 0.1 * i);
+    event.final.push_back(p);
+  }
+  return event;
+}
+
+/**
+ * Write the events with the HepMC output and return the contents of the
+ * output file.
+ */
+static std::string write_events(const std::vector<TestEvent> &events,
+                                int total_N, int proj_N, bool direct) {
+  OutputParameters out_par;
+  out_par.hepmc_direct = direct;
+  const std::string name = direct ? "direct" : "record";
+  {
+    HepMcOutput output(testoutputpath, name, out_par, total_N, proj_N);
+    const EventInfo info = Test::default_event_info(1.7);
+    for (std::size_t i = 0; i < events.size(); i++) {
+      Particles initial, final;
+      for (const ParticleData &p : events[i].initial) {
+        initial.insert(p);
+      }
+      for (const ParticleData &p : events[i].final) {
+        final.insert(p);
+      }
+      output.at_eventstart(initial, i, info);
+      output.at_eventend(final, i, info);
+    }
+  }
+  const bf::path file = testoutputpath / (name + ".asciiv3");
+  VERIFY(bf::exists(file));
+  bf::ifstream stream(file, std::ios::binary);
+  const std::string contents{std::istreambuf_iterator<char>(stream),
+                             std::istreambuf_iterator<char>()};
+  stream.close();
+  bf::remove(file);
+  return contents;
+}
+
+/// Both writers have to produce identical files.
+static void compare_writers(const std::vector<TestEvent> &events,
+                            int total_N, int proj_N) {
+  const std::string record = write_events(events, total_N, proj_N, false);
+  const std::string direct = write_events(events, total_N, proj_N, true);
+  VERIFY(!record.empty());
+  COMPARE(direct, record);
+}
+
+TEST(direct_writer_collider) {
+  std::vector<TestEvent> events;
+  events.push_back(create_event(5, 2, 7));
+  events.push_back(create_event(5, 3, 2));
+  // projectile with the first 3 and target with the last 2 nucleons
+  compare_writers(events, 5, 3);
+}
+
+TEST(direct_writer_several_initial) {
+  std::vector<TestEvent> events;
+  events.push_back(create_event(4, 1, 3));
+  events.push_back(create_event(2, 2, 5));
+  compare_writers(events, 0, 0);
+}
+
+TEST(direct_writer_one_initial) {
+  std::vector<TestEvent> events;
+  events.push_back(create_event(1, 1, 4));
+  compare_writers(events, 0, 0);
+}
+
+TEST(direct_writer_no_initial) {
+  std::vector<TestEvent> events;
+  events.push_back(create_event(0, 0, 3));
+  compare_writers(events, 0, 0);
+}
@@ -59,7 +59,7 @@ TEST(hypersurface_crossing_action) {
 
   // Action list should only contain one element since one particle a crosses
   // the hypersurface in the given time step
-  // Implicit test of HyperSurfaceCrossActionsFinder::crosses_hypersurface
+  // Implicit test of HyperSurfaceCrossActionsFinder::crossing_time
   COMPARE(actions.size(), 1u);
 
   for (auto &action : actions) {
@@ -87,3 +87,43 @@ TEST(hypersurface_crossing_action) {
     COMPARE(action->outgoing_particles().size(), 0u);
   }
 }
+
+TEST(hypersurface_crossing_schedule) {
+  // Supposed to cross the hypersurface after a few time steps
+  ParticleData a{ParticleType::find(0x2212)};
+  a.set_4position(Position{0.5, 0.1, 0., 0.45});
+  a.set_4momentum(Momentum{0.943, 0., 0., 0.1});
+  a.set_id(0);
+
+  constexpr double proper_time = 0.5;
+  constexpr double time_step = 0.1;
+  HyperSurfaceCrossingSchedule schedule;
+  HyperSurfaceCrossActionsFinder finder(proper_time, &schedule);
+  HyperSurfaceCrossActionsFinder finder_without_schedule(proper_time);
+  const std::vector<FourVector> beam_mom = {};
+
+  int n_crossings = 0;
+  for (int step = 0; step < 10; step++) {
+    ActionList actions =
+        finder.find_actions_in_cell({a}, time_step, 0., beam_mom);
+    ActionList reference = finder_without_schedule.find_actions_in_cell(
+        {a}, time_step, 0., beam_mom);
+    COMPARE(actions.size(), reference.size());
+    if (actions.empty()) {
+      // the crossing time is kept for the next time step
+      COMPARE(schedule.entries.size(), 1u);
+    } else {
+      n_crossings++;
+      COMPARE_RELATIVE_ERROR(actions[0]->time_of_execution(),
+                             reference[0]->time_of_execution(), 1e-12);
+      const FourVector x =
+          actions[0]->outgoing_particles()[0].position();
+      COMPARE_ABSOLUTE_ERROR(x.tau(), proper_time, 1e-7);
+    }
+    // propagate to the end of the time step
+    FourVector position =
+        a.position() + FourVector(time_step, a.velocity() * time_step);
+    a.set_4position(position);
+  }
+  COMPARE(n_crossings, 1);
+}
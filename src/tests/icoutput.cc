@@ -121,3 +121,158 @@ TEST(particlelist_format) {
     VERIFY(bf::remove(outputfilepath));
   }
 }
+
+/**
+ * Create a particle that is not a spectator at the given position and the
+ * action of its hypersurface crossing.
+ */
+static ActionPtr create_crossing(Particles *particles, ParticleData *p,
+                                 const FourVector &position) {
+  *p = particles->insert(Test::smashon_random());
+  // see particlelist_format for why the history is modified
+  ParticleList mother_list = {ParticleData{p->type()}};
+  p->set_history(1, 1, ProcessType::None, 0.01, mother_list);
+  p->set_4position(position);
+  ActionPtr action = make_unique<HypersurfacecrossingAction>(*p, *p, 0.0);
+  action->generate_final_state();
+  action->perform(particles, 1);
+  return action;
+}
+
+/// Read a value of type T from a binary file.
+template <typename T>
+static T read_value(const FilePtr &file) {
+  T value;
+  VERIFY(std::fread(&value, sizeof(T), 1, file.get()) == 1);
+  return value;
+}
+
+/// Read a string preceded by its length from a binary file.
+static std::string read_string(const FilePtr &file) {
+  const auto size = read_value<std::uint32_t>(file);
+  std::vector<char> buf(size);
+  if (size > 0) {
+    COMPARE(std::fread(&buf[0], 1, size, file.get()), size);
+  }
+  return std::string(buf.begin(), buf.end());
+}
+
+TEST(compact_binary_format) {
+  Particles particles;
+  ParticleData p1{ParticleType::list_all()[0]};
+  ActionPtr action = create_crossing(&particles, &p1,
+                                     FourVector(2.3, 1.35722, 1.42223, 1.5));
+  const ICParticle expected(p1);
+
+  const int event_id = 3;
+  EventInfo event = Test::default_event_info(0.0, false);
+
+  const bf::path outputfilepath = testoutputpath / "SMASH_IC_compact.bin";
+  {
+    auto IC_output = make_unique<ICOutput>(testoutputpath, "Initial_Conditions",
+                                           OutputParameters(),
+                                           ICFormat::CompactBinary);
+    IC_output->at_eventstart(particles, event_id, event);
+    IC_output->at_interaction(*action, 0.);
+    IC_output->at_interaction(*action, 0.);
+    IC_output->at_eventend(particles, event_id, event);
+  }
+  VERIFY(bf::exists(outputfilepath));
+
+  {
+    FilePtr file = fopen(outputfilepath, "rb");
+    VERIFY(file.get());
+    std::vector<char> magic(4);
+    COMPARE(std::fread(&magic[0], 1, 4, file.get()), 4u);
+    COMPARE(std::string(magic.begin(), magic.end()), "SMIC");
+    COMPARE(read_value<std::uint16_t>(file), 1u);
+    COMPARE(read_string(file), VERSION_MAJOR);
+
+    // field descriptions
+    const std::vector<std::string> names = {
+        "tau", "x", "y", "eta", "mt", "px", "py", "Rap", "pdg", "charge"};
+    COMPARE(read_value<std::uint16_t>(file), names.size());
+    for (std::size_t i = 0; i < names.size(); i++) {
+      COMPARE(read_value<char>(file), i < 8 ? 'd' : 'i');
+      COMPARE(read_string(file), names[i]);
+      read_string(file);  // unit
+    }
+
+    // one block with both crossings
+    COMPARE(read_value<char>(file), 'p');
+    COMPARE(read_value<std::uint32_t>(file), 2u);
+    for (int i = 0; i < 2; i++) {
+      COMPARE(read_value<double>(file), expected.tau);
+      COMPARE(read_value<double>(file), expected.x);
+      COMPARE(read_value<double>(file), expected.y);
+      COMPARE(read_value<double>(file), expected.eta);
+      COMPARE(read_value<double>(file), expected.mt);
+      COMPARE(read_value<double>(file), expected.px);
+      COMPARE(read_value<double>(file), expected.py);
+      COMPARE(read_value<double>(file), expected.rapidity);
+      COMPARE(read_value<std::int32_t>(file), p1.pdgcode().get_decimal());
+      COMPARE(read_value<std::int32_t>(file), p1.type().charge());
+    }
+    COMPARE(read_value<char>(file), 'f');
+    COMPARE(read_value<std::int32_t>(file), event_id);
+    char c;
+    COMPARE(std::fread(&c, 1, 1, file.get()), 0u);
+  }
+  VERIFY(bf::remove(outputfilepath));
+}
+
+/// Consumer that records everything it receives.
+class RecordingConsumer : public ICConsumer {
+ public:
+  void at_eventstart(int event_number) override {
+    events.push_back(event_number);
+  }
+  void at_crossing(const ICParticle &particle) override {
+    crossings.push_back(particle);
+  }
+  void at_eventend(int event_number) override {
+    events.push_back(-event_number);
+  }
+  /// Event numbers at event start, and negative ones at event end
+  std::vector<int> events;
+  /// Particles on the hypersurface
+  std::vector<ICParticle> crossings;
+};
+
+TEST(consumer) {
+  Particles particles;
+  ParticleData p1{ParticleType::list_all()[0]};
+  ActionPtr action = create_crossing(&particles, &p1,
+                                     FourVector(2.3, 1.35722, 1.42223, 1.5));
+
+  // a spectator, which is not passed to the consumer
+  ParticleData p2 = particles.insert(Test::smashon_random());
+  p2.set_4position(FourVector(2.3, 0.5, 0.5, 1.5));
+  ActionPtr spectator = make_unique<HypersurfacecrossingAction>(p2, p2, 0.0);
+  spectator->generate_final_state();
+  spectator->perform(&particles, 1);
+
+  EventInfo event = Test::default_event_info(0.0, false);
+  auto consumer = std::make_shared<RecordingConsumer>();
+  ICOutput IC_output("SMASH_IC", OutputParameters(), consumer);
+  IC_output.at_eventstart(particles, 2, event);
+  IC_output.at_interaction(*action, 0.);
+  IC_output.at_interaction(*spectator, 0.);
+  IC_output.at_eventend(particles, 2, event);
+
+  COMPARE(consumer->events.size(), 2u);
+  COMPARE(consumer->events[0], 2);
+  COMPARE(consumer->events[1], -2);
+  COMPARE(consumer->crossings.size(), 1u);
+  const ICParticle &p = consumer->crossings[0];
+  COMPARE_ABSOLUTE_ERROR(p.tau, p1.position().tau(), 1e-12);
+  COMPARE_ABSOLUTE_ERROR(p.eta, p1.position().eta(), 1e-12);
+  COMPARE(p.x, p1.position()[1]);
+  COMPARE(p.px, p1.momentum()[1]);
+  COMPARE(p.pdg, p1.pdgcode());
+  COMPARE(p.charge, p1.type().charge());
+}
+
+TEST_CATCH(consumer_required, std::invalid_argument) {
+  ICOutput IC_output("SMASH_IC", OutputParameters(), nullptr);
+}
@@ -202,3 +202,66 @@ TEST(copy_constructor) {
                                COMPARE(node, lattice2.node(ix, iy, iz));
                              });
 }
+
+TEST(interpolated_value_at) {
+  const std::array<double, 3> l = {10., 6., 2.};
+  const std::array<int, 3> n = {4, 8, 3};
+  const std::array<double, 3> origin = {0., 3., 7.};
+  RectangularLattice<double> lattice(l, n, origin, false,
+                                     LatticeUpdate::EveryTimestep);
+  const auto linear = [](const ThreeVector &r) {
+    return 1. + 2. * r.x1() - 3. * r.x2() + 0.5 * r.x3();
+  };
+  lattice.iterate_sublattice({0, 0, 0}, lattice.dimensions(),
+                             [&](double &node, int ix, int iy, int iz) {
+                               node = linear(lattice.cell_center(ix, iy, iz));
+                             });
+  double value = 0.;
+  // A linear function is reproduced between the cell centers
+  ThreeVector r(4.1, 6.2, 8.1);
+  VERIFY(lattice.interpolated_value_at(r, value));
+  FUZZY_COMPARE(value, linear(r));
+  r = ThreeVector(1.25, 3.375, 7. + 1. / 3.);
+  VERIFY(lattice.interpolated_value_at(r, value));
+  FUZZY_COMPARE(value, linear(r));
+  // Beyond the outermost cell centers the value is constant
+  VERIFY(lattice.interpolated_value_at(ThreeVector(0.5, 6.2, 8.1), value));
+  FUZZY_COMPARE(value, linear(ThreeVector(1.25, 6.2, 8.1)));
+  // Out of the lattice
+  VERIFY(!lattice.interpolated_value_at(ThreeVector(-0.1, 6.2, 8.1), value));
+  COMPARE(value, 0.);
+  VERIFY(!lattice.interpolated_value_at(ThreeVector(4.1, 6.2, 9.), value));
+  COMPARE(value, 0.);
+
+  // evaluate_at uses the nearest cell unless interpolation is switched on
+  r = ThreeVector(4.1, 6.2, 8.1);
+  VERIFY(!lattice.interpolation());
+  VERIFY(lattice.evaluate_at(r, value));
+  COMPARE(value, lattice.node(1, 4, 1));
+  lattice.set_interpolation(true);
+  VERIFY(lattice.evaluate_at(r, value));
+  FUZZY_COMPARE(value, linear(r));
+}
+
+TEST(interpolated_value_at_periodic) {
+  const std::array<double, 3> l = {4., 4., 4.};
+  const std::array<int, 3> n = {4, 4, 4};
+  const std::array<double, 3> origin = {0., 0., 0.};
+  RectangularLattice<std::pair<ThreeVector, ThreeVector>> lattice(
+      l, n, origin, true, LatticeUpdate::EveryTimestep);
+  for (auto &node : lattice) {
+    node = std::make_pair(ThreeVector(), ThreeVector());
+  }
+  lattice.node(3, 0, 0).first = ThreeVector(1., 2., 3.);
+  lattice.node(0, 0, 0).second = ThreeVector(4., 0., 0.);
+  std::pair<ThreeVector, ThreeVector> value;
+  /* Halfway between the last cell center in x and the first one, which is
+   * its periodic neighbour */
+  VERIFY(lattice.interpolated_value_at(ThreeVector(4., 0.5, 0.5), value));
+  COMPARE(value.first, ThreeVector(0.5, 1., 1.5));
+  COMPARE(value.second, ThreeVector(2., 0., 0.));
+  // Same position in the next periodic image
+  VERIFY(lattice.interpolated_value_at(ThreeVector(0., 4.5, -3.5), value));
+  COMPARE(value.first, ThreeVector(0.5, 1., 1.5));
+  COMPARE(value.second, ThreeVector(2., 0., 0.));
+}
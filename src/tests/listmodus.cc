@@ -478,6 +478,38 @@ TEST(multiple_events_in_file) {
   }
 }
 
+TEST(missing_file_keys) {
+  auto par = Test::default_parameters();
+  for (const std::string &key : {"File_Directory", "File_Prefix"}) {
+    std::string list_conf_str = "List:\n";
+    if (key != "File_Directory") {
+      list_conf_str += "    File_Directory: \"";
+      list_conf_str += testoutputpath.native() + "\"\n";
+    }
+    if (key != "File_Prefix") {
+      list_conf_str += "    File_Prefix: \"event\"\n";
+    }
+    ListModus list_modus(Configuration(list_conf_str.c_str()), par);
+
+    // the key is not needed for particles passed from memory
+    list_modus.set_next_event({Test::smashon_random()});
+    Particles particles;
+    list_modus.initial_conditions(&particles, par);
+    COMPARE(particles.size(), 1u);
+
+    // but reading a file fails with an error naming the key
+    particles.reset();
+    bool thrown = false;
+    try {
+      list_modus.initial_conditions(&particles, par);
+    } catch (std::invalid_argument &e) {
+      thrown = true;
+      VERIFY(std::string(e.what()).find(key) != std::string::npos) << e.what();
+    }
+    VERIFY(thrown) << key;
+  }
+}
+
 TEST(try_create_particle_func) {
   // Create list modus
   std::string list_conf_str = "List:\n";
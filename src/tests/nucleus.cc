@@ -9,12 +9,19 @@
 
 #include <vir/test.h>  // This include has to be first
 
+#include <algorithm>
 #include <map>
+#include <vector>
 
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+#include "../include/smash/customnucleus.h"
 #include "../include/smash/nucleus.h"
 #include "../include/smash/particles.h"
 #include "../include/smash/pdgcode.h"
 #include "../include/smash/pow.h"
+#include "../include/smash/random.h"
 #include "../include/smash/threevector.h"
 
 namespace particles_txt {
@@ -220,6 +227,95 @@ TEST(woods_saxon) {
   }
 }
 
+/// \return sorted distances of the nucleons from the center of the nucleus
+static std::vector<double> sorted_radii(const Nucleus &nucleus) {
+  const ThreeVector center = nucleus.center().threevec();
+  std::vector<double> radii;
+  for (auto p = nucleus.cbegin(); p != nucleus.cend(); ++p) {
+    radii.push_back((p->position().threevec() - center).abs());
+  }
+  std::sort(radii.begin(), radii.end());
+  return radii;
+}
+
+TEST(configuration_library) {
+  Nucleus lead(list, 1);
+  lead.set_up_configuration_library(1, "");
+  VERIFY(lead.has_configuration_library());
+  lead.arrange_nucleons();
+  const std::vector<double> radii = sorted_radii(lead);
+  const ThreeVector first_position = lead.cbegin()->position().threevec();
+  // Every event draws the same configuration, but randomly rotated.
+  for (int i = 0; i < 10; i++) {
+    lead.arrange_nucleons();
+    VERIFY(lead.cbegin()->position().threevec() != first_position);
+    const std::vector<double> new_radii = sorted_radii(lead);
+    for (size_t j = 0; j < radii.size(); j++) {
+      COMPARE_ABSOLUTE_ERROR(new_radii[j], radii[j], 1e-5);
+    }
+  }
+}
+
+TEST(configuration_library_file) {
+  const bf::path output_path = bf::absolute(SMASH_TEST_OUTPUT_PATH);
+  bf::create_directories(output_path);
+  const std::string file = (output_path / "lead_library.bin").string();
+  bf::remove(file);
+
+  Nucleus lead(list, 1);
+  lead.set_up_configuration_library(5, file);
+  VERIFY(bf::exists(file));
+  Nucleus lead_from_file(list, 1);
+  lead_from_file.set_up_configuration_library(5, file);
+
+  // The same random numbers draw the same configurations.
+  for (int i = 0; i < 5; i++) {
+    random::set_seed(i);
+    lead.arrange_nucleons();
+    random::set_seed(i);
+    lead_from_file.arrange_nucleons();
+    auto p = lead.cbegin();
+    auto q = lead_from_file.cbegin();
+    for (; p != lead.cend(); ++p, ++q) {
+      COMPARE(p->position(), q->position());
+    }
+  }
+}
+
+TEST(configuration_library_keeps_isospin) {
+  const bf::path output_path = bf::absolute(SMASH_TEST_OUTPUT_PATH);
+  bf::create_directories(output_path);
+  /* The proton is far away from the neutrons in both configurations, but the
+   * order of protons and neutrons differs between them. */
+  {
+    bf::ofstream file(output_path / "isospin_order.txt");
+    file << "10 0 0 0 1\n"
+            "0 0 0 0 0\n"
+            "0 0 1 0 0\n"
+            "0 1 0 0 0\n"
+            "0 0 0 0 0\n"
+            "0 10 0 0 1\n";
+  }
+  Configuration config(
+      ("Particles: {2212: 1, 2112: 2}\n"
+       "Custom:\n"
+       "  File_Directory: \"" +
+       output_path.string() +
+       "\"\n"
+       "  File_Name: \"isospin_order.txt\"\n")
+          .c_str());
+  CustomNucleus nucleus(config, 1, false);
+  nucleus.set_up_configuration_library(2, "");
+  for (int i = 0; i < 20; i++) {
+    nucleus.arrange_nucleons();
+    const ThreeVector center = nucleus.center().threevec();
+    for (auto p = nucleus.cbegin(); p != nucleus.cend(); ++p) {
+      const double r = (p->position().threevec() - center).abs();
+      COMPARE(r > 5., p->pdgcode() == pdg::p) << r;
+    }
+  }
+}
+
 TEST(Fermi_motion) {
   std::map<PdgCode, int> myfunnylist = {{0x2212, 22},  // protons
                                         {0x2112, 35},  // neutrons
@@ -9,6 +9,9 @@
 
 #include <vir/test.h>  // This include has to be first
 
+#include <map>
+#include <utility>
+
 #include "setup.h"
 
 #include "../include/smash/particledata.h"
@@ -340,3 +343,117 @@ TEST(update) {
   COMPARE(p.front().position(), FourVector(3, 3, 3, 3));
   COMPARE(p.front().id_process(), 2u);
 }
+
+TEST(reorder_spatially) {
+  Particles p;
+  // alternate between two clusters which are far apart
+  for (int i = 0; i < 40; ++i) {
+    const double x = (i % 2 == 0) ? 0.01 * i : 20. + 0.01 * i;
+    p.insert(Test::smashon(Test::Position{0, x, 0.02 * i, -0.03 * i},
+                           Test::Momentum{1, 0, 0, 0.1 * i}));
+  }
+  auto copy = p.copy_to_vector();
+  p.remove(copy[3]);
+  p.remove(copy[10]);
+  p.remove(copy[17]);
+  copy = p.copy_to_vector();
+  COMPARE(p.size(), 37u);
+
+  p.reorder_spatially(1.);
+  COMPARE(p.size(), 37u);
+
+  // the ids and the kinematics are kept
+  std::map<int, ParticleData> by_id;
+  for (const ParticleData &x : copy) {
+    by_id.emplace(x.id(), x);
+  }
+  int cluster_changes = 0;
+  bool previous_in_first_cluster = p.front().position().x1() < 10.;
+  for (const ParticleData &x : p) {
+    auto it = by_id.find(x.id());
+    VERIFY(it != by_id.end());
+    COMPARE(x.position(), it->second.position());
+    COMPARE(x.momentum(), it->second.momentum());
+    COMPARE(x.id_process(), it->second.id_process());
+    by_id.erase(it);
+    VERIFY(p.is_valid(x));
+    const bool in_first_cluster = x.position().x1() < 10.;
+    if (in_first_cluster != previous_in_first_cluster) {
+      ++cluster_changes;
+    }
+    previous_in_first_cluster = in_first_cluster;
+  }
+  VERIFY(by_id.empty());
+  // each cluster is stored contiguously
+  COMPARE(cluster_changes, 1);
+
+  // the holes are gone, so new particles are appended
+  const ParticleData &inserted = p.insert(Test::smashon());
+  COMPARE(inserted.id(), 40);
+  VERIFY(&inserted == &p.back());
+  COMPARE(p.size(), 38u);
+}
+
+TEST(snapshot) {
+  Particles p;
+  for (int i = 0; i < 20; ++i) {
+    p.insert(Test::smashon(Test::Position{0, 0.1 * i, 0, 0},
+                           Test::Momentum{1, 0, 0, 0.01 * i}));
+  }
+  auto copy = p.copy_to_vector();
+  p.remove(copy[4]);
+  p.remove(copy[9]);
+  const ParticleList before = p.copy_to_vector();
+
+  const uint64_t generation = p.snapshot_generation();
+  const Particles::Snapshot snapshot = p.take_snapshot();
+  VERIFY(snapshot.is_current());
+  VERIFY(p.snapshot_generation() != generation);
+
+  // modify the particles in all possible ways
+  copy = p.copy_to_vector();
+  p.remove(copy[2]);
+  p.remove(copy.back());
+  p.insert(Test::smashon(Test::Position{0, 5, 5, 5}));
+  ParticleList to_add = {Test::smashon(), Test::smashon()};
+  p.replace({copy[7]}, to_add);
+  auto updated = copy[11];
+  updated.set_4momentum(updated.pole_mass(), 1., 2., 3.);
+  p.update_particle(copy[11], updated);
+  p.create(30, 0x661);
+  COMPARE(p.size(), 18u + 30u);
+
+  // the snapshot still yields the particles before the modifications
+  std::size_t n = 0;
+  for (const ParticleData &x : snapshot) {
+    VERIFY(n < before.size());
+    COMPARE(x.id(), before[n].id());
+    COMPARE(x.id_process(), before[n].id_process());
+    COMPARE(x.position(), before[n].position());
+    COMPARE(x.momentum(), before[n].momentum());
+    ++n;
+  }
+  COMPARE(n, before.size());
+
+  p.release_snapshot();
+  VERIFY(!snapshot.is_current());
+  // taking a new snapshot shows the current state
+  n = 0;
+  const ParticleList now = p.copy_to_vector();
+  for (const ParticleData &x : p.take_snapshot()) {
+    COMPARE(x.id(), now[n].id());
+    ++n;
+  }
+  COMPARE(n, now.size());
+  // the temporary view above released its snapshot when it was destroyed
+  COMPARE(p.snapshot_generation(), generation + 4);
+  {
+    Particles::Snapshot moved = p.take_snapshot();
+    const Particles::Snapshot owner = std::move(moved);
+    VERIFY(owner.is_current());
+  }
+  // only the view that was moved to released the snapshot
+  COMPARE(p.snapshot_generation(), generation + 6);
+  p.reset();
+  COMPARE(p.snapshot_generation(), generation + 7);
+}
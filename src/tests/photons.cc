@@ -11,6 +11,7 @@
 
 #include "../include/smash/bremsstrahlungaction.h"
 #include "../include/smash/crosssectionsphoton.h"
+#include "../include/smash/random.h"
 #include "../include/smash/scatteractionphoton.h"
 
 using namespace smash;
@@ -74,6 +75,39 @@ TEST(binary_scatterings_pi_rho0_pi_gamma_Nfrac_1) {
   COMPARE_RELATIVE_ERROR(tot_weight2, 0.000722419008, 0.08);
 }
 
+TEST(binary_scatterings_perform_photons_matches_single_photons) {
+  // the batched sampling in perform_photons has to reproduce the photons of
+  // repeated generate_final_state calls with the same random numbers
+  const ParticleType &type_pi = ParticleType::find(0x211);
+  ParticleData pi{type_pi};
+  pi.set_4momentum(type_pi.mass(), ThreeVector(0.1, 0., 1.));
+  const ParticleType &type_rho0 = ParticleType::find(0x113);
+  ParticleData rho0{type_rho0};
+  rho0.set_4momentum(type_rho0.mass(), ThreeVector(0., 0.2, -1.));
+  const int number_of_photons = 50;
+  ParticleList in{rho0, pi};
+
+  random::set_seed(42);
+  ScatterActionPhoton single(in, 0.05, number_of_photons, 5.0);
+  single.add_single_process();
+  for (int i = 0; i < number_of_photons; i++) {
+    single.generate_final_state();
+  }
+
+  random::set_seed(42);
+  ScatterActionPhoton batch(in, 0.05, number_of_photons, 5.0);
+  batch.add_single_process();
+  batch.perform_photons({});
+
+  COMPARE(batch.get_total_weight(), single.get_total_weight());
+  for (int i = 0; i < 2; i++) {
+    COMPARE(batch.outgoing_particles()[i].momentum(),
+            single.outgoing_particles()[i].momentum());
+    COMPARE(batch.outgoing_particles()[i].position(),
+            single.outgoing_particles()[i].position());
+  }
+}
+
 TEST(binary_scatterings_photon_and_hadron_reaction_type_function) {
   /*
    *creates possible photon reactions and also some that
@@ -288,6 +322,39 @@ TEST(bremsstrahlung_gen_final_state) {
   COMPARE_RELATIVE_ERROR(tot_weight, 1.84592, 1e-5);
 }
 
+TEST(bremsstrahlung_perform_matches_single_photons) {
+  // the batched sampling in perform_bremsstrahlung has to reproduce the
+  // photons of repeated generate_final_state calls with the same random numbers
+  const ParticleType &type_pip = ParticleType::find(0x211);
+  ParticleData pip{type_pip};
+  pip.set_4momentum(type_pip.mass(), ThreeVector(0., 0.3, 2.));
+  const ParticleType &type_piz = ParticleType::find(0x111);
+  ParticleData piz{type_piz};
+  piz.set_4momentum(type_piz.mass(), ThreeVector(0.1, 0., -2.));
+  const int number_of_photons = 50;
+  ParticleList in{pip, piz};
+
+  random::set_seed(42);
+  BremsstrahlungAction single(in, 0.05, number_of_photons, 20.0);
+  single.add_single_process();
+  for (int i = 0; i < number_of_photons; i++) {
+    single.generate_final_state();
+  }
+
+  random::set_seed(42);
+  BremsstrahlungAction batch(in, 0.05, number_of_photons, 20.0);
+  batch.add_single_process();
+  batch.perform_bremsstrahlung({});
+
+  COMPARE(batch.get_total_weight(), single.get_total_weight());
+  for (int i = 0; i < 3; i++) {
+    COMPARE(batch.outgoing_particles()[i].momentum(),
+            single.outgoing_particles()[i].momentum());
+    COMPARE(batch.outgoing_particles()[i].position(),
+            single.outgoing_particles()[i].position());
+  }
+}
+
 TEST(bremsstrahlung_reaction_type_function) {
   const ParticleData pip{ParticleType::find(0x211)};
   const ParticleData pim{ParticleType::find(-0x211)};
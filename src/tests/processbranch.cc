@@ -71,6 +71,19 @@ TEST(add_particle) {
   };
   CollisionBranch branch(list, 1.2, ProcessType::Elastic);
   COMPARE(branch.particle_types().size(), 3u);
+  COMPARE(branch.particle_number(), 3u);
+  COMPARE(ParticleTypePtrList(branch.particle_types()), list);
+
+  // moving keeps the particle types
+  CollisionBranch moved(std::move(branch));
+  COMPARE(ParticleTypePtrList(moved.particle_types()), list);
+  COMPARE(moved.weight(), 1.2);
+}
+
+TEST_CATCH(too_many_particles, std::invalid_argument) {
+  const ParticleTypePtr smashon = &ParticleType::find(PdgCode("9876542"));
+  CollisionBranch branch({smashon, smashon, smashon, smashon}, 1.2,
+                         ProcessType::Elastic);
 }
 
 TEST(weights) {
@@ -11,12 +11,15 @@
 
 #include "setup.h"
 
+#include <algorithm>
+
 #include "../include/smash/boxmodus.h"
 #include "../include/smash/collidermodus.h"
 #include "../include/smash/modusdefault.h"
 #include "../include/smash/potentials.h"
 #include "../include/smash/propagation.h"
 #include "../include/smash/spheremodus.h"
+#include "../include/smash/wallcrossingaction.h"
 
 using namespace smash;
 using smash::Test::Momentum;
@@ -77,6 +80,97 @@ TEST(propagate_default_no_potentials) {
           FourVector(1.0, 0.2 - 0.3 / 0.51, 0.0, 4.8 + 0.4 / 0.51));
 }
 
+/**
+ * Propagate the particles to \p to_time and perform the wall crossings in the
+ * box of length \p length as actions, like the Experiment does with the
+ * WallCrossActionsFinder. The performed actions are appended to \p performed.
+ */
+static void propagate_with_wall_actions(Particles *particles, double length,
+                                        double to_time, ActionList *performed) {
+  const WallCrossActionsFinder finder(length);
+  double time = particles->front().position().x0();
+  while (true) {
+    ActionList actions = finder.find_actions_in_cell(
+        particles->copy_to_vector(), to_time - time, 0., {});
+    if (actions.empty()) {
+      break;
+    }
+    auto next = std::min_element(
+        actions.begin(), actions.end(),
+        [](const ActionPtr &a, const ActionPtr &b) { return *a < *b; });
+    time = (*next)->time_of_execution();
+    propagate_straight_line(particles, time, {});
+    (*next)->update_incoming(*particles);
+    (*next)->perform(particles, performed->size() + 1);
+    performed->emplace_back(std::move(*next));
+  }
+  propagate_straight_line(particles, to_time, {});
+}
+
+TEST(inline_wall_crossing_matches_actions) {
+  ExperimentParameters par = Test::default_parameters();
+  par.box_length = 5.0;
+  BoxModus box(Configuration("Box:\n"
+                             "  Initial_Condition: \"peaked momenta\"\n"
+                             "  Length: 5.0\n"
+                             "  Temperature: 0.5\n"
+                             "  Start_Time: 0.0\n"
+                             "  Init_Multiplicities:\n"
+                             "    661: 1\n"
+                             "  Inline_Wall_Crossing: True\n"),
+               par);
+  VERIFY(box.inline_wall_crossing());
+
+  // long enough for several crossings of one particle, also of two walls
+  constexpr double end_time = 12.0;
+  auto with_actions = create_box_particles();
+  ActionList performed;
+  propagate_with_wall_actions(with_actions.get(), 5.0, end_time, &performed);
+
+  auto inline_wrapped = create_box_particles();
+  ActionList crossings;
+  propagate_straight_line(inline_wrapped.get(), end_time, {});
+  const int n_crossings =
+      box.wrap_wall_crossings(inline_wrapped.get(), &crossings);
+
+  VERIFY(n_crossings > 6);
+  COMPARE(static_cast<std::size_t>(n_crossings), performed.size());
+  COMPARE(crossings.size(), performed.size());
+  for (std::size_t i = 0; i < crossings.size(); i++) {
+    const ParticleData &in = crossings[i]->incoming_particles()[0];
+    const ParticleData &out = crossings[i]->outgoing_particles()[0];
+    COMPARE(crossings[i]->get_type(), ProcessType::Wall);
+    COMPARE(in.id(), performed[i]->incoming_particles()[0].id()) << i;
+    COMPARE_ABSOLUTE_ERROR(crossings[i]->time_of_execution(),
+                           performed[i]->time_of_execution(), 1e-12)
+        << i;
+    for (int j = 0; j < 4; j++) {
+      COMPARE_ABSOLUTE_ERROR(
+          in.position()[j],
+          performed[i]->incoming_particles()[0].position()[j], 1e-12)
+          << i;
+      COMPARE_ABSOLUTE_ERROR(
+          out.position()[j],
+          performed[i]->outgoing_particles()[0].position()[j], 1e-12)
+          << i;
+    }
+  }
+
+  COMPARE(inline_wrapped->size(), with_actions->size());
+  auto it = with_actions->begin();
+  for (const ParticleData &p : *inline_wrapped) {
+    COMPARE(p.id(), it->id());
+    for (int j = 0; j < 4; j++) {
+      COMPARE_ABSOLUTE_ERROR(p.position()[j], it->position()[j], 1e-12)
+          << p.id();
+    }
+    ++it;
+  }
+
+  // nothing is left to wrap
+  COMPARE(box.wrap_wall_crossings(inline_wrapped.get()), 0);
+}
+
 TEST(hubble) {
   // setting up some exeplary metrics with simple b_ for
   // easy analytic values. All ExpansionModes are tested.
@@ -7,6 +7,9 @@
 
 #include <vir/test.h>  // This include has to be first
 
+#include <array>
+#include <vector>
+
 #include "setup.h"
 
 #include "../include/smash/scatteractionmulti.h"
@@ -139,3 +142,31 @@ TEST(deuteron_three_to_two) {
   VERIFY(act2->reaction_channels()[0]->get_type() ==
          ProcessType::MultiParticleThreeToTwo);
 }
+
+TEST(tabulated_I3) {
+  const double m_pi = ParticleType::find(0x211).mass();
+  const double m_eta = ParticleType::find(0x221).mass();
+  const double m_N = ParticleType::find(0x2212).mass();
+  const std::vector<std::array<double, 3>> mass_sets = {
+      {m_pi, m_pi, m_pi}, {m_pi, m_pi, m_eta}, {m_pi, m_N, m_N}};
+  for (const auto &m : mass_sets) {
+    const double threshold = m[0] + m[1] + m[2];
+    /* From close to the threshold up to beyond the tabulated range. Closer
+     * to the threshold, the absolute precision of the direct integration is
+     * not sufficient for the comparison. */
+    for (double q = 0.01; q < 6.; q *= 1.3) {
+      const double sqrts = threshold + q;
+      const double direct =
+          ScatterActionMulti::integrate_I3(sqrts, m[0], m[1], m[2]);
+      COMPARE_RELATIVE_ERROR(
+          ScatterActionMulti::tabulated_I3(sqrts, m[0], m[1], m[2]), direct,
+          1e-3)
+          << "sqrts = " << sqrts;
+      // the integral does not depend on the order of the masses
+      COMPARE_RELATIVE_ERROR(
+          ScatterActionMulti::tabulated_I3(sqrts, m[2], m[0], m[1]), direct,
+          1e-3)
+          << "sqrts = " << sqrts;
+    }
+  }
+}
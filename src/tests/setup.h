@@ -254,6 +254,7 @@ inline ExperimentParameters default_parameters(
       testparticles,                      // testparticles
       1.0,                                // Gaussian smearing width
       4.0,                                // Gaussian smearing cut-off
+      SmearingMode::Covariant,            // lattice smearing
       crit,
       true,  // two_to_one
       all_reactions_included(),
@@ -56,4 +56,16 @@ TEST(split) {
   COMPARE(storage[2], "_is_pion_");
 }
 
+TEST(quote_csv) {
+  COMPARE(quote_csv("π⁺p → Δ⁺⁺"), "π⁺p → Δ⁺⁺");
+  COMPARE(quote_csv("a,b"), "\"a,b\"");
+  COMPARE(quote_csv("say \"x\""), "\"say \"\"x\"\"\"");
+}
+
+TEST(quote_json) {
+  COMPARE(quote_json("π⁺p → Δ⁺⁺"), "\"π⁺p → Δ⁺⁺\"");
+  COMPARE(quote_json("a\"b\\c\n"), "\"a\\\"b\\\\c\\n\"");
+  COMPARE(quote_json(std::string(1, '\x01')), "\"\\u0001\"");
+}
+
 }  // namespace smash
@@ -379,6 +379,71 @@ TEST(string_zlund) {
                     [](double x) { return 1 / x * (1. - x) * exp(-1. / x); });
 }
 
+/**
+ * Compare sampled values of the LUND function to analytical ones for
+ * parameters, where the maximum is close to 0 or 1.
+ */
+TEST(string_zlund_peaked) {
+  // peaked near 0: large a and small b * mT^2
+  test_distribution(
+      1e7, 0.0001, []() { return StringProcess::sample_zLund(10., .1, .2); },
+      [](double x) { return 1 / x * std::pow(1. - x, 10.) * exp(-.004 / x); });
+  // peaked near 1: small a and large b * mT^2
+  test_distribution(
+      1e7, 0.0001, []() { return StringProcess::sample_zLund(.2, 2., 2.); },
+      [](double x) { return 1 / x * std::pow(1. - x, .2) * exp(-8. / x); });
+  // maximum at 1: a = 0
+  test_distribution(
+      1e7, 0.0001, []() { return StringProcess::sample_zLund(0., 3., 1.); },
+      [](double x) { return 1 / x * exp(-3. / x); });
+}
+
+/**
+ * Previous implementation of StringProcess::sample_zLund, which samples 1/z
+ * with an exponential envelope. It is kept to compare the distributions.
+ */
+static double sample_zLund_exponential_envelope(double a, double b,
+                                                double mTrn) {
+  while (true) {
+    const double fac_env = b * mTrn * mTrn;
+    const double xfrac_inv = 1. - std::log(random::uniform(0., 1.)) / fac_env;
+    const double xf_ratio = std::pow(1. - 1. / xfrac_inv, a) / xfrac_inv;
+    if (random::uniform(0., 1.) <= xf_ratio) {
+      return 1. / xfrac_inv;
+    }
+  }
+}
+
+TEST(string_zlund_compare_to_exponential_envelope) {
+  const std::vector<std::array<double, 3>> parameters = {{{1., 1., 1.}},
+                                                         {{2., .55, .3}},
+                                                         {{.2, 2., 2.}},
+                                                         {{10., .1, .2}},
+                                                         {{0., 3., 1.}}};
+  constexpr int n_samples = 200000;
+  for (const auto &par : parameters) {
+    // the first two moments of both samplers
+    std::array<double, 2> moments = {{0., 0.}};
+    std::array<double, 2> moments_reference = {{0., 0.}};
+    for (int i = 0; i < n_samples; i++) {
+      const double z = StringProcess::sample_zLund(par[0], par[1], par[2]);
+      const double z_ref =
+          sample_zLund_exponential_envelope(par[0], par[1], par[2]);
+      moments[0] += z / n_samples;
+      moments[1] += z * z / n_samples;
+      moments_reference[0] += z_ref / n_samples;
+      moments_reference[1] += z_ref * z_ref / n_samples;
+    }
+    /* Upper bound of the standard error of the difference of both estimates,
+     * since z^4 <= z^2 for 0 < z < 1. */
+    const double error = std::sqrt(2. * moments_reference[1] / n_samples);
+    for (int k = 0; k < 2; k++) {
+      COMPARE_ABSOLUTE_ERROR(moments[k], moments_reference[k], 5. * error)
+          << "a = " << par[0] << ", b = " << par[1] << ", mT = " << par[2];
+    }
+  }
+}
+
 TEST(string_incoming_lightcone_momenta) {
   std::unique_ptr<StringProcess> sp =
       make_unique<StringProcess>(1.0, 1.0, .0, 0.001, .0, .0, 1., 1., .0, .0,
@@ -696,6 +761,23 @@ TEST(pdg_map_for_pythia) {
   VERIFY(pdgid_mapped == -2112);
 }
 
+TEST(string_resonance_from_quark) {
+  std::unique_ptr<StringProcess> sp =
+      make_unique<StringProcess>(1., 1., .0, .001, .0, .0, 1., 1., .0, .0, .5,
+                                 .0, .0, .0, .0, true, 1. / 3., true, 0.);
+
+  // u and anti-d at the pole mass of the rho
+  COMPARE(sp->get_resonance_from_quark(2, -1, 0.776), 213);
+  // u and ud-diquark at the pole mass of the Delta
+  COMPARE(sp->get_resonance_from_quark(2, 2101, 1.232), 2214);
+  // anti-ud-diquark and anti-u
+  COMPARE(sp->get_resonance_from_quark(-2101, -2, 1.232), -2214);
+  // below the pion mass
+  COMPARE(sp->get_resonance_from_quark(2, -1, 0.1), 0);
+  // two quarks cannot form a hadron
+  COMPARE(sp->get_resonance_from_quark(2, 1, 1.), 0);
+}
+
 TEST(string_scaling_factors) {
   ParticleData a{ParticleType::find(0x2212)};
   ParticleData b{ParticleType::find(0x2212)};
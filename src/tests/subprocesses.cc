@@ -0,0 +1,48 @@
+/*
+ *
+ *    Copyright (c) 2020
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include <vir/test.h>  // This include has to be first
+
+#include "../include/smash/subprocesses.h"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace smash;
+
+static std::string square(size_t i) { return std::to_string(i * i); }
+
+TEST(results_are_ordered) {
+  const std::vector<std::string> results = run_in_subprocesses(10, 3, square);
+  COMPARE(results.size(), 10u);
+  for (size_t i = 0; i < results.size(); i++) {
+    COMPARE(results[i], square(i));
+  }
+}
+
+TEST(independent_of_number_of_workers) {
+  // Includes empty results and results containing zero bytes.
+  auto task = [](size_t i) { return std::string(i % 4, static_cast<char>(i)); };
+  const auto serial = run_in_subprocesses(25, 1, task);
+  for (int n_workers : {2, 4, 7, 30}) {
+    COMPARE(run_in_subprocesses(25, n_workers, task), serial) << n_workers;
+  }
+}
+
+TEST(no_tasks) { VERIFY(run_in_subprocesses(0, 4, square).empty()); }
+
+TEST_CATCH(failing_worker, std::runtime_error) {
+  run_in_subprocesses(5, 2, [](size_t i) -> std::string {
+    if (i == 3) {
+      throw std::invalid_argument("task failed");
+    }
+    return square(i);
+  });
+}
@@ -89,3 +89,23 @@ TEST(quadratic) {
   // check extrapolated values
   COMPARE_ABSOLUTE_ERROR(tab.get_value_linear(3.), 7.8, error);
 }
+
+TEST(running_maximum) {
+  // tabulate a function with a maximum in the middle of the domain
+  const Tabulation tab(0., 4., 8,
+                       [](double x) { return 4. - (x - 2) * (x - 2); });
+  const Tabulation max = tab.running_maximum();
+  FUZZY_COMPARE(max.x_max(), tab.x_max());
+  // the maximum includes the next tabulation point
+  FUZZY_COMPARE(max.get_value_step(0.), 1.75);
+  FUZZY_COMPARE(max.get_value_step(1.), 3.75);
+  FUZZY_COMPARE(max.get_value_step(1.5), 4.);
+  FUZZY_COMPARE(max.get_value_step(3.), 4.);
+  FUZZY_COMPARE(max.get_value_step(4.), 4.);
+  // it is an upper bound of the linear interpolation below the argument
+  for (double x = 0.; x <= 4.; x += 0.01) {
+    for (double y = 0.; y <= x; y += 0.01) {
+      VERIFY(tab.get_value_linear(y) <= max.get_value_step(x));
+    }
+  }
+}
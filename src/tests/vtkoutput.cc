@@ -13,9 +13,12 @@
 
 #include <smash/config.h>
 #include <array>
+#include <cstring>
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/fstream.hpp>
 #include <iostream>
+#include <iterator>
+#include <string>
 #include <vector>
 
 #include "../include/smash/clock.h"
@@ -295,3 +298,67 @@ TEST(vtkoutputfile) {
   VERIFY(bf::remove(outputfilepath));
   VERIFY(bf::remove(outputfile2path));
 }
+
+TEST(vtk_xml_outputfile) {
+  Particles particles;
+  const int number_of_particles = 5;
+  for (int i = 0; i < number_of_particles; i++) {
+    particles.insert(Test::smashon_random());
+  }
+
+  OutputParameters out_par = OutputParameters();
+  std::unique_ptr<VtkOutput> vtkop = make_unique<VtkOutput>(
+      testoutputpath, "Particles", out_par, VtkFormat::XmlBinary);
+  EventInfo event = Test::default_event_info();
+  vtkop->at_eventstart(particles, 0, event);
+  DensityParameters dens_par(Test::default_parameters());
+  vtkop->at_intermediate_time(particles, nullptr, dens_par, event);
+  vtkop->at_eventend(particles, 0, event);
+  const bf::path outputfilepath = testoutputpath / "pos_ev00000_tstep00000.vtu";
+  const bf::path outputfile2path =
+      testoutputpath / "pos_ev00000_tstep00001.vtu";
+  const bf::path collectionpath = testoutputpath / "pos_ev00000.pvd";
+  VERIFY(bf::exists(outputfilepath));
+  VERIFY(bf::exists(outputfile2path));
+  VERIFY(bf::exists(collectionpath));
+
+  {
+    bf::ifstream outputfile(outputfilepath, std::ios::binary);
+    const std::string content((std::istreambuf_iterator<char>(outputfile)),
+                              std::istreambuf_iterator<char>());
+    VERIFY(content.find("<VTKFile type=\"UnstructuredGrid\"") !=
+           std::string::npos);
+    VERIFY(content.find("NumberOfPoints=\"5\"") != std::string::npos);
+    VERIFY(content.find("Name=\"pdg_codes\"") != std::string::npos);
+    VERIFY(content.find("compressor") == std::string::npos);
+    /* The positions are the first appended array: the number of bytes
+     * followed by the raw coordinates. */
+    const auto start = content.find("<AppendedData encoding=\"raw\">");
+    VERIFY(start != std::string::npos);
+    const auto data = content.find('_', start) + 1;
+    uint64_t n_bytes;
+    std::memcpy(&n_bytes, &content[data], sizeof(n_bytes));
+    COMPARE(n_bytes, 3 * number_of_particles * sizeof(double));
+    std::vector<double> positions(3 * number_of_particles);
+    std::memcpy(positions.data(), &content[data + sizeof(n_bytes)], n_bytes);
+    int i = 0;
+    for (const auto &pd : particles) {
+      const ThreeVector r = pd.position().threevec();
+      COMPARE(positions[i++], r.x1());
+      COMPARE(positions[i++], r.x2());
+      COMPARE(positions[i++], r.x3());
+    }
+  }
+  {
+    bf::ifstream collection(collectionpath);
+    const std::string content((std::istreambuf_iterator<char>(collection)),
+                              std::istreambuf_iterator<char>());
+    VERIFY(content.find("file=\"pos_ev00000_tstep00000.vtu\"") !=
+           std::string::npos);
+    VERIFY(content.find("file=\"pos_ev00000_tstep00001.vtu\"") !=
+           std::string::npos);
+  }
+  VERIFY(bf::remove(outputfilepath));
+  VERIFY(bf::remove(outputfile2path));
+  VERIFY(bf::remove(collectionpath));
+}
@@ -11,6 +11,7 @@
 
 #include <fstream>
 #include <memory>
+#include <vector>
 
 #include <boost/filesystem.hpp>
 
@@ -181,35 +182,20 @@ void ThermodynamicOutput::at_intermediate_time(
     const Particles &particles, const std::unique_ptr<Clock> &clock,
     const DensityParameters &dens_param, const EventInfo &) {
   std::fprintf(file_.get(), "%6.2f ", clock->current_time());
-  constexpr bool compute_gradient = false;
+  const bool compute_tmn =
+      out_par_.td_tmn || out_par_.td_tmn_landau || out_par_.td_v_landau;
+  // all quantities are computed in a single pass over the particles
+  const ThermodynamicProbe probe =
+      probe_thermodynamics({out_par_.td_position}, particles, dens_param,
+                           out_par_.td_dens_type, out_par_.td_smearing,
+                           out_par_.td_rho_eckart, compute_tmn,
+                           out_par_.td_jQBS)
+          .front();
   if (out_par_.td_rho_eckart) {
-    const double rho = std::get<0>(current_eckart(
-        out_par_.td_position, particles, dens_param, out_par_.td_dens_type,
-        compute_gradient, out_par_.td_smearing));
-    std::fprintf(file_.get(), "%7.4f ", rho);
+    std::fprintf(file_.get(), "%7.4f ", probe.rho_eckart);
   }
-  if (out_par_.td_tmn || out_par_.td_tmn_landau || out_par_.td_v_landau) {
-    EnergyMomentumTensor Tmn;
-    for (const auto &p : particles) {
-      const double dens_factor =
-          density_factor(p.type(), out_par_.td_dens_type);
-      if (std::abs(dens_factor) < really_small) {
-        continue;
-      }
-      if (out_par_.td_smearing) {
-        const auto sf =
-            unnormalized_smearing_factor(
-                p.position().threevec() - out_par_.td_position, p.momentum(),
-                1.0 / p.momentum().abs(), dens_param, compute_gradient)
-                .first;
-        if (sf < really_small) {
-          continue;
-        }
-        Tmn.add_particle(p, dens_factor * sf * dens_param.norm_factor_sf());
-      } else {
-        Tmn.add_particle(p, dens_factor);
-      }
-    }
+  if (compute_tmn) {
+    const EnergyMomentumTensor &Tmn = probe.Tmn;
     const FourVector u = Tmn.landau_frame_4velocity();
     const EnergyMomentumTensor Tmn_L = Tmn.boosted(u);
     if (out_par_.td_tmn) {
@@ -228,15 +214,7 @@ void ThermodynamicOutput::at_intermediate_time(
     }
   }
   if (out_par_.td_jQBS) {
-    FourVector jQ = std::get<1>(current_eckart(
-        out_par_.td_position, particles, dens_param, DensityType::Charge,
-        compute_gradient, out_par_.td_smearing));
-    FourVector jB = std::get<1>(current_eckart(
-        out_par_.td_position, particles, dens_param, DensityType::Baryon,
-        compute_gradient, out_par_.td_smearing));
-    FourVector jS = std::get<1>(current_eckart(
-        out_par_.td_position, particles, dens_param, DensityType::Strangeness,
-        compute_gradient, out_par_.td_smearing));
+    const FourVector &jQ = probe.jQ, &jB = probe.jB, &jS = probe.jS;
     std::fprintf(file_.get(), "%15.12f %15.12f %15.12f %15.12f ", jQ[0], jQ[1],
                  jQ[2], jQ[3]);
     std::fprintf(file_.get(), "%15.12f %15.12f %15.12f %15.12f ", jB[0], jB[1],
@@ -251,18 +229,23 @@ void ThermodynamicOutput::density_along_line(
     const char *file_name, const ParticleList &plist,
     const DensityParameters &param, DensityType dens_type,
     const ThreeVector &line_start, const ThreeVector &line_end, int n_points) {
-  ThreeVector r;
   std::ofstream a_file;
   a_file.open(file_name, std::ios::out);
-  const bool compute_gradient = false;
   const bool smearing = true;
 
+  std::vector<ThreeVector> points;
+  points.reserve(n_points + 1);
+  for (int i = 0; i <= n_points; i++) {
+    points.push_back(line_start +
+                     (line_end - line_start) * (1.0 * i / n_points));
+  }
+  // the densities at all points are computed in a single pass
+  const std::vector<ThermodynamicProbe> probes = probe_thermodynamics(
+      points, plist, param, dens_type, smearing, true, false, false);
   for (int i = 0; i <= n_points; i++) {
-    r = line_start + (line_end - line_start) * (1.0 * i / n_points);
-    double rho_eck = std::get<0>(
-        current_eckart(r, plist, param, dens_type, compute_gradient, smearing));
-    a_file << r.x1() << " " << r.x2() << " " << r.x3() << " " << rho_eck
-           << "\n";
+    const ThreeVector &r = points[i];
+    a_file << r.x1() << " " << r.x2() << " " << r.x3() << " "
+           << probes[i].rho_eckart << "\n";
   }
 }
 
@@ -7,8 +7,16 @@
  *
  */
 
+#include <cstdint>
+#include <cstring>
 #include <fstream>
+#include <iomanip>
 #include <memory>
+#include <sstream>
+
+#ifdef SMASH_USE_ZLIB
+#include <zlib.h>
+#endif
 
 #include "smash/clock.h"
 #include "smash/config.h"
@@ -20,15 +28,173 @@
 namespace smash {
 static constexpr int LOutput = LogArea::Output::id;
 
+namespace {
+/// \return Name of the VTK XML data type corresponding to T
+template <typename T>
+const char *vtk_type_name();
+/// \see vtk_type_name
+template <>
+const char *vtk_type_name<double>() {
+  return "Float64";
+}
+/// \see vtk_type_name
+template <>
+const char *vtk_type_name<int32_t>() {
+  return "Int32";
+}
+/// \see vtk_type_name
+template <>
+const char *vtk_type_name<int64_t>() {
+  return "Int64";
+}
+/// \see vtk_type_name
+template <>
+const char *vtk_type_name<uint8_t>() {
+  return "UInt8";
+}
+
+/// \return Byte order of the machine in the notation of VTK
+const char *vtk_byte_order() {
+  const uint16_t one = 1;
+  unsigned char first_byte;
+  std::memcpy(&first_byte, &one, 1);
+  return first_byte == 1 ? "LittleEndian" : "BigEndian";
+}
+
+/**
+ * Collects the raw binary data arrays of an XML VTK file, which are appended
+ * after the XML structure, and generates the corresponding DataArray tags.
+ *
+ * Every array is preceded by a header of 64 bit integers: the number of
+ * bytes for uncompressed data or, for compressed data, the block structure
+ * expected by vtkZLibDataCompressor.
+ */
+class VtkAppendedData {
+ public:
+  /**
+   * Create empty appended data.
+   *
+   * \param compress Whether the arrays are compressed with zlib.
+   */
+  explicit VtkAppendedData(bool compress) : compress_(compress) {}
+
+  /**
+   * Append a data array.
+   *
+   * \param name Name of the array, might be empty.
+   * \param values Contiguous values, components of a node are consecutive.
+   * \param components Number of components per node.
+   * \return DataArray tag referring to the appended data.
+   */
+  template <typename T>
+  std::string add(const std::string &name, const std::vector<T> &values,
+                  int components = 1) {
+    std::ostringstream tag;
+    tag << "<DataArray type=\"" << vtk_type_name<T>() << "\"";
+    if (!name.empty()) {
+      tag << " Name=\"" << name << "\"";
+    }
+    if (components > 1) {
+      tag << " NumberOfComponents=\"" << components << "\"";
+    }
+    tag << " format=\"appended\" offset=\"" << data_.size() << "\"/>";
+    append_block(reinterpret_cast<const char *>(values.data()),
+                 values.size() * sizeof(T));
+    return tag.str();
+  }
+
+  /// \return Attributes of the VTKFile tag describing the binary data.
+  std::string file_attributes() const {
+    std::string attributes = std::string("version=\"1.0\" byte_order=\"") +
+                             vtk_byte_order() + "\" header_type=\"UInt64\"";
+    if (compress_) {
+      attributes += " compressor=\"vtkZLibDataCompressor\"";
+    }
+    return attributes;
+  }
+
+  /**
+   * Write the AppendedData section.
+   *
+   * \param out Output stream, which has to be opened in binary mode.
+   */
+  void write(std::ostream &out) const {
+    out << "  <AppendedData encoding=\"raw\">\n   _";
+    out.write(data_.data(), data_.size());
+    out << "\n  </AppendedData>\n";
+  }
+
+ private:
+  /// Append a 64 bit integer to the data in the machine byte order.
+  void append_uint64(uint64_t x) {
+    const char *bytes = reinterpret_cast<const char *>(&x);
+    data_.insert(data_.end(), bytes, bytes + sizeof(x));
+  }
+
+  /**
+   * Append the header and the (compressed) content of one array.
+   *
+   * \param bytes Start of the array
+   * \param size Size of the array in bytes
+   */
+  void append_block(const char *bytes, uint64_t size) {
+    if (!compress_) {
+      append_uint64(size);
+      data_.insert(data_.end(), bytes, bytes + size);
+      return;
+    }
+#ifdef SMASH_USE_ZLIB
+    const uint64_t block_size = 1 << 15;
+    const uint64_t n_blocks = (size + block_size - 1) / block_size;
+    append_uint64(n_blocks);
+    append_uint64(block_size);
+    append_uint64(size % block_size);
+    // the compressed sizes of the blocks are filled in below
+    const size_t sizes_position = data_.size();
+    data_.resize(data_.size() + n_blocks * sizeof(uint64_t));
+    std::vector<Bytef> buffer(compressBound(block_size));
+    for (uint64_t block = 0; block < n_blocks; ++block) {
+      const uint64_t offset = block * block_size;
+      const uLong in_size = std::min(block_size, size - offset);
+      uLongf out_size = buffer.size();
+      if (compress2(buffer.data(), &out_size,
+                    reinterpret_cast<const Bytef *>(bytes + offset), in_size,
+                    Z_DEFAULT_COMPRESSION) != Z_OK) {
+        throw std::runtime_error("Compression of VTK data array failed.");
+      }
+      const uint64_t compressed_size = out_size;
+      std::memcpy(&data_[sizes_position + block * sizeof(uint64_t)],
+                  &compressed_size, sizeof(uint64_t));
+      data_.insert(data_.end(), buffer.begin(), buffer.begin() + out_size);
+    }
+#endif
+  }
+
+  /// Whether the arrays are compressed
+  const bool compress_;
+  /// Headers and content of all arrays
+  std::vector<char> data_;
+};
+}  // unnamed namespace
+
 VtkOutput::VtkOutput(const bf::path &path, const std::string &name,
-                     const OutputParameters &out_par)
+                     const OutputParameters &out_par, VtkFormat format)
     : OutputInterface(name),
       base_path_(std::move(path)),
-      is_thermodynamics_output_(name == "Thermodynamics") {
+      is_thermodynamics_output_(name == "Thermodynamics"),
+      format_(format),
+      compress_(format == VtkFormat::XmlBinary && out_par.vtk_compression) {
   if (out_par.part_extended) {
     logg[LOutput].warn()
         << "Creating VTK output: There is no extended VTK format.";
   }
+#ifndef SMASH_USE_ZLIB
+  if (compress_) {
+    logg[LOutput].warn("Compressed VTK output requested, but zlib support "
+                       "not compiled in. Writing uncompressed data.");
+    compress_ = false;
+  }
+#endif
 }
 
 VtkOutput::~VtkOutput() {}
@@ -53,6 +219,16 @@ VtkOutput::~VtkOutput() {}
  * black box and opened with paraview, but at the same time they are
  * human-readable text files.
  *
+ * With the format \key "VTK_XML" the same quantities are written as XML VTK
+ * unstructured grid, pos_ev<event>_tstep<output_number>.vtu, where all data
+ * arrays are appended in raw binary form after the XML structure. These files
+ * are much smaller and faster to write and to load than the text files. If
+ * the general output option \key VTK_Compression is enabled, the data arrays
+ * are compressed with zlib. Additionally, a collection file
+ * pos_ev<event>.pvd is written at the end of every event, which lists all
+ * snapshots of the event together with their times. Opening it in paraview
+ * loads the whole time evolution at once.
+ *
  * There is also a possibility to print a lattice with thermodynamical
  * quantities to vtk files, see \ref output_vtk_lattice_.
  **/
@@ -65,8 +241,10 @@ void VtkOutput::at_eventstart(const Particles &particles,
   vtk_tmn_landau_output_counter_ = 0;
   vtk_v_landau_output_counter_ = 0;
   vtk_fluidization_counter_ = 0;
+  collections_.clear();
 
   current_event_ = event_number;
+  current_time_ = particles.is_empty() ? 0. : particles.time();
   if (!is_thermodynamics_output_) {
     write(particles);
     vtk_output_counter_++;
@@ -74,24 +252,64 @@ void VtkOutput::at_eventstart(const Particles &particles,
 }
 
 void VtkOutput::at_eventend(const Particles & /*particles*/,
-                            const int /*event_number*/, const EventInfo &) {}
+                            const int /*event_number*/, const EventInfo &) {
+  for (const auto &collection : collections_) {
+    std::ofstream file((base_path_ / (collection.first + ".pvd")).native());
+    file << "<?xml version=\"1.0\"?>\n"
+         << "<VTKFile type=\"Collection\" version=\"1.0\">\n"
+         << "  <Collection>\n";
+    file << std::setprecision(12);
+    for (const auto &entry : collection.second) {
+      file << "    <DataSet timestep=\"" << entry.first
+           << "\" group=\"\" part=\"0\" file=\"" << entry.second << "\"/>\n";
+    }
+    file << "  </Collection>\n"
+         << "</VTKFile>\n";
+  }
+  collections_.clear();
+}
 
 void VtkOutput::at_intermediate_time(const Particles &particles,
-                                     const std::unique_ptr<Clock> &,
+                                     const std::unique_ptr<Clock> &clock,
                                      const DensityParameters &,
                                      const EventInfo &) {
+  if (clock) {
+    current_time_ = clock->current_time();
+  } else if (!particles.is_empty()) {
+    current_time_ = particles.time();
+  }
   if (!is_thermodynamics_output_) {
     write(particles);
     vtk_output_counter_++;
   }
 }
 
+void VtkOutput::add_to_collection(const std::string &collection,
+                                  const std::string &filename) {
+  if (format_ == VtkFormat::XmlBinary) {
+    collections_[collection].emplace_back(current_time_, filename);
+  }
+}
+
 void VtkOutput::write(const Particles &particles) {
   char filename[32];
-  snprintf(filename, sizeof(filename), "pos_ev%05i_tstep%05i.vtk",
-           current_event_, vtk_output_counter_);
-  FilePtr file_{std::fopen((base_path_ / filename).native().c_str(), "w")};
+  if (format_ == VtkFormat::Legacy) {
+    snprintf(filename, sizeof(filename), "pos_ev%05i_tstep%05i.vtk",
+             current_event_, vtk_output_counter_);
+    write_legacy(particles, filename);
+  } else {
+    snprintf(filename, sizeof(filename), "pos_ev%05i_tstep%05i.vtu",
+             current_event_, vtk_output_counter_);
+    write_xml(particles, filename);
+    char collection[16];
+    snprintf(collection, sizeof(collection), "pos_ev%05i", current_event_);
+    add_to_collection(collection, filename);
+  }
+}
 
+void VtkOutput::write_legacy(const Particles &particles,
+                             const std::string &filename) {
+  FilePtr file_{std::fopen((base_path_ / filename).native().c_str(), "w")};
   /* Legacy VTK file format */
   std::fprintf(file_.get(), "# vtk DataFile Version 2.0\n");
   std::fprintf(file_.get(), "Generated from molecular-offset data %s\n",
@@ -164,6 +382,90 @@ void VtkOutput::write(const Particles &particles) {
   }
 }
 
+void VtkOutput::write_xml(const Particles &particles,
+                          const std::string &filename) {
+  const size_t n = particles.size();
+  std::vector<double> positions, momenta, scaling_factors, masses;
+  std::vector<int32_t> pdg_codes, is_formed, n_coll, ids, baryon_numbers,
+      strangeness;
+  positions.reserve(3 * n);
+  momenta.reserve(3 * n);
+  scaling_factors.reserve(n);
+  masses.reserve(n);
+  pdg_codes.reserve(n);
+  is_formed.reserve(n);
+  n_coll.reserve(n);
+  ids.reserve(n);
+  baryon_numbers.reserve(n);
+  strangeness.reserve(n);
+  const double current_time = particles.is_empty() ? 0. : particles.time();
+  for (const auto &p : particles) {
+    const ThreeVector r = p.position().threevec();
+    const ThreeVector mom = p.momentum().threevec();
+    positions.insert(positions.end(), {r.x1(), r.x2(), r.x3()});
+    momenta.insert(momenta.end(), {mom.x1(), mom.x2(), mom.x3()});
+    scaling_factors.push_back(p.xsec_scaling_factor());
+    masses.push_back(p.effective_mass());
+    pdg_codes.push_back(p.pdgcode().get_decimal());
+    is_formed.push_back(p.formation_time() > current_time ? 0 : 1);
+    n_coll.push_back(p.get_history().collisions_per_particle);
+    ids.push_back(p.id());
+    baryon_numbers.push_back(p.pdgcode().baryon_number());
+    strangeness.push_back(p.pdgcode().strangeness());
+  }
+  // every particle is a cell of type VTK_VERTEX
+  std::vector<int64_t> connectivity(n), offsets(n);
+  for (size_t i = 0; i < n; ++i) {
+    connectivity[i] = i;
+    offsets[i] = i + 1;
+  }
+  const std::vector<uint8_t> cell_types(n, 1);
+
+  /* The tags are generated one after the other, because they contain the
+   * offsets of the arrays in the appended data. */
+  VtkAppendedData data(compress_);
+  const std::string points_tag = data.add("", positions, 3);
+  const std::vector<std::string> cell_tags = {
+      data.add("connectivity", connectivity), data.add("offsets", offsets),
+      data.add("types", cell_types)};
+  std::vector<std::string> point_data_tags;
+  point_data_tags.push_back(data.add("pdg_codes", pdg_codes));
+  point_data_tags.push_back(data.add("is_formed", is_formed));
+  point_data_tags.push_back(
+      data.add("cross_section_scaling_factor", scaling_factors));
+  point_data_tags.push_back(data.add("mass", masses));
+  point_data_tags.push_back(data.add("N_coll", n_coll));
+  point_data_tags.push_back(data.add("particle_ID", ids));
+  point_data_tags.push_back(data.add("baryon_number", baryon_numbers));
+  point_data_tags.push_back(data.add("strangeness", strangeness));
+  point_data_tags.push_back(data.add("momentum", momenta, 3));
+
+  std::ofstream file((base_path_ / filename).native(), std::ios::binary);
+  file << "<?xml version=\"1.0\"?>\n"
+       << "<VTKFile type=\"UnstructuredGrid\" " << data.file_attributes()
+       << ">\n"
+       << "  <UnstructuredGrid>\n"
+       << "    <Piece NumberOfPoints=\"" << n << "\" NumberOfCells=\"" << n
+       << "\">\n"
+       << "      <Points>\n"
+       << "        " << points_tag << "\n"
+       << "      </Points>\n"
+       << "      <Cells>\n";
+  for (const std::string &tag : cell_tags) {
+    file << "        " << tag << "\n";
+  }
+  file << "      </Cells>\n"
+       << "      <PointData>\n";
+  for (const std::string &tag : point_data_tags) {
+    file << "        " << tag << "\n";
+  }
+  file << "      </PointData>\n"
+       << "    </Piece>\n"
+       << "  </UnstructuredGrid>\n";
+  data.write(file);
+  file << "</VTKFile>\n";
+}
+
 /*!\Userguide
  * \page output_vtk_lattice_ Thermodynamics VTK Output
  * Density on the lattice can be printed out in the VTK format of
@@ -171,62 +473,118 @@ void VtkOutput::write(const Particles &particles) {
  * The name format is
  * \<density_name\>_\<event_number\>_tstep\<number_of_output_moment\>.vtk,
  * Files can be opened directly with ParaView (http://paraview.org).
+ *
+ * With the format \key "VTK_XML" the lattices are written as XML VTK image
+ * data with binary (and optionally compressed) data arrays instead, which
+ * have the extension .vti. For every quantity a collection file
+ * \<density_name\>_\<event_number\>.pvd is written at the end of the event.
  */
 
+template <typename T, typename F>
+VtkOutput::LatticeField VtkOutput::lattice_scalar(
+    RectangularLattice<T> &lattice, const std::string &varname,
+    F &&get_quantity) {
+  LatticeField field{varname, 1, {}};
+  field.values.reserve(lattice.size());
+  lattice.iterate_sublattice(
+      {0, 0, 0}, lattice.dimensions(), [&](T &node, int, int, int) {
+        field.values.push_back(get_quantity(node));
+      });
+  return field;
+}
+
+template <typename T, typename F>
+VtkOutput::LatticeField VtkOutput::lattice_vector(
+    RectangularLattice<T> &lattice, const std::string &varname,
+    F &&get_quantity) {
+  LatticeField field{varname, 3, {}};
+  field.values.reserve(3 * lattice.size());
+  lattice.iterate_sublattice(
+      {0, 0, 0}, lattice.dimensions(), [&](T &node, int, int, int) {
+        const ThreeVector v = get_quantity(node);
+        field.values.insert(field.values.end(), {v.x1(), v.x2(), v.x3()});
+      });
+  return field;
+}
+
 template <typename T>
-void VtkOutput::write_vtk_header(std::ofstream &file,
-                                 RectangularLattice<T> &lattice,
-                                 const std::string &description) {
+void VtkOutput::write_lattice(const std::string &description, int counter,
+                              RectangularLattice<T> &lattice,
+                              const std::vector<LatticeField> &fields) {
+  const std::string filename = make_filename(description, counter);
   const auto dim = lattice.dimensions();
   const auto cs = lattice.cell_sizes();
   const auto orig = lattice.origin();
-  file << "# vtk DataFile Version 2.0\n"
-       << description << "\n"
-       << "ASCII\n"
-       << "DATASET STRUCTURED_POINTS\n"
-       << "DIMENSIONS " << dim[0] << " " << dim[1] << " " << dim[2] << "\n"
-       << "SPACING " << cs[0] << " " << cs[1] << " " << cs[2] << "\n"
-       << "ORIGIN " << orig[0] << " " << orig[1] << " " << orig[2] << "\n"
-       << "POINT_DATA " << lattice.size() << "\n";
-}
 
-template <typename T, typename F>
-void VtkOutput::write_vtk_scalar(std::ofstream &file,
-                                 RectangularLattice<T> &lattice,
-                                 const std::string &varname, F &&get_quantity) {
-  file << "SCALARS " << varname << " double 1\n"
-       << "LOOKUP_TABLE default\n";
-  file << std::setprecision(3);
-  file << std::fixed;
-  const auto dim = lattice.dimensions();
-  lattice.iterate_sublattice({0, 0, 0}, dim, [&](T &node, int ix, int, int) {
-    const double f_from_node = get_quantity(node);
-    file << f_from_node << " ";
-    if (ix == dim[0] - 1) {
-      file << "\n";
+  if (format_ == VtkFormat::Legacy) {
+    std::ofstream file((base_path_ / filename).native(), std::ios::out);
+    file << "# vtk DataFile Version 2.0\n"
+         << description << "\n"
+         << "ASCII\n"
+         << "DATASET STRUCTURED_POINTS\n"
+         << "DIMENSIONS " << dim[0] << " " << dim[1] << " " << dim[2] << "\n"
+         << "SPACING " << cs[0] << " " << cs[1] << " " << cs[2] << "\n"
+         << "ORIGIN " << orig[0] << " " << orig[1] << " " << orig[2] << "\n"
+         << "POINT_DATA " << lattice.size() << "\n";
+    for (const LatticeField &field : fields) {
+      if (field.components == 1) {
+        file << "SCALARS " << field.name << " double 1\n"
+             << "LOOKUP_TABLE default\n";
+      } else {
+        file << "VECTORS " << field.name << " double\n";
+      }
+      file << std::setprecision(3);
+      file << std::fixed;
+      for (size_t i = 0; i < field.values.size(); ++i) {
+        file << field.values[i];
+        if (field.components == 1) {
+          file << " ";
+          if ((i + 1) % dim[0] == 0) {
+            file << "\n";
+          }
+        } else {
+          file << ((i + 1) % 3 == 0 ? "\n" : " ");
+        }
+      }
     }
-  });
-}
+    return;
+  }
 
-template <typename T, typename F>
-void VtkOutput::write_vtk_vector(std::ofstream &file,
-                                 RectangularLattice<T> &lattice,
-                                 const std::string &varname, F &&get_quantity) {
-  file << "VECTORS " << varname << " double\n";
-  file << std::setprecision(3);
-  file << std::fixed;
-  const auto dim = lattice.dimensions();
-  lattice.iterate_sublattice({0, 0, 0}, dim, [&](T &node, int, int, int) {
-    const ThreeVector v = get_quantity(node);
-    file << v.x1() << " " << v.x2() << " " << v.x3() << "\n";
-  });
+  VtkAppendedData data(compress_);
+  std::vector<std::string> tags;
+  for (const LatticeField &field : fields) {
+    tags.push_back(data.add(field.name, field.values, field.components));
+  }
+  std::ostringstream extent;
+  extent << "0 " << dim[0] - 1 << " 0 " << dim[1] - 1 << " 0 " << dim[2] - 1;
+  std::ofstream file((base_path_ / filename).native(), std::ios::binary);
+  file << "<?xml version=\"1.0\"?>\n"
+       << "<VTKFile type=\"ImageData\" " << data.file_attributes() << ">\n"
+       << "  <ImageData WholeExtent=\"" << extent.str() << "\" Origin=\""
+       << orig[0] << " " << orig[1] << " " << orig[2] << "\" Spacing=\""
+       << cs[0] << " " << cs[1] << " " << cs[2] << "\">\n"
+       << "    <Piece Extent=\"" << extent.str() << "\">\n"
+       << "      <PointData>\n";
+  for (const std::string &tag : tags) {
+    file << "        " << tag << "\n";
+  }
+  file << "      </PointData>\n"
+       << "    </Piece>\n"
+       << "  </ImageData>\n";
+  data.write(file);
+  file << "</VTKFile>\n";
+
+  char collection_suffix[16];
+  snprintf(collection_suffix, sizeof(collection_suffix), "_%05i",
+           current_event_);
+  add_to_collection(description + collection_suffix, filename);
 }
 
 std::string VtkOutput::make_filename(const std::string &descr, int counter) {
   char suffix[22];
-  snprintf(suffix, sizeof(suffix), "_%05i_tstep%05i.vtk", current_event_,
-           counter);
-  return base_path_.string() + std::string("/") + descr + std::string(suffix);
+  snprintf(suffix, sizeof(suffix), "_%05i_tstep%05i.%s", current_event_,
+           counter, format_ == VtkFormat::Legacy ? "vtk" : "vti");
+  return descr + std::string(suffix);
 }
 
 std::string VtkOutput::make_varname(const ThermodynamicQuantity tq,
@@ -241,12 +599,11 @@ void VtkOutput::thermodynamics_output(
   if (!is_thermodynamics_output_) {
     return;
   }
-  std::ofstream file;
   const std::string varname = make_varname(tq, dens_type);
-  file.open(make_filename(varname, vtk_density_output_counter_), std::ios::out);
-  write_vtk_header(file, lattice, varname);
-  write_vtk_scalar(file, lattice, varname,
-                   [&](DensityOnLattice &node) { return node.density(); });
+  write_lattice(varname, vtk_density_output_counter_, lattice,
+                {lattice_scalar(lattice, varname, [&](DensityOnLattice &node) {
+                  return node.density();
+                })});
   vtk_density_output_counter_++;
 }
 
@@ -272,45 +629,43 @@ void VtkOutput::thermodynamics_output(
   if (!is_thermodynamics_output_) {
     return;
   }
-  std::ofstream file;
   const std::string varname = make_varname(tq, dens_type);
+  std::vector<LatticeField> fields;
 
   if (tq == ThermodynamicQuantity::Tmn) {
-    file.open(make_filename(varname, vtk_tmn_output_counter_++), std::ios::out);
-    write_vtk_header(file, Tmn_lattice, varname);
     for (int i = 0; i < 4; i++) {
       for (int j = i; j < 4; j++) {
-        write_vtk_scalar(file, Tmn_lattice,
-                         varname + std::to_string(i) + std::to_string(j),
-                         [&](EnergyMomentumTensor &node) {
-                           return node[EnergyMomentumTensor::tmn_index(i, j)];
-                         });
+        fields.push_back(lattice_scalar(
+            Tmn_lattice, varname + std::to_string(i) + std::to_string(j),
+            [&](EnergyMomentumTensor &node) {
+              return node[EnergyMomentumTensor::tmn_index(i, j)];
+            }));
       }
     }
+    write_lattice(varname, vtk_tmn_output_counter_++, Tmn_lattice, fields);
   } else if (tq == ThermodynamicQuantity::TmnLandau) {
-    file.open(make_filename(varname, vtk_tmn_landau_output_counter_++),
-              std::ios::out);
-    write_vtk_header(file, Tmn_lattice, varname);
     for (int i = 0; i < 4; i++) {
       for (int j = i; j < 4; j++) {
-        write_vtk_scalar(file, Tmn_lattice,
-                         varname + std::to_string(i) + std::to_string(j),
-                         [&](EnergyMomentumTensor &node) {
-                           const FourVector u = node.landau_frame_4velocity();
-                           const EnergyMomentumTensor Tmn_L = node.boosted(u);
-                           return Tmn_L[EnergyMomentumTensor::tmn_index(i, j)];
-                         });
+        fields.push_back(lattice_scalar(
+            Tmn_lattice, varname + std::to_string(i) + std::to_string(j),
+            [&](EnergyMomentumTensor &node) {
+              const FourVector u = node.landau_frame_4velocity();
+              const EnergyMomentumTensor Tmn_L = node.boosted(u);
+              return Tmn_L[EnergyMomentumTensor::tmn_index(i, j)];
+            }));
       }
     }
+    write_lattice(varname, vtk_tmn_landau_output_counter_++, Tmn_lattice,
+                  fields);
   } else {
-    file.open(make_filename(varname, vtk_v_landau_output_counter_++),
-              std::ios::out);
-    write_vtk_header(file, Tmn_lattice, varname);
-    write_vtk_vector(file, Tmn_lattice, varname,
-                     [&](EnergyMomentumTensor &node) {
-                       const FourVector u = node.landau_frame_4velocity();
-                       return -u.velocity();
-                     });
+    fields.push_back(lattice_vector(Tmn_lattice, varname,
+                                    [&](EnergyMomentumTensor &node) {
+                                      const FourVector u =
+                                          node.landau_frame_4velocity();
+                                      return -u.velocity();
+                                    }));
+    write_lattice(varname, vtk_v_landau_output_counter_++, Tmn_lattice,
+                  fields);
   }
 }
 
@@ -318,22 +673,22 @@ void VtkOutput::thermodynamics_output(const GrandCanThermalizer &gct) {
   if (!is_thermodynamics_output_) {
     return;
   }
-  std::ofstream file;
-  file.open(make_filename("fluidization_td", vtk_fluidization_counter_++),
-            std::ios::out);
-  write_vtk_header(file, gct.lattice(), "fluidization_td");
-  write_vtk_scalar(file, gct.lattice(), "e",
-                   [&](ThermLatticeNode &node) { return node.e(); });
-  write_vtk_scalar(file, gct.lattice(), "p",
-                   [&](ThermLatticeNode &node) { return node.p(); });
-  write_vtk_vector(file, gct.lattice(), "v",
-                   [&](ThermLatticeNode &node) { return node.v(); });
-  write_vtk_scalar(file, gct.lattice(), "T",
-                   [&](ThermLatticeNode &node) { return node.T(); });
-  write_vtk_scalar(file, gct.lattice(), "mub",
-                   [&](ThermLatticeNode &node) { return node.mub(); });
-  write_vtk_scalar(file, gct.lattice(), "mus",
-                   [&](ThermLatticeNode &node) { return node.mus(); });
+  auto &lattice = gct.lattice();
+  std::vector<LatticeField> fields;
+  fields.push_back(lattice_scalar(
+      lattice, "e", [&](ThermLatticeNode &node) { return node.e(); }));
+  fields.push_back(lattice_scalar(
+      lattice, "p", [&](ThermLatticeNode &node) { return node.p(); }));
+  fields.push_back(lattice_vector(
+      lattice, "v", [&](ThermLatticeNode &node) { return node.v(); }));
+  fields.push_back(lattice_scalar(
+      lattice, "T", [&](ThermLatticeNode &node) { return node.T(); }));
+  fields.push_back(lattice_scalar(
+      lattice, "mub", [&](ThermLatticeNode &node) { return node.mub(); }));
+  fields.push_back(lattice_scalar(
+      lattice, "mus", [&](ThermLatticeNode &node) { return node.mus(); }));
+  write_lattice("fluidization_td", vtk_fluidization_counter_++, lattice,
+                fields);
 }
 
 }  // namespace smash